@@ -42,6 +42,11 @@ public class MathToolkit : ModuleRules
 			);
 
 
+		// 1 compiles in the MATHTOOLKIT_SCOPE / MATHTOOLKIT_COUNT hooks: Insights CPU events, STATGROUP_MathToolkit
+		// stats and periodic LogMathToolkit summaries. At 0 they compile to nothing.
+		PublicDefinitions.Add("MATHTOOLKIT_ENABLE_INSTRUMENTATION=0");
+
+
 		DynamicallyLoadedModuleNames.AddRange(
 			new string[]
 			{
@@ -0,0 +1,177 @@
+#include "CameraProjection.h"
+#include "MathToolkitStats.h"
+#include "MathToolkitLibrary.h"
+#include "MathToolkitSIMD.h"
+
+using namespace MathToolkitSIMD;
+
+namespace
+{
+    // FVector input is converted to camera-space floats in blocks of this many points
+    constexpr int32 ProjectBlockSize = 1024;
+
+    struct FProjectionLanes
+    {
+        float FocalX, FocalY, CenterX, CenterY, Width, Height, NearPlane;
+        // Row-major world-to-camera rotation and the camera-space translation
+        float R[9] = {};
+        float T[3] = {};
+    };
+
+    template<bool bTransform>
+    int32 ProjectBlock(const FProjectionLanes& P, const float* XPtr, const float* YPtr, const float* ZPtr, int32 Count, float* UPtr, float* VPtr, uint8* VisiblePtr)
+    {
+        int32 NumVisible = 0;
+        ForEachLane(Count, [&](int32 i, auto Tag)
+        {
+            using L = TLanes<decltype(Tag)>;
+            auto PX = L::Load(XPtr + i);
+            auto PY = L::Load(YPtr + i);
+            auto PZ = L::Load(ZPtr + i);
+            if constexpr (bTransform)
+            {
+                const auto WX = PX, WY = PY, WZ = PZ;
+                PX = L::Add(L::Add(L::Mul(WX, L::Set1(P.R[0])), L::Mul(WY, L::Set1(P.R[1]))), L::Add(L::Mul(WZ, L::Set1(P.R[2])), L::Set1(P.T[0])));
+                PY = L::Add(L::Add(L::Mul(WX, L::Set1(P.R[3])), L::Mul(WY, L::Set1(P.R[4]))), L::Add(L::Mul(WZ, L::Set1(P.R[5])), L::Set1(P.T[1])));
+                PZ = L::Add(L::Add(L::Mul(WX, L::Set1(P.R[6])), L::Mul(WY, L::Set1(P.R[7]))), L::Add(L::Mul(WZ, L::Set1(P.R[8])), L::Set1(P.T[2])));
+            }
+
+            // Clamping the depth keeps points behind the camera finite; the mask discards them
+            const auto Near = L::Set1(P.NearPlane);
+            const auto InvDepth = L::Div(L::Set1(1.0f), L::Max(PX, Near));
+            const auto U = L::Add(L::Set1(P.CenterX), L::Mul(L::Mul(PY, InvDepth), L::Set1(P.FocalX)));
+            const auto V = L::Sub(L::Set1(P.CenterY), L::Mul(L::Mul(PZ, InvDepth), L::Set1(P.FocalY)));
+
+            // Pixel k covers [k - 0.5, k + 0.5). Every compare is false for NaN, so NaN points come out invisible
+            const auto Lower = L::Set1(-0.5f);
+            auto Mask = L::CmpLt(Near, PX);
+            Mask = L::And(Mask, L::AndNot(L::CmpLt(U, Lower), L::CmpLt(U, L::Set1(P.Width - 0.5f))));
+            Mask = L::And(Mask, L::AndNot(L::CmpLt(V, Lower), L::CmpLt(V, L::Set1(P.Height - 0.5f))));
+
+            const auto Invalid = L::Set1(-1.0f);
+            L::Store(UPtr + i, L::Select(Mask, U, Invalid));
+            L::Store(VPtr + i, L::Select(Mask, V, Invalid));
+
+            const int32 Bits = L::MoveMask(Mask);
+            for (int32 Lane = 0; Lane < L::Width; ++Lane)
+            {
+                const int32 Bit = (Bits >> Lane) & 1;
+                VisiblePtr[i + Lane] = static_cast<uint8>(Bit);
+                NumVisible += Bit;
+            }
+        });
+        return NumVisible;
+    }
+}
+
+FCameraProjection::FCameraProjection(float FOVH, uint32 width, uint32 height, float InNearPlane)
+    : Width(static_cast<float>(width))
+    , Height(static_cast<float>(height))
+    , NearPlane(InNearPlane)
+    , bHasPose(false)
+    , Origin(FVector::ZeroVector)
+{
+    float TanHalfFOVH, TanHalfFOVV;
+    MathToolkitLibrary::CalculateTanHalfFOV(FOVH, width, height, TanHalfFOVH, TanHalfFOVV);
+
+    // Inverse of NDC_X = 2 * u / width - 1 with Y / X = NDC_X * tan(FOVH / 2), and likewise for V
+    CenterX = 0.5f * Width;
+    CenterY = 0.5f * Height;
+    FocalX = CenterX / TanHalfFOVH;
+    FocalY = CenterY / TanHalfFOVV;
+
+    Axes[0] = FVector(1.0, 0.0, 0.0);
+    Axes[1] = FVector(0.0, 1.0, 0.0);
+    Axes[2] = FVector(0.0, 0.0, 1.0);
+}
+
+FCameraProjection::FCameraProjection(const FTransform& CameraToWorld, float FOVH, uint32 width, uint32 height, float InNearPlane)
+    : FCameraProjection(FOVH, width, height, InNearPlane)
+{
+    SetCameraToWorld(CameraToWorld);
+}
+
+void FCameraProjection::SetCameraToWorld(const FTransform& CameraToWorld)
+{
+    const FQuat Rotation = CameraToWorld.GetRotation();
+    Axes[0] = Rotation.RotateVector(FVector(1.0, 0.0, 0.0));
+    Axes[1] = Rotation.RotateVector(FVector(0.0, 1.0, 0.0));
+    Axes[2] = Rotation.RotateVector(FVector(0.0, 0.0, 1.0));
+    Origin = CameraToWorld.GetLocation();
+    bHasPose = true;
+}
+
+void FCameraProjection::ClearCameraToWorld()
+{
+    Axes[0] = FVector(1.0, 0.0, 0.0);
+    Axes[1] = FVector(0.0, 1.0, 0.0);
+    Axes[2] = FVector(0.0, 0.0, 1.0);
+    Origin = FVector::ZeroVector;
+    bHasPose = false;
+}
+
+int32 FCameraProjection::Project(
+    TConstArrayView<float> X,
+    TConstArrayView<float> Y,
+    TConstArrayView<float> Z,
+    TArrayView<float> U,
+    TArrayView<float> V,
+    TArrayView<uint8> Visible) const
+{
+    MATHTOOLKIT_SCOPE(Projection);
+    const int32 Count = X.Num();
+    MATHTOOLKIT_COUNT(PointsProjected, Count);
+    check(Y.Num() == Count && Z.Num() == Count);
+    check(U.Num() == Count && V.Num() == Count && Visible.Num() == Count);
+
+    FProjectionLanes P = { FocalX, FocalY, CenterX, CenterY, Width, Height, NearPlane, {}, {} };
+    if (!bHasPose)
+    {
+        return ProjectBlock<false>(P, X.GetData(), Y.GetData(), Z.GetData(), Count, U.GetData(), V.GetData(), Visible.GetData());
+    }
+
+    for (int32 Row = 0; Row < 3; ++Row)
+    {
+        P.R[Row * 3 + 0] = static_cast<float>(Axes[Row].X);
+        P.R[Row * 3 + 1] = static_cast<float>(Axes[Row].Y);
+        P.R[Row * 3 + 2] = static_cast<float>(Axes[Row].Z);
+        P.T[Row] = static_cast<float>(-FVector::DotProduct(Axes[Row], Origin));
+    }
+    return ProjectBlock<true>(P, X.GetData(), Y.GetData(), Z.GetData(), Count, U.GetData(), V.GetData(), Visible.GetData());
+}
+
+int32 FCameraProjection::Project(TConstArrayView<FVector> Points, TArrayView<float> U, TArrayView<float> V, TArrayView<uint8> Visible) const
+{
+    MATHTOOLKIT_SCOPE(Projection);
+    const int32 Count = Points.Num();
+    MATHTOOLKIT_COUNT(PointsProjected, Count);
+    check(U.Num() == Count && V.Num() == Count && Visible.Num() == Count);
+
+    const FProjectionLanes P = { FocalX, FocalY, CenterX, CenterY, Width, Height, NearPlane, {}, {} };
+    float CameraX[ProjectBlockSize];
+    float CameraY[ProjectBlockSize];
+    float CameraZ[ProjectBlockSize];
+
+    int32 NumVisible = 0;
+    for (int32 Start = 0; Start < Count; Start += ProjectBlockSize)
+    {
+        const int32 BlockCount = FMath::Min(ProjectBlockSize, Count - Start);
+        for (int32 i = 0; i < BlockCount; ++i)
+        {
+            const FVector Relative = Points[Start + i] - Origin;
+            CameraX[i] = static_cast<float>(FVector::DotProduct(Axes[0], Relative));
+            CameraY[i] = static_cast<float>(FVector::DotProduct(Axes[1], Relative));
+            CameraZ[i] = static_cast<float>(FVector::DotProduct(Axes[2], Relative));
+        }
+        NumVisible += ProjectBlock<false>(P, CameraX, CameraY, CameraZ, BlockCount,
+            U.GetData() + Start, V.GetData() + Start, Visible.GetData() + Start);
+    }
+    return NumVisible;
+}
+
+bool FCameraProjection::ProjectPoint(const FVector& Point, float& U, float& V) const
+{
+    uint8 Visible;
+    Project(MakeArrayView(&Point, 1), MakeArrayView(&U, 1), MakeArrayView(&V, 1), MakeArrayView(&Visible, 1));
+    return Visible != 0;
+}
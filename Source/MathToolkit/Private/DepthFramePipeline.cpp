@@ -0,0 +1,183 @@
+#include "DepthFramePipeline.h"
+#include "MathToolkitStats.h"
+#include "Async/ParallelFor.h"
+#include "HAL/PlatformTime.h"
+
+namespace
+{
+    // Depth bytes per tile: with the seven channels of a tile this stays within a typical L2
+    constexpr uint32 TileDepthBytes = 32 * 1024;
+}
+
+FDepthFramePipeline::FDepthFramePipeline(const FSettings& InSettings)
+    : Settings(InSettings)
+{
+    check(Settings.Width > 0 && Settings.Height > 0 && Settings.NumFrames > 0);
+    RowsPerTile = Settings.RowsPerTile > 0 ? Settings.RowsPerTile : GetDefaultRowsPerTile(Settings.Width);
+    LUT = FDepthRayLUTCache::Get().FindOrBuild(Settings.FOVH, Settings.Width, Settings.Height);
+
+    const int32 NumPixels = static_cast<int32>(Settings.Width * Settings.Height);
+    Slots.resize(Settings.NumFrames);
+    for (FSlot& Slot : Slots)
+    {
+        FDepthFrame& Frame = Slot.Frame;
+        Frame.Depth.SetNumUninitialized(NumPixels);
+        Frame.X.SetNumUninitialized(NumPixels);
+        Frame.Y.SetNumUninitialized(NumPixels);
+        Frame.Z.SetNumUninitialized(NumPixels);
+        if (Settings.bSpherical)
+        {
+            Frame.Range.SetNumUninitialized(NumPixels);
+            Frame.Azimuth.SetNumUninitialized(NumPixels);
+            Frame.Elevation.SetNumUninitialized(NumPixels);
+        }
+    }
+
+    if (Settings.bAsync)
+    {
+        Worker = std::thread([this]() { WorkerLoop(); });
+    }
+}
+
+FDepthFramePipeline::~FDepthFramePipeline()
+{
+    {
+        std::lock_guard<std::mutex> Lock(Mutex);
+        bStopping = true;
+    }
+    WorkAvailable.notify_all();
+    if (Worker.joinable())
+    {
+        Worker.join();
+    }
+}
+
+int32 FDepthFramePipeline::GetDefaultRowsPerTile(uint32 width)
+{
+    return static_cast<int32>(FMath::Max<uint32>(1, TileDepthBytes / (width * sizeof(float))));
+}
+
+int32 FDepthFramePipeline::ConvertTiled(const FDepthRayLUT& LUT, TConstArrayView<float> Depth, const FDepthPointCloudSoA& Out, int32 RowsPerTile, bool bParallel)
+{
+    MATHTOOLKIT_SCOPE(DepthConversion);
+    check(RowsPerTile > 0);
+    const uint32 Height = LUT.GetHeight();
+    MATHTOOLKIT_COUNT(PointsConverted, LUT.GetWidth() * Height);
+    const int32 NumTiles = static_cast<int32>((Height + RowsPerTile - 1) / RowsPerTile);
+    ParallelFor(NumTiles, [&](int32 Tile)
+    {
+        const uint32 FirstRow = static_cast<uint32>(Tile * RowsPerTile);
+        LUT.ConvertRows(Depth, Out, FirstRow, FMath::Min<uint32>(RowsPerTile, Height - FirstRow));
+    }, !bParallel);
+    return NumTiles;
+}
+
+bool FDepthFramePipeline::Submit(TConstArrayView<float> Depth)
+{
+    check(Depth.Num() == static_cast<int32>(Settings.Width * Settings.Height));
+
+    FSlot* Slot;
+    {
+        std::lock_guard<std::mutex> Lock(Mutex);
+        Slot = &Slots[NextSubmit];
+        if (Slot->State != ESlotState::Free)
+        {
+            return false;
+        }
+        Slot->State = ESlotState::Capturing;
+        Slot->Frame.FrameNumber = FrameCounter++;
+        NextSubmit = (NextSubmit + 1) % static_cast<int32>(Slots.size());
+    }
+
+    // The slot belongs to this thread while Capturing, so the copy runs outside the lock
+    const double CaptureStart = FPlatformTime::Seconds();
+    FMemory::Memcpy(Slot->Frame.Depth.GetData(), Depth.GetData(), Depth.Num() * sizeof(float));
+    const double CaptureEnd = FPlatformTime::Seconds();
+    Slot->Frame.Timings = FDepthFrameTimings();
+    Slot->Frame.Timings.CaptureSeconds = CaptureEnd - CaptureStart;
+    Slot->SubmitTime = CaptureEnd;
+
+    if (!Settings.bAsync)
+    {
+        Convert(*Slot);
+        std::lock_guard<std::mutex> Lock(Mutex);
+        Slot->State = ESlotState::Ready;
+        NextConvert = (NextConvert + 1) % static_cast<int32>(Slots.size());
+        return true;
+    }
+
+    {
+        std::lock_guard<std::mutex> Lock(Mutex);
+        Slot->State = ESlotState::Queued;
+    }
+    WorkAvailable.notify_one();
+    return true;
+}
+
+void FDepthFramePipeline::Convert(FSlot& Slot)
+{
+    FDepthFrame& Frame = Slot.Frame;
+    const double Start = FPlatformTime::Seconds();
+    Frame.Timings.QueueSeconds = Start - Slot.SubmitTime;
+    Frame.Timings.NumTiles = ConvertTiled(*LUT, Frame.Depth, Frame.GetPointCloud(), RowsPerTile, Settings.bParallel);
+    Frame.Timings.ConvertSeconds = FPlatformTime::Seconds() - Start;
+}
+
+void FDepthFramePipeline::WorkerLoop()
+{
+    std::unique_lock<std::mutex> Lock(Mutex);
+    for (;;)
+    {
+        WorkAvailable.wait(Lock, [this]() { return bStopping || Slots[NextConvert].State == ESlotState::Queued; });
+        if (bStopping)
+        {
+            return;
+        }
+
+        FSlot& Slot = Slots[NextConvert];
+        Slot.State = ESlotState::Converting;
+        NextConvert = (NextConvert + 1) % static_cast<int32>(Slots.size());
+
+        Lock.unlock();
+        Convert(Slot);
+        Lock.lock();
+
+        Slot.State = ESlotState::Ready;
+        FrameReady.notify_all();
+    }
+}
+
+FDepthFrame* FDepthFramePipeline::WaitForFrame()
+{
+    std::unique_lock<std::mutex> Lock(Mutex);
+    FSlot& Slot = Slots[NextConsume];
+    if (Slot.State == ESlotState::Free)
+    {
+        return nullptr;
+    }
+    check(Slot.State != ESlotState::Consuming);
+
+    FrameReady.wait(Lock, [&Slot]() { return Slot.State == ESlotState::Ready; });
+    Slot.State = ESlotState::Consuming;
+    return &Slot.Frame;
+}
+
+void FDepthFramePipeline::ReleaseFrame()
+{
+    std::lock_guard<std::mutex> Lock(Mutex);
+    FSlot& Slot = Slots[NextConsume];
+    check(Slot.State == ESlotState::Consuming);
+    Slot.State = ESlotState::Free;
+    NextConsume = (NextConsume + 1) % static_cast<int32>(Slots.size());
+}
+
+int32 FDepthFramePipeline::NumInFlight() const
+{
+    std::lock_guard<std::mutex> Lock(Mutex);
+    int32 Count = 0;
+    for (const FSlot& Slot : Slots)
+    {
+        Count += Slot.State != ESlotState::Free ? 1 : 0;
+    }
+    return Count;
+}
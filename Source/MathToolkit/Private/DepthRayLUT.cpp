@@ -0,0 +1,331 @@
+#include "DepthRayLUT.h"
+#include "MathToolkitStats.h"
+#include "MathToolkitSIMD.h"
+#include "Misc/ScopeLock.h"
+
+#include <type_traits>
+
+using namespace MathToolkitSIMD;
+
+namespace
+{
+    /** Pixels per tile of the interleaved encoders; the narrowed planes of a tile stay on the stack. */
+    constexpr int32 EncodeTileSize = 256;
+
+    /**
+     * Depth rows to interleaved narrow X, Y, Z: each tile is converted and narrowed with full-width
+     * lanes into planar scratch, then interleaved, so the wide float cloud never exists.
+     */
+    template<typename T>
+    void EncodeXYZ(const float* RESTRICT Depth, const float* RESTRICT ColumnSlope, const float* RESTRICT RowSlope,
+        uint32 Width, uint32 Height, float InvScale, T* RESTRICT Out)
+    {
+        T PlaneX[EncodeTileSize];
+        T PlaneY[EncodeTileSize];
+        T PlaneZ[EncodeTileSize];
+        for (uint32 y = 0; y < Height; ++y)
+        {
+            const float* RESTRICT Row = Depth + y * Width;
+            const float ZScale = RowSlope[y] * InvScale;
+            for (int32 Begin = 0; Begin < static_cast<int32>(Width); Begin += EncodeTileSize)
+            {
+                const int32 Count = FMath::Min(EncodeTileSize, static_cast<int32>(Width) - Begin);
+                ForEachLane(Count, [&](int32 i, auto Tag)
+                {
+                    using L = TLanes<decltype(Tag)>;
+                    const auto D = L::Load(Row + Begin + i);
+                    const auto X = L::Mul(D, L::Set1(InvScale));
+                    const auto Y = L::Mul(X, L::Load(ColumnSlope + Begin + i));
+                    const auto Z = L::Mul(D, L::Set1(ZScale));
+                    if constexpr (std::is_same_v<T, uint16>)
+                    {
+                        L::StoreHalf(PlaneX + i, X);
+                        L::StoreHalf(PlaneY + i, Y);
+                        L::StoreHalf(PlaneZ + i, Z);
+                    }
+                    else
+                    {
+                        L::StoreInt16(PlaneX + i, X);
+                        L::StoreInt16(PlaneY + i, Y);
+                        L::StoreInt16(PlaneZ + i, Z);
+                    }
+                });
+
+                T* RESTRICT Dst = Out + 3 * (static_cast<SIZE_T>(y) * Width + Begin);
+                for (int32 i = 0; i < Count; ++i)
+                {
+                    Dst[3 * i + 0] = PlaneX[i];
+                    Dst[3 * i + 1] = PlaneY[i];
+                    Dst[3 * i + 2] = PlaneZ[i];
+                }
+            }
+        }
+    }
+}
+
+FDepthRayLUT::FDepthRayLUT(float InFOVH, uint32 width, uint32 height)
+    : FOVH(InFOVH)
+    , Width(width)
+    , Height(height)
+{
+    MathToolkitLibrary::CalculateTanHalfFOV(FOVH, Width, Height, TanHalfFOVH, TanHalfFOVV);
+
+    ColumnSlope.SetNumUninitialized(Width);
+    ColumnAzimuth.SetNumUninitialized(Width);
+    for (uint32 x = 0; x < Width; ++x)
+    {
+        float NDC_X = (2.0f * x / Width) - 1.0f;
+        ColumnSlope[x] = NDC_X * TanHalfFOVH;
+        ColumnAzimuth[x] = FMath::Atan(ColumnSlope[x]);
+    }
+
+    RowSlope.SetNumUninitialized(Height);
+    for (uint32 y = 0; y < Height; ++y)
+    {
+        float NDC_Y = 1.0f - (2.0f * y / Height);
+        RowSlope[y] = NDC_Y * TanHalfFOVV;
+    }
+
+    const int32 NumPixels = static_cast<int32>(Width * Height);
+    RangeScale.SetNumUninitialized(NumPixels);
+    Elevation.SetNumUninitialized(NumPixels);
+    for (uint32 y = 0; y < Height; ++y)
+    {
+        for (uint32 x = 0; x < Width; ++x)
+        {
+            const float HorizontalSq = 1.0f + FMath::Square(ColumnSlope[x]);
+            RangeScale[y * Width + x] = FMath::Sqrt(HorizontalSq + FMath::Square(RowSlope[y]));
+            Elevation[y * Width + x] = FMath::Atan2(RowSlope[y], FMath::Sqrt(HorizontalSq));
+        }
+    }
+}
+
+void FDepthRayLUT::Convert(TConstArrayView<float> Depth, const FDepthPointCloudSoA& Out) const
+{
+    MATHTOOLKIT_SCOPE(DepthConversion);
+    MATHTOOLKIT_COUNT(PointsConverted, Width * Height);
+    ConvertRows(Depth, Out, 0, Height);
+}
+
+void FDepthRayLUT::ConvertRows(TConstArrayView<float> Depth, const FDepthPointCloudSoA& Out, uint32 FirstRow, uint32 NumRows) const
+{
+    check(FirstRow + NumRows <= Height);
+    const int32 NumPixels = static_cast<int32>(Width * Height);
+    check(Depth.Num() >= NumPixels);
+
+    const uint32 EndRow = FirstRow + NumRows;
+    const int32 Begin = static_cast<int32>(FirstRow * Width);
+    const int32 End = static_cast<int32>(EndRow * Width);
+    const float* RESTRICT D = Depth.GetData();
+    if (!Out.X.IsEmpty())
+    {
+        check(Out.X.Num() >= NumPixels);
+        FMemory::Memcpy(Out.X.GetData() + Begin, D + Begin, (End - Begin) * sizeof(float));
+    }
+    if (!Out.Y.IsEmpty())
+    {
+        check(Out.Y.Num() >= NumPixels);
+        const float* RESTRICT Slope = ColumnSlope.GetData();
+        for (uint32 y = FirstRow; y < EndRow; ++y)
+        {
+            const float* RESTRICT Row = D + y * Width;
+            float* RESTRICT OutY = Out.Y.GetData() + y * Width;
+            for (uint32 x = 0; x < Width; ++x)
+            {
+                OutY[x] = Row[x] * Slope[x];
+            }
+        }
+    }
+    if (!Out.Z.IsEmpty())
+    {
+        check(Out.Z.Num() >= NumPixels);
+        for (uint32 y = FirstRow; y < EndRow; ++y)
+        {
+            const float* RESTRICT Row = D + y * Width;
+            float* RESTRICT OutZ = Out.Z.GetData() + y * Width;
+            const float Slope = RowSlope[y];
+            for (uint32 x = 0; x < Width; ++x)
+            {
+                OutZ[x] = Row[x] * Slope;
+            }
+        }
+    }
+    if (!Out.Range.IsEmpty())
+    {
+        check(Out.Range.Num() >= NumPixels);
+        const float* RESTRICT Scale = RangeScale.GetData();
+        float* RESTRICT OutRange = Out.Range.GetData();
+        for (int32 i = Begin; i < End; ++i)
+        {
+            OutRange[i] = D[i] * Scale[i];
+        }
+    }
+    if (!Out.Azimuth.IsEmpty())
+    {
+        check(Out.Azimuth.Num() >= NumPixels);
+        for (uint32 y = FirstRow; y < EndRow; ++y)
+        {
+            FMemory::Memcpy(Out.Azimuth.GetData() + y * Width, ColumnAzimuth.GetData(), Width * sizeof(float));
+        }
+    }
+    if (!Out.Elevation.IsEmpty())
+    {
+        check(Out.Elevation.Num() >= NumPixels);
+        FMemory::Memcpy(Out.Elevation.GetData() + Begin, Elevation.GetData() + Begin, (End - Begin) * sizeof(float));
+    }
+}
+
+void FDepthRayLUT::ConvertHalf(TConstArrayView<float> Depth, TArrayView<uint16> OutXYZ, float Scale) const
+{
+    MATHTOOLKIT_SCOPE(DepthConversion);
+    MATHTOOLKIT_COUNT(PointsConverted, Width * Height);
+    const int32 NumPixels = static_cast<int32>(Width * Height);
+    check(Depth.Num() >= NumPixels && OutXYZ.Num() >= 3 * NumPixels);
+    check(Scale > 0.0f);
+    EncodeXYZ<uint16>(Depth.GetData(), ColumnSlope.GetData(), RowSlope.GetData(), Width, Height, 1.0f / Scale, OutXYZ.GetData());
+}
+
+void FDepthRayLUT::ConvertFixed16(TConstArrayView<float> Depth, TArrayView<int16> OutXYZ, float Scale) const
+{
+    MATHTOOLKIT_SCOPE(DepthConversion);
+    MATHTOOLKIT_COUNT(PointsConverted, Width * Height);
+    const int32 NumPixels = static_cast<int32>(Width * Height);
+    check(Depth.Num() >= NumPixels && OutXYZ.Num() >= 3 * NumPixels);
+    check(Scale > 0.0f);
+    EncodeXYZ<int16>(Depth.GetData(), ColumnSlope.GetData(), RowSlope.GetData(), Width, Height, 1.0f / Scale, OutXYZ.GetData());
+}
+
+void FDepthRayLUT::ConvertRangeImage(TConstArrayView<float> Depth, TArrayView<uint16> OutRange, float Scale) const
+{
+    MATHTOOLKIT_SCOPE(DepthConversion);
+    MATHTOOLKIT_COUNT(PointsConverted, Width * Height);
+    const int32 NumPixels = static_cast<int32>(Width * Height);
+    check(Depth.Num() >= NumPixels && OutRange.Num() >= NumPixels);
+    check(Scale > 0.0f);
+
+    const float InvScale = 1.0f / Scale;
+    const float* RESTRICT D = Depth.GetData();
+    const float* RESTRICT RangeScales = RangeScale.GetData();
+    uint16* RESTRICT Out = OutRange.GetData();
+    // Negative and NaN depths store as 0 in the saturating store, so missing returns need no branch
+    ForEachLane(NumPixels, [&](int32 i, auto Tag)
+    {
+        using L = TLanes<decltype(Tag)>;
+        L::StoreUInt16(Out + i, L::Mul(L::Mul(L::Load(D + i), L::Load(RangeScales + i)), L::Set1(InvScale)));
+    });
+}
+
+SIZE_T FDepthRayLUT::GetAllocatedSize() const
+{
+    return ColumnSlope.GetAllocatedSize() + RowSlope.GetAllocatedSize() + ColumnAzimuth.GetAllocatedSize()
+        + RangeScale.GetAllocatedSize() + Elevation.GetAllocatedSize();
+}
+
+FDepthRayLUTCache& FDepthRayLUTCache::Get()
+{
+    static FDepthRayLUTCache Cache;
+    return Cache;
+}
+
+TSharedPtr<const FDepthRayLUT> FDepthRayLUTCache::FindOrBuild(float FOVH, uint32 width, uint32 height)
+{
+    FScopeLock Lock(&CriticalSection);
+    for (FEntry& Entry : Entries)
+    {
+        if (Entry.LUT->Matches(FOVH, width, height))
+        {
+            Entry.LastUsed = ++UseCounter;
+            return Entry.LUT;
+        }
+    }
+
+    // Built under the lock so sensors racing on the same intrinsics share one table
+    Entries.push_back(FEntry{MakeShared<const FDepthRayLUT>(FOVH, width, height), ++UseCounter});
+    TSharedPtr<const FDepthRayLUT> Result = Entries.back().LUT;
+    EvictToBudget();
+    return Result;
+}
+
+bool FDepthRayLUTCache::Contains(float FOVH, uint32 width, uint32 height) const
+{
+    FScopeLock Lock(&CriticalSection);
+    for (const FEntry& Entry : Entries)
+    {
+        if (Entry.LUT->Matches(FOVH, width, height))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+SIZE_T FDepthRayLUTCache::GetAllocatedSize() const
+{
+    FScopeLock Lock(&CriticalSection);
+    SIZE_T Total = 0;
+    for (const FEntry& Entry : Entries)
+    {
+        Total += Entry.LUT->GetAllocatedSize();
+    }
+    return Total;
+}
+
+int32 FDepthRayLUTCache::Num() const
+{
+    FScopeLock Lock(&CriticalSection);
+    return static_cast<int32>(Entries.size());
+}
+
+void FDepthRayLUTCache::SetMaxAllocatedSize(SIZE_T Bytes)
+{
+    FScopeLock Lock(&CriticalSection);
+    MaxAllocatedSize = Bytes;
+    EvictToBudget();
+}
+
+SIZE_T FDepthRayLUTCache::GetMaxAllocatedSize() const
+{
+    FScopeLock Lock(&CriticalSection);
+    return MaxAllocatedSize;
+}
+
+void FDepthRayLUTCache::Trim()
+{
+    FScopeLock Lock(&CriticalSection);
+    Entries.erase(
+        std::remove_if(Entries.begin(), Entries.end(), [](const FEntry& Entry) { return Entry.LUT.IsUnique(); }),
+        Entries.end());
+}
+
+void FDepthRayLUTCache::EvictToBudget()
+{
+    if (MaxAllocatedSize == 0)
+    {
+        return;
+    }
+
+    SIZE_T Total = 0;
+    for (const FEntry& Entry : Entries)
+    {
+        Total += Entry.LUT->GetAllocatedSize();
+    }
+
+    while (Total > MaxAllocatedSize)
+    {
+        // Least recently used table that only the cache still holds
+        auto Victim = Entries.end();
+        for (auto It = Entries.begin(); It != Entries.end(); ++It)
+        {
+            if (It->LUT.IsUnique() && (Victim == Entries.end() || It->LastUsed < Victim->LastUsed))
+            {
+                Victim = It;
+            }
+        }
+        if (Victim == Entries.end())
+        {
+            break;
+        }
+        Total -= Victim->LUT->GetAllocatedSize();
+        Entries.erase(Victim);
+    }
+}
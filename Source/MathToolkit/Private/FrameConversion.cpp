@@ -0,0 +1,64 @@
+#include "FrameConversion.h"
+
+namespace
+{
+    // Half a float ulp relative to magnitude: round-to-nearest error bound
+    constexpr double FloatRelativeError = 1.0 / 16777216.0;
+}
+
+void FRebasedFrame::ToLocal(TConstArrayView<FVector> World, TArrayView<FVector3f> Local) const
+{
+    check(Local.Num() == World.Num());
+    const FVector* RESTRICT Src = World.GetData();
+    FVector3f* RESTRICT Dst = Local.GetData();
+    for (int32 i = 0; i < World.Num(); ++i)
+    {
+        Dst[i] = FVector3f(Src[i] - Origin);
+    }
+}
+
+void FRebasedFrame::ToWorld(TConstArrayView<FVector3f> Local, TArrayView<FVector> World) const
+{
+    check(World.Num() == Local.Num());
+    const FVector3f* RESTRICT Src = Local.GetData();
+    FVector* RESTRICT Dst = World.GetData();
+    for (int32 i = 0; i < Local.Num(); ++i)
+    {
+        Dst[i] = Origin + FVector(Src[i]);
+    }
+}
+
+void FRebasedFrame::ToROSLocal(TConstArrayView<FVector> World, TArrayView<float> OutXYZ, int32 PointStride) const
+{
+    check(PointStride >= 3);
+    check(OutXYZ.Num() == World.Num() * PointStride);
+    const FVector* RESTRICT Src = World.GetData();
+    float* RESTRICT Dst = OutXYZ.GetData();
+    for (int32 i = 0; i < World.Num(); ++i)
+    {
+        Dst[i * PointStride + 0] = static_cast<float>((Src[i].X - Origin.X) * 0.01);
+        Dst[i * PointStride + 1] = static_cast<float>((Src[i].Y - Origin.Y) * -0.01);
+        Dst[i * PointStride + 2] = static_cast<float>((Src[i].Z - Origin.Z) * 0.01);
+    }
+}
+
+double FRebasedFrame::GetLocalError(const FVector& World) const
+{
+    const FVector Local = World - Origin;
+    return FMath::Max3(FMath::Abs(Local.X), FMath::Abs(Local.Y), FMath::Abs(Local.Z)) * FloatRelativeError;
+}
+
+double FRebasedFrame::GetSafeRadius(double Tolerance)
+{
+    return Tolerance / FloatRelativeError;
+}
+
+bool FRebasedFrame::RebaseIfNeeded(const FVector& World, double Tolerance)
+{
+    if (GetLocalError(World) <= Tolerance)
+    {
+        return false;
+    }
+    Origin = World;
+    return true;
+}
@@ -0,0 +1,176 @@
+#include "LidarDeskew.h"
+#include "MathToolkitStats.h"
+#include "MathToolkitSIMD.h"
+
+using namespace MathToolkitSIMD;
+
+namespace
+{
+    struct FDeskewColumns
+    {
+        const float* R[9];
+        const float* T[3];
+    };
+
+    /** Row of NumColumns points: (X, Y, Z) = R[column] * (X, Y, Z) + T[column], optionally from Range * Dir. */
+    template<bool bFromRange>
+    void DeskewRow(const FDeskewColumns& C, int32 NumColumns, const float* Range, const float* DX, const float* DY, const float* DZ, float* X, float* Y, float* Z)
+    {
+        ForEachLane(NumColumns, [&](int32 i, auto Tag)
+        {
+            using L = TLanes<decltype(Tag)>;
+            decltype(Tag) PX, PY, PZ, Valid;
+            if constexpr (bFromRange)
+            {
+                const auto R = L::Load(Range + i);
+                PX = L::Mul(R, L::Load(DX + i));
+                PY = L::Mul(R, L::Load(DY + i));
+                PZ = L::Mul(R, L::Load(DZ + i));
+                Valid = L::CmpLt(L::Set1(0.0f), R);
+            }
+            else
+            {
+                PX = L::Load(X + i);
+                PY = L::Load(Y + i);
+                PZ = L::Load(Z + i);
+            }
+
+            const auto OX = L::Add(L::Add(L::Mul(L::Load(C.R[0] + i), PX), L::Mul(L::Load(C.R[1] + i), PY)), L::Add(L::Mul(L::Load(C.R[2] + i), PZ), L::Load(C.T[0] + i)));
+            const auto OY = L::Add(L::Add(L::Mul(L::Load(C.R[3] + i), PX), L::Mul(L::Load(C.R[4] + i), PY)), L::Add(L::Mul(L::Load(C.R[5] + i), PZ), L::Load(C.T[1] + i)));
+            const auto OZ = L::Add(L::Add(L::Mul(L::Load(C.R[6] + i), PX), L::Mul(L::Load(C.R[7] + i), PY)), L::Add(L::Mul(L::Load(C.R[8] + i), PZ), L::Load(C.T[2] + i)));
+            if constexpr (bFromRange)
+            {
+                // Masking instead of branching keeps missing returns at the origin
+                L::Store(X + i, L::And(Valid, OX));
+                L::Store(Y + i, L::And(Valid, OY));
+                L::Store(Z + i, L::And(Valid, OZ));
+            }
+            else
+            {
+                L::Store(X + i, OX);
+                L::Store(Y + i, OY);
+                L::Store(Z + i, OZ);
+            }
+        });
+    }
+}
+
+FLidarDeskew::FLidarDeskew(const FLidarSpec& Spec, float ScanPeriod)
+    : NumChannels(Spec.GetNumChannels())
+    , NumColumns(Spec.GetNumColumns())
+    , bHasMotion(false)
+{
+    check(NumChannels > 0 && ScanPeriod >= 0.0f);
+
+    ColumnTimes.SetNumUninitialized(NumColumns);
+    for (int32 Column = 0; Column < NumColumns; ++Column)
+    {
+        ColumnTimes[Column] = -ScanPeriod * (NumColumns - 1 - Column) / NumColumns;
+    }
+
+    const int32 NumBeams = Spec.GetNumBeams();
+    TArray<float> Azimuth, Elevation;
+    Azimuth.SetNumUninitialized(NumBeams);
+    Elevation.SetNumUninitialized(NumBeams);
+    Spec.CalculateBeamAngles(Azimuth, Elevation);
+    DirX.SetNumUninitialized(NumBeams);
+    DirY.SetNumUninitialized(NumBeams);
+    DirZ.SetNumUninitialized(NumBeams);
+    for (int32 Beam = 0; Beam < NumBeams; ++Beam)
+    {
+        const double CosElevation = FMath::Cos(static_cast<double>(Elevation[Beam]));
+        DirX[Beam] = static_cast<float>(CosElevation * FMath::Cos(static_cast<double>(Azimuth[Beam])));
+        DirY[Beam] = static_cast<float>(CosElevation * FMath::Sin(static_cast<double>(Azimuth[Beam])));
+        DirZ[Beam] = static_cast<float>(FMath::Sin(static_cast<double>(Elevation[Beam])));
+    }
+
+    for (TArray<float>& Channel : Rotation)
+    {
+        Channel.SetNumZeroed(NumColumns);
+    }
+    for (TArray<float>& Channel : Translation)
+    {
+        Channel.SetNumZeroed(NumColumns);
+    }
+    SetMotion(FVector::ZeroVector);
+}
+
+void FLidarDeskew::SetColumnTimes(TConstArrayView<float> Times)
+{
+    check(Times.Num() == NumColumns);
+    FMemory::Memcpy(ColumnTimes.GetData(), Times.GetData(), NumColumns * sizeof(float));
+    SetMotion(LinearVelocity, AngularVelocity);
+}
+
+void FLidarDeskew::SetMotion(const FVector& InLinearVelocity, const FVector& InAngularVelocity)
+{
+    LinearVelocity = InLinearVelocity;
+    AngularVelocity = InAngularVelocity;
+    bHasMotion = !LinearVelocity.IsNearlyZero(0.0) || !AngularVelocity.IsNearlyZero(0.0);
+    const double Rate = AngularVelocity.Size();
+    const FVector Axis = Rate > 0.0 ? AngularVelocity / Rate : FVector(0.0, 0.0, 1.0);
+    for (int32 Column = 0; Column < NumColumns; ++Column)
+    {
+        const double Time = ColumnTimes[Column];
+        const FQuat Delta(Axis, Rate * Time);
+        // Columns of the rotation matrix are the rotated basis vectors
+        const FVector Basis[3] = {
+            Delta.RotateVector(FVector(1.0, 0.0, 0.0)),
+            Delta.RotateVector(FVector(0.0, 1.0, 0.0)),
+            Delta.RotateVector(FVector(0.0, 0.0, 1.0)) };
+        for (int32 Row = 0; Row < 3; ++Row)
+        {
+            for (int32 Col = 0; Col < 3; ++Col)
+            {
+                Rotation[Row * 3 + Col][Column] = static_cast<float>(Basis[Col][Row]);
+            }
+            Translation[Row][Column] = static_cast<float>(LinearVelocity[Row] * Time);
+        }
+    }
+}
+
+void FLidarDeskew::SetMotionFromFit(const FVector& vector_fit_a, const FQuat& SensorRotation, const FVector& AngularVelocity)
+{
+    SetMotion(SensorRotation.UnrotateVector(vector_fit_a), AngularVelocity);
+}
+
+void FLidarDeskew::Apply(TArrayView<float> X, TArrayView<float> Y, TArrayView<float> Z) const
+{
+    MATHTOOLKIT_SCOPE(Deskew);
+    const int32 NumBeams = NumChannels * NumColumns;
+    check(X.Num() == NumBeams && Y.Num() == NumBeams && Z.Num() == NumBeams);
+    if (!bHasMotion)
+    {
+        return;
+    }
+
+    const FDeskewColumns C = {
+        { Rotation[0].GetData(), Rotation[1].GetData(), Rotation[2].GetData(), Rotation[3].GetData(), Rotation[4].GetData(),
+          Rotation[5].GetData(), Rotation[6].GetData(), Rotation[7].GetData(), Rotation[8].GetData() },
+        { Translation[0].GetData(), Translation[1].GetData(), Translation[2].GetData() } };
+    for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+    {
+        const int32 Row = Channel * NumColumns;
+        DeskewRow<false>(C, NumColumns, nullptr, nullptr, nullptr, nullptr, X.GetData() + Row, Y.GetData() + Row, Z.GetData() + Row);
+    }
+}
+
+void FLidarDeskew::ConvertRanges(TConstArrayView<float> Range, TArrayView<float> X, TArrayView<float> Y, TArrayView<float> Z) const
+{
+    MATHTOOLKIT_SCOPE(Deskew);
+    const int32 NumBeams = NumChannels * NumColumns;
+    check(Range.Num() == NumBeams);
+    check(X.Num() == NumBeams && Y.Num() == NumBeams && Z.Num() == NumBeams);
+    MATHTOOLKIT_COUNT(PointsConverted, NumBeams);
+
+    const FDeskewColumns C = {
+        { Rotation[0].GetData(), Rotation[1].GetData(), Rotation[2].GetData(), Rotation[3].GetData(), Rotation[4].GetData(),
+          Rotation[5].GetData(), Rotation[6].GetData(), Rotation[7].GetData(), Rotation[8].GetData() },
+        { Translation[0].GetData(), Translation[1].GetData(), Translation[2].GetData() } };
+    for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+    {
+        const int32 Row = Channel * NumColumns;
+        DeskewRow<true>(C, NumColumns, Range.GetData() + Row, DirX.GetData() + Row, DirY.GetData() + Row, DirZ.GetData() + Row,
+            X.GetData() + Row, Y.GetData() + Row, Z.GetData() + Row);
+    }
+}
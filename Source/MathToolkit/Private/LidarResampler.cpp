@@ -0,0 +1,121 @@
+#include "LidarResampler.h"
+#include "MathToolkitStats.h"
+#include "MathToolkitLibrary.h"
+
+FLidarSpec FLidarSpec::MakeUniform(int32 NumChannels, float MinElevation, float MaxElevation, float HorizontalResolution)
+{
+    check(NumChannels > 0 && HorizontalResolution > 0.0f);
+    FLidarSpec Spec;
+    Spec.HorizontalResolution = HorizontalResolution;
+    Spec.ElevationAngles.SetNumUninitialized(NumChannels);
+    const float Step = NumChannels > 1 ? (MaxElevation - MinElevation) / (NumChannels - 1) : 0.0f;
+    for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+    {
+        Spec.ElevationAngles[Channel] = MaxElevation - Step * Channel;
+    }
+    return Spec;
+}
+
+void FLidarSpec::CalculateBeamAngles(TArrayView<float> Azimuth, TArrayView<float> Elevation) const
+{
+    const int32 NumColumns = GetNumColumns();
+    check(Azimuth.Num() == GetNumBeams() && Elevation.Num() == GetNumBeams());
+    for (int32 Channel = 0; Channel < GetNumChannels(); ++Channel)
+    {
+        const float ElevationRad = FMath::DegreesToRadians(ElevationAngles[Channel]);
+        for (int32 Column = 0; Column < NumColumns; ++Column)
+        {
+            const int32 Beam = Channel * NumColumns + Column;
+            Azimuth[Beam] = FMath::DegreesToRadians(AzimuthStart + Column * HorizontalResolution);
+            Elevation[Beam] = ElevationRad;
+        }
+    }
+}
+
+FLidarResampler::FLidarResampler(const FLidarSpec& Spec, float FOVH, uint32 width, uint32 height, float CameraYaw)
+    : NumChannels(Spec.GetNumChannels())
+    , NumColumns(Spec.GetNumColumns())
+    , Width(width)
+    , Height(height)
+    , MaxRelativeDepthSpread(0.05f)
+{
+    check(Width >= 2 && Height >= 2);
+
+    float tanHalfFOVHRad, tanHalfFOVVRad;
+    MathToolkitLibrary::CalculateTanHalfFOV(FOVH, Width, Height, tanHalfFOVHRad, tanHalfFOVVRad);
+
+    // Same pixel convention as FCameraProjection: pixel k is centred on k and covers [k - 0.5, k + 0.5)
+    const double CenterX = 0.5 * Width;
+    const double CenterY = 0.5 * Height;
+    const double FocalX = CenterX / tanHalfFOVHRad;
+    const double FocalY = CenterY / tanHalfFOVVRad;
+
+    for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+    {
+        const double TanElevation = FMath::Tan(FMath::DegreesToRadians(static_cast<double>(Spec.ElevationAngles[Channel])));
+        for (int32 Column = 0; Column < NumColumns; ++Column)
+        {
+            const double Azimuth = FMath::UnwindDegrees(static_cast<double>(Spec.AzimuthStart) + Column * static_cast<double>(Spec.HorizontalResolution) - CameraYaw);
+            if (FMath::Abs(Azimuth) >= 90.0)
+            {
+                continue;
+            }
+
+            // Beam direction scaled to unit depth: (1, tan az, tan el / cos az)
+            const double AzimuthRad = FMath::DegreesToRadians(Azimuth);
+            const double SlopeY = FMath::Tan(AzimuthRad);
+            const double SlopeZ = TanElevation / FMath::Cos(AzimuthRad);
+            const double U = CenterX + FocalX * SlopeY;
+            const double V = CenterY - FocalY * SlopeZ;
+            if (U < -0.5 || U >= Width - 0.5 || V < -0.5 || V >= Height - 0.5)
+            {
+                continue;
+            }
+
+            const double SampleU = FMath::Clamp(U, 0.0, Width - 1.0);
+            const double SampleV = FMath::Clamp(V, 0.0, Height - 1.0);
+            const int32 X0 = FMath::Min(static_cast<int32>(SampleU), static_cast<int32>(Width) - 2);
+            const int32 Y0 = FMath::Min(static_cast<int32>(SampleV), static_cast<int32>(Height) - 2);
+            const float TX = static_cast<float>(SampleU - X0);
+            const float TY = static_cast<float>(SampleV - Y0);
+
+            FBeamSample& Sample = Samples.AddDefaulted_GetRef();
+            Sample.Beam = Channel * NumColumns + Column;
+            Sample.Pixel = Y0 * static_cast<int32>(Width) + X0;
+            Sample.Nearest = FMath::RoundToInt(SampleV) * static_cast<int32>(Width) + FMath::RoundToInt(SampleU);
+            Sample.Weights[0] = (1.0f - TX) * (1.0f - TY);
+            Sample.Weights[1] = TX * (1.0f - TY);
+            Sample.Weights[2] = (1.0f - TX) * TY;
+            Sample.Weights[3] = TX * TY;
+            Sample.RangeScale = static_cast<float>(FMath::Sqrt(1.0 + SlopeY * SlopeY + SlopeZ * SlopeZ));
+        }
+    }
+}
+
+void FLidarResampler::Resample(TConstArrayView<float> Depth, TArrayView<float> OutRange) const
+{
+    MATHTOOLKIT_SCOPE(LidarResample);
+    MATHTOOLKIT_COUNT(PointsConverted, Samples.Num());
+    check(Depth.Num() >= static_cast<int32>(Width * Height));
+    check(OutRange.Num() == NumChannels * NumColumns);
+
+    const float* RESTRICT D = Depth.GetData();
+    float* RESTRICT Out = OutRange.GetData();
+    const int32 Stride = static_cast<int32>(Width);
+    const float Spread = MaxRelativeDepthSpread;
+    for (const FBeamSample& Sample : Samples)
+    {
+        const float D00 = D[Sample.Pixel];
+        const float D01 = D[Sample.Pixel + 1];
+        const float D10 = D[Sample.Pixel + Stride];
+        const float D11 = D[Sample.Pixel + Stride + 1];
+
+        const float Bilinear = Sample.Weights[0] * D00 + Sample.Weights[1] * D01 + Sample.Weights[2] * D10 + Sample.Weights[3] * D11;
+        const float Lo = FMath::Min(FMath::Min(D00, D01), FMath::Min(D10, D11));
+        const float Hi = FMath::Max(FMath::Max(D00, D01), FMath::Max(D10, D11));
+
+        // Missing returns (depth <= 0) in the neighbourhood also fall back to the nearest pixel
+        const float SampleDepth = (Lo > 0.0f && Hi - Lo <= Spread * Lo) ? Bilinear : D[Sample.Nearest];
+        Out[Sample.Beam] = SampleDepth > 0.0f ? SampleDepth * Sample.RangeScale : 0.0f;
+    }
+}
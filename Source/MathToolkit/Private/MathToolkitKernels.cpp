@@ -0,0 +1,277 @@
+#include "MathToolkitKernels.h"
+#include "MathToolkitSIMD.h"
+
+using namespace MathToolkitSIMD;
+
+namespace
+{
+    // atan(a) = a + a^3 * P(a^2) on [0, 1], Abramowitz & Stegun 4.4.49 (|error| <= 2e-8 before rounding)
+    constexpr float AtanC1 = -0.3333314528f;
+    constexpr float AtanC2 = 0.1999355085f;
+    constexpr float AtanC3 = -0.1420889944f;
+    constexpr float AtanC4 = 0.1065626393f;
+    constexpr float AtanC5 = -0.0752896400f;
+    constexpr float AtanC6 = 0.0429096138f;
+    constexpr float AtanC7 = -0.0161657367f;
+    constexpr float AtanC8 = 0.0028662257f;
+
+    // Cephes sinf/cosf polynomials on [-PI/4, PI/4], with PI/2 split in three for the reduction
+    constexpr float SinC1 = -1.6666654611e-1f;
+    constexpr float SinC2 = 8.3321608736e-3f;
+    constexpr float SinC3 = -1.9515295891e-4f;
+    constexpr float CosC1 = 4.166664568298827e-2f;
+    constexpr float CosC2 = -1.388731625493765e-3f;
+    constexpr float CosC3 = 2.443315711809948e-5f;
+    constexpr float HalfPiA = 1.5703125f;
+    constexpr float HalfPiB = 4.837512969970703125e-4f;
+    constexpr float HalfPiC = 7.54978995489188216e-8f;
+
+    constexpr float HalfPi = 1.57079632679489661923f;
+    constexpr float Pi = 3.14159265358979323846f;
+    constexpr float TwoOverPi = 0.63661977236758134308f;
+    constexpr float MinNormal = 1.175494351e-38f;
+
+    /** atan on [-1, 1]. */
+    template<typename V>
+    FORCEINLINE V AtanUnit(V A)
+    {
+        using L = TLanes<V>;
+        const V S = L::Mul(A, A);
+        V P = L::Set1(AtanC8);
+        P = L::Add(L::Mul(P, S), L::Set1(AtanC7));
+        P = L::Add(L::Mul(P, S), L::Set1(AtanC6));
+        P = L::Add(L::Mul(P, S), L::Set1(AtanC5));
+        P = L::Add(L::Mul(P, S), L::Set1(AtanC4));
+        P = L::Add(L::Mul(P, S), L::Set1(AtanC3));
+        P = L::Add(L::Mul(P, S), L::Set1(AtanC2));
+        P = L::Add(L::Mul(P, S), L::Set1(AtanC1));
+        return L::Add(A, L::Mul(L::Mul(A, S), P));
+    }
+
+    template<typename V>
+    FORCEINLINE V Atan2Lanes(V Y, V X)
+    {
+        using L = TLanes<V>;
+        const V SignBit = L::Set1(-0.0f);
+        const V AbsX = L::AndNot(SignBit, X);
+        const V AbsY = L::AndNot(SignBit, Y);
+
+        // Fold into the first octant; the origin maps to 0 / MinNormal = 0
+        const V Ratio = L::Div(L::Min(AbsX, AbsY), L::Max(L::Max(AbsX, AbsY), L::Set1(MinNormal)));
+        V Result = AtanUnit(Ratio);
+        Result = L::Select(L::CmpLt(AbsX, AbsY), L::Sub(L::Set1(HalfPi), Result), Result);
+        Result = L::Select(L::CmpLt(X, L::Set1(0.0f)), L::Sub(L::Set1(Pi), Result), Result);
+        return L::Or(Result, L::And(SignBit, Y));
+    }
+
+    template<typename V>
+    FORCEINLINE void SinCosLanes(V Angle, V& OutSin, V& OutCos)
+    {
+        using L = TLanes<V>;
+        V SwapMask, SinSign, CosSign;
+        const V J = L::Quadrant(L::Mul(Angle, L::Set1(TwoOverPi)), SwapMask, SinSign, CosSign);
+
+        V R = L::Sub(Angle, L::Mul(J, L::Set1(HalfPiA)));
+        R = L::Sub(R, L::Mul(J, L::Set1(HalfPiB)));
+        R = L::Sub(R, L::Mul(J, L::Set1(HalfPiC)));
+        const V R2 = L::Mul(R, R);
+
+        V SinPoly = L::Add(L::Mul(L::Set1(SinC3), R2), L::Set1(SinC2));
+        SinPoly = L::Add(L::Mul(SinPoly, R2), L::Set1(SinC1));
+        SinPoly = L::Add(R, L::Mul(L::Mul(SinPoly, R2), R));
+
+        V CosPoly = L::Add(L::Mul(L::Set1(CosC3), R2), L::Set1(CosC2));
+        CosPoly = L::Add(L::Mul(CosPoly, R2), L::Set1(CosC1));
+        CosPoly = L::Add(L::Sub(L::Set1(1.0f), L::Mul(R2, L::Set1(0.5f))), L::Mul(L::Mul(CosPoly, R2), R2));
+
+        OutSin = L::Xor(L::Select(SwapMask, CosPoly, SinPoly), SinSign);
+        OutCos = L::Xor(L::Select(SwapMask, SinPoly, CosPoly), CosSign);
+    }
+}
+
+const TCHAR* MathToolkitKernels::GetSIMDPathName()
+{
+#if MATHTOOLKIT_SIMD_AVX2
+    return TEXT("AVX2");
+#elif MATHTOOLKIT_SIMD_SSE2
+    return TEXT("SSE2");
+#elif MATHTOOLKIT_SIMD_NEON
+    return TEXT("NEON");
+#else
+    return TEXT("Scalar");
+#endif
+}
+
+int32 MathToolkitKernels::GetSIMDWidth()
+{
+    return FWideLanes::Width;
+}
+
+void MathToolkitKernels::Atan(TConstArrayView<float> In, TArrayView<float> Out)
+{
+    check(Out.Num() == In.Num());
+    const float* InPtr = In.GetData();
+    float* OutPtr = Out.GetData();
+    ForEachLane(In.Num(), [&](int32 i, auto Tag)
+    {
+        using L = TLanes<decltype(Tag)>;
+        L::Store(OutPtr + i, Atan2Lanes(L::Load(InPtr + i), L::Set1(1.0f)));
+    });
+}
+
+void MathToolkitKernels::Atan2(TConstArrayView<float> Y, TConstArrayView<float> X, TArrayView<float> Out)
+{
+    check(X.Num() == Y.Num() && Out.Num() == Y.Num());
+    const float* YPtr = Y.GetData();
+    const float* XPtr = X.GetData();
+    float* OutPtr = Out.GetData();
+    ForEachLane(Y.Num(), [&](int32 i, auto Tag)
+    {
+        using L = TLanes<decltype(Tag)>;
+        L::Store(OutPtr + i, Atan2Lanes(L::Load(YPtr + i), L::Load(XPtr + i)));
+    });
+}
+
+void MathToolkitKernels::SinCos(TConstArrayView<float> Angles, TArrayView<float> OutSin, TArrayView<float> OutCos)
+{
+    check(OutSin.Num() == Angles.Num() && OutCos.Num() == Angles.Num());
+    const float* AnglePtr = Angles.GetData();
+    float* SinPtr = OutSin.GetData();
+    float* CosPtr = OutCos.GetData();
+    ForEachLane(Angles.Num(), [&](int32 i, auto Tag)
+    {
+        using V = decltype(Tag);
+        using L = TLanes<V>;
+        V S, C;
+        SinCosLanes(L::Load(AnglePtr + i), S, C);
+        L::Store(SinPtr + i, S);
+        L::Store(CosPtr + i, C);
+    });
+}
+
+void MathToolkitKernels::CartesianToSpherical(
+    TConstArrayView<float> X,
+    TConstArrayView<float> Y,
+    TConstArrayView<float> Z,
+    TArrayView<float> Range,
+    TArrayView<float> Azimuth,
+    TArrayView<float> Elevation)
+{
+    const int32 Count = X.Num();
+    check(Y.Num() == Count && Z.Num() == Count);
+    check(Range.Num() == Count && Azimuth.Num() == Count && Elevation.Num() == Count);
+
+    const float* XPtr = X.GetData();
+    const float* YPtr = Y.GetData();
+    const float* ZPtr = Z.GetData();
+    float* RangePtr = Range.GetData();
+    float* AzimuthPtr = Azimuth.GetData();
+    float* ElevationPtr = Elevation.GetData();
+    ForEachLane(Count, [&](int32 i, auto Tag)
+    {
+        using V = decltype(Tag);
+        using L = TLanes<V>;
+        const V PX = L::Load(XPtr + i);
+        const V PY = L::Load(YPtr + i);
+        const V PZ = L::Load(ZPtr + i);
+        const V HorizontalSq = L::Add(L::Mul(PX, PX), L::Mul(PY, PY));
+        L::Store(RangePtr + i, L::Sqrt(L::Add(HorizontalSq, L::Mul(PZ, PZ))));
+        L::Store(AzimuthPtr + i, Atan2Lanes(PY, PX));
+        L::Store(ElevationPtr + i, Atan2Lanes(PZ, L::Sqrt(HorizontalSq)));
+    });
+}
+
+void MathToolkitKernels::SphericalToCartesian(
+    TConstArrayView<float> Range,
+    TConstArrayView<float> Azimuth,
+    TConstArrayView<float> Elevation,
+    TArrayView<float> X,
+    TArrayView<float> Y,
+    TArrayView<float> Z)
+{
+    const int32 Count = Range.Num();
+    check(Azimuth.Num() == Count && Elevation.Num() == Count);
+    check(X.Num() == Count && Y.Num() == Count && Z.Num() == Count);
+
+    const float* RangePtr = Range.GetData();
+    const float* AzimuthPtr = Azimuth.GetData();
+    const float* ElevationPtr = Elevation.GetData();
+    float* XPtr = X.GetData();
+    float* YPtr = Y.GetData();
+    float* ZPtr = Z.GetData();
+    ForEachLane(Count, [&](int32 i, auto Tag)
+    {
+        using V = decltype(Tag);
+        using L = TLanes<V>;
+        V SinAz, CosAz, SinEl, CosEl;
+        SinCosLanes(L::Load(AzimuthPtr + i), SinAz, CosAz);
+        SinCosLanes(L::Load(ElevationPtr + i), SinEl, CosEl);
+        const V R = L::Load(RangePtr + i);
+        const V Horizontal = L::Mul(R, CosEl);
+        L::Store(XPtr + i, L::Mul(Horizontal, CosAz));
+        L::Store(YPtr + i, L::Mul(Horizontal, SinAz));
+        L::Store(ZPtr + i, L::Mul(R, SinEl));
+    });
+}
+
+void MathToolkitKernels::ScaleInterleavedXYZ(TConstArrayView<float> In, TArrayView<float> Out, const FVector3f& Scale, int32 PointStride)
+{
+    check(PointStride >= 3);
+    check(In.Num() % PointStride == 0 && Out.Num() == In.Num());
+
+    const int32 NumPoints = In.Num() / PointStride;
+    const float* InPtr = In.GetData();
+    float* OutPtr = Out.GetData();
+    int32 Point = 0;
+
+    using L = FWideLanes;
+    if (PointStride == 3 && L::Width > 1)
+    {
+        // Width packed points span exactly three vectors; the scale pattern repeats every three vectors
+        alignas(32) float Pattern[3 * L::Width];
+        for (int32 i = 0; i < 3 * L::Width; ++i)
+        {
+            Pattern[i] = Scale[i % 3];
+        }
+        const FVectorLanes Scale0 = L::Load(Pattern);
+        const FVectorLanes Scale1 = L::Load(Pattern + L::Width);
+        const FVectorLanes Scale2 = L::Load(Pattern + 2 * L::Width);
+        for (; Point + L::Width <= NumPoints; Point += L::Width)
+        {
+            const float* Src = InPtr + Point * 3;
+            float* Dst = OutPtr + Point * 3;
+            L::Store(Dst, L::Mul(L::Load(Src), Scale0));
+            L::Store(Dst + L::Width, L::Mul(L::Load(Src + L::Width), Scale1));
+            L::Store(Dst + 2 * L::Width, L::Mul(L::Load(Src + 2 * L::Width), Scale2));
+        }
+    }
+    else if (PointStride == 4 && L::Width % 4 == 0)
+    {
+        // One vector holds Width / 4 padded points; the padding lane keeps whatever Out already holds
+        alignas(32) float Pattern[L::Width];
+        alignas(32) float Mask[L::Width];
+        for (int32 i = 0; i < L::Width; ++i)
+        {
+            Pattern[i] = i % 4 < 3 ? Scale[i % 4] : 1.0f;
+            Mask[i] = TLanes<float>::FromBits(i % 4 < 3 ? 0xFFFFFFFFu : 0u);
+        }
+        const FVectorLanes ScaleLanes = L::Load(Pattern);
+        const FVectorLanes XYZMask = L::Load(Mask);
+        constexpr int32 PointsPerVector = L::Width / 4;
+        for (; Point + PointsPerVector <= NumPoints; Point += PointsPerVector)
+        {
+            float* Dst = OutPtr + Point * 4;
+            const FVectorLanes Scaled = L::Mul(L::Load(InPtr + Point * 4), ScaleLanes);
+            L::Store(Dst, L::Select(XYZMask, Scaled, L::Load(Dst)));
+        }
+    }
+
+    for (; Point < NumPoints; ++Point)
+    {
+        const float* Src = InPtr + Point * PointStride;
+        float* Dst = OutPtr + Point * PointStride;
+        Dst[0] = Src[0] * Scale.X;
+        Dst[1] = Src[1] * Scale.Y;
+        Dst[2] = Src[2] * Scale.Z;
+    }
+}
@@ -2,34 +2,152 @@
 
 
 #include "MathToolkitLibrary.h"
+#include "MathToolkitKernels.h"
+#include "FrameConversion.h"
 
 FVector MathToolkitLibrary::ConvertROSToUE(const FVector &ROSVector)
 {
-  // Convert ROS coordinates (right-handed) to Unreal Engine coordinates (left-handed) and scale from m to cm
-  // ROS: X forward, Y left, Z up -> UE: X forward, Y right, Z up
-  FVector UEVector;
-  UEVector.X = ROSVector.X * 100.0f;  // Scale from m to cm
-  UEVector.Y = -ROSVector.Y * 100.0f; // Flip Y axis
-  UEVector.Z = ROSVector.Z * 100.0f;  // Scale from m to cm
-
-  return UEVector;
+  // ROS: X forward, Y left, Z up (m) -> UE: X forward, Y right, Z up (cm)
+  return TFrameConversion<double>::ROSToUE(ROSVector);
 }
 
 FRotator MathToolkitLibrary::ConvertROSToUEAngleDegree(const FRotator &rotation)
 {
-  return FRotator(FMath::Fmod(rotation.Pitch + 360.0f, 360.0f),  FMath::Fmod(-rotation.Roll + 360.0f, 360.0f),  FMath::Fmod((-rotation.Yaw)+ 360.0f, 360.0f));
+  // Exact inverse of ConvertUEToROSAngleDegree(FRotator). FRotator takes (Pitch, Yaw, Roll), so roll and yaw
+  // used to end up swapped here and the 180 degree yaw offset was never removed.
+  FRotator UERotation;
+  UERotation.Pitch = rotation.Pitch;          // Keep pitch the same
+  UERotation.Roll = -rotation.Roll;           // Flip roll back
+  UERotation.Yaw = -(rotation.Yaw - 180.0f);  // Remove the 180 degree offset and flip yaw back
+
+  // Normalize angles to [0, 360)
+  UERotation.Pitch = FMath::Fmod(UERotation.Pitch + 360.0f, 360.0f);
+  UERotation.Roll = FMath::Fmod(UERotation.Roll + 360.0f, 360.0f);
+  UERotation.Yaw = FMath::Fmod(UERotation.Yaw + 360.0f, 360.0f);
+
+  return UERotation;
 }
 
 FVector MathToolkitLibrary::ConvertUEToROS(const FVector &UEVector)
 {
-  // Convert Unreal Engine coordinates (left-handed) to ROS coordinates (right-handed) and scale from cm to m
-  // UE: X forward, Y right, Z up -> ROS: X forward, Y left, Z up
-  FVector ROSVector;
-  ROSVector.X = UEVector.X / 100.0f;  // Scale from cm to m
-  ROSVector.Y = -UEVector.Y / 100.0f; // Flip Y axis
-  ROSVector.Z = UEVector.Z / 100.0f;  // Scale from cm to m
+  // UE: X forward, Y right, Z up (cm) -> ROS: X forward, Y left, Z up (m)
+  return TFrameConversion<double>::UEToROS(UEVector);
+}
+
+void MathToolkitLibrary::ConvertUEToROS(TConstArrayView<FVector> In, TArrayView<FVector> Out)
+{
+  MATHTOOLKIT_SCOPE(FrameConversion);
+  MATHTOOLKIT_COUNT(PointsConverted, In.Num());
+  TFrameConversion<double>::UEToROS(In, Out);
+}
+
+void MathToolkitLibrary::ConvertROSToUE(TConstArrayView<FVector> In, TArrayView<FVector> Out)
+{
+  MATHTOOLKIT_SCOPE(FrameConversion);
+  MATHTOOLKIT_COUNT(PointsConverted, In.Num());
+  TFrameConversion<double>::ROSToUE(In, Out);
+}
+
+void MathToolkitLibrary::ConvertUEToROS(TConstArrayView<float> InXYZ, TArrayView<float> OutXYZ, int32 PointStride)
+{
+  MATHTOOLKIT_SCOPE(FrameConversion);
+  MATHTOOLKIT_COUNT(PointsConverted, InXYZ.Num() / PointStride);
+  MathToolkitKernels::ScaleInterleavedXYZ(InXYZ, OutXYZ, FVector3f(0.01f, -0.01f, 0.01f), PointStride);
+}
+
+void MathToolkitLibrary::ConvertROSToUE(TConstArrayView<float> InXYZ, TArrayView<float> OutXYZ, int32 PointStride)
+{
+  MATHTOOLKIT_SCOPE(FrameConversion);
+  MATHTOOLKIT_COUNT(PointsConverted, InXYZ.Num() / PointStride);
+  MathToolkitKernels::ScaleInterleavedXYZ(InXYZ, OutXYZ, FVector3f(100.0f, -100.0f, 100.0f), PointStride);
+}
+
+void MathToolkitLibrary::ConvertUEToROS(TConstArrayView<FVector> In, TArrayView<float> OutXYZ, int32 PointStride)
+{
+  MATHTOOLKIT_SCOPE(FrameConversion);
+  MATHTOOLKIT_COUNT(PointsConverted, In.Num());
+  check(PointStride >= 3);
+  check(OutXYZ.Num() == In.Num() * PointStride);
+  const FVector* RESTRICT Src = In.GetData();
+  float* RESTRICT Dst = OutXYZ.GetData();
+  for (int32 i = 0; i < In.Num(); ++i)
+  {
+    Dst[i * PointStride + 0] = static_cast<float>(Src[i].X * 0.01);
+    Dst[i * PointStride + 1] = static_cast<float>(Src[i].Y * -0.01);
+    Dst[i * PointStride + 2] = static_cast<float>(Src[i].Z * 0.01);
+  }
+}
+
+FQuat MathToolkitLibrary::ConvertUEToROS(const FQuat &UERotation)
+{
+  // Mirroring the Y axis conjugates the rotation: the axis is mirrored and the angle negated
+  return FQuat(-UERotation.X, UERotation.Y, -UERotation.Z, UERotation.W);
+}
+
+FQuat MathToolkitLibrary::ConvertROSToUE(const FQuat &ROSRotation)
+{
+  // The mirror is its own inverse
+  return FQuat(-ROSRotation.X, ROSRotation.Y, -ROSRotation.Z, ROSRotation.W);
+}
+
+void MathToolkitLibrary::ConvertUEToROS(TConstArrayView<FTransform> In, TArrayView<FROSPose> Out)
+{
+  MATHTOOLKIT_SCOPE(FrameConversion);
+  MATHTOOLKIT_COUNT(PointsConverted, In.Num());
+  check(Out.Num() == In.Num());
+  for (int32 i = 0; i < In.Num(); ++i)
+  {
+    const FVector Position = In[i].GetTranslation();
+    const FQuat Rotation = In[i].GetRotation();
+    Out[i].Position = FVector(Position.X * 0.01, Position.Y * -0.01, Position.Z * 0.01);
+    Out[i].Orientation = FQuat(-Rotation.X, Rotation.Y, -Rotation.Z, Rotation.W);
+  }
+}
+
+void MathToolkitLibrary::ConvertROSToUE(TConstArrayView<FROSPose> In, TArrayView<FTransform> Out)
+{
+  MATHTOOLKIT_SCOPE(FrameConversion);
+  MATHTOOLKIT_COUNT(PointsConverted, In.Num());
+  check(Out.Num() == In.Num());
+  for (int32 i = 0; i < In.Num(); ++i)
+  {
+    const FVector& Position = In[i].Position;
+    const FQuat& Rotation = In[i].Orientation;
+    Out[i] = FTransform(
+      FQuat(-Rotation.X, Rotation.Y, -Rotation.Z, Rotation.W),
+      FVector(Position.X * 100.0, Position.Y * -100.0, Position.Z * 100.0));
+  }
+}
+
+void MathToolkitLibrary::ConvertUEToROS(TConstArrayView<FVector> Positions, TConstArrayView<FQuat> Rotations, TArrayView<FVector> OutPositions, TArrayView<FQuat> OutRotations)
+{
+  check(Rotations.Num() == Positions.Num());
+  ConvertUEToROS(Positions, OutPositions);
+
+  check(OutRotations.Num() == Rotations.Num());
+  const FQuat* Src = Rotations.GetData();
+  FQuat* Dst = OutRotations.GetData();
+  for (int32 i = 0; i < Rotations.Num(); ++i)
+  {
+    const FQuat Q = Src[i];
+    Dst[i] = FQuat(-Q.X, Q.Y, -Q.Z, Q.W);
+  }
+}
 
-  return ROSVector;
+void MathToolkitLibrary::ConvertROSToUE(TConstArrayView<FVector> Positions, TConstArrayView<FQuat> Rotations, TArrayView<FVector> OutPositions, TArrayView<FQuat> OutRotations)
+{
+  // Both the position and the rotation mirror are involutions apart from the unit scale
+  check(Rotations.Num() == Positions.Num());
+  ConvertROSToUE(Positions, OutPositions);
+
+  check(OutRotations.Num() == Rotations.Num());
+  const FQuat* Src = Rotations.GetData();
+  FQuat* Dst = OutRotations.GetData();
+  for (int32 i = 0; i < Rotations.Num(); ++i)
+  {
+    const FQuat Q = Src[i];
+    Dst[i] = FQuat(-Q.X, Q.Y, -Q.Z, Q.W);
+  }
 }
 
 FVector MathToolkitLibrary::ConvertUEToROSAngleDegree(const FVector &rotation)
@@ -72,34 +190,9 @@ std::pair<FVector, FVector> MathToolkitLibrary::CalculateSphericalFromDepth(
     uint32 width,
     uint32 height)
 {
-    Depth *= 0.01f;
-
-    float NDC_X = (2.0f * x / width) - 1.0f;
-    float NDC_Y = 1.0f - (2.0f * y / height);
-
-    float AspectRatio = static_cast<float>(width) / height;
-    float FOVHRad = FMath::DegreesToRadians(FOVH);
-    float FOVVRad = 2.0f * FMath::Atan(FMath::Tan(FOVHRad / 2.0f) / AspectRatio);
-
-    float halfFOVHRad = FOVHRad / 2.0f;
-    float halfFOVVRad = FOVVRad / 2.0f;
-    float tanHalfFOVHRad = FMath::Tan(halfFOVHRad);
-    float tanHalfFOVVRad = FMath::Tan(halfFOVVRad);
-
-    float CameraX = Depth;
-    float CameraY = NDC_X * Depth * tanHalfFOVHRad;
-    float CameraZ = NDC_Y * Depth * tanHalfFOVVRad;
-
-    FVector point(CameraX * 100.0f, CameraY * 100.0f, CameraZ * 100.0f);
-
-    float r = FMath::Sqrt(FMath::Square(point.X) + FMath::Square(point.Y) + FMath::Square(point.Z));
-    float vCoord = FMath::Acos(point.Z / r);
-    float hCoord = FMath::Atan2(point.Y, point.X);
-
-    vCoord = (PI / 2.0f) - vCoord;
-    FVector spherical(r, hCoord, vCoord);
-
-    return std::pair<FVector, FVector>(spherical, point);
+    float tanHalfFOVHRad, tanHalfFOVVRad;
+    TFrameConversion<float>::TanHalfFOV(FOVH, width, height, tanHalfFOVHRad, tanHalfFOVVRad);
+    return CalculateSphericalFromDepth(Depth, x, y, tanHalfFOVHRad, tanHalfFOVVRad, width, height);
 }
 
 std::pair<FVector, FVector> MathToolkitLibrary::CalculateSphericalFromDepth(
@@ -111,54 +204,146 @@ std::pair<FVector, FVector> MathToolkitLibrary::CalculateSphericalFromDepth(
     uint32 width,
     uint32 height)
 {
-    Depth *= 0.01f;
-
-    float NDC_X = (2.0f * x / width) - 1.0f;
-    float NDC_Y = 1.0f - (2.0f * y / height);
-
-    float CameraX = Depth;
-    float CameraY = NDC_X * Depth * tanHalfFOVHRad;
-    float CameraZ = NDC_Y * Depth * tanHalfFOVVRad;
-
-    FVector point(CameraX * 100.0f, CameraY * 100.0f, CameraZ * 100.0f);
+    // Computed in float like the float inputs; callers holding doubles use TFrameConversion<double> directly
+    const std::pair<FVector3f, FVector3f> Result =
+        TFrameConversion<float>::SphericalFromDepth(Depth, x, y, tanHalfFOVHRad, tanHalfFOVVRad, width, height);
+    return std::pair<FVector, FVector>(FVector(Result.first), FVector(Result.second));
+}
 
-    float r = FMath::Sqrt(FMath::Square(point.X) + FMath::Square(point.Y) + FMath::Square(point.Z));
-    float vCoord = FMath::Acos(point.Z / r);
-    float hCoord = FMath::Atan2(point.Y, point.X);
+void MathToolkitLibrary::CalculateTanHalfFOV(float FOVH, uint32 width, uint32 height, float& tanHalfFOVHRad, float& tanHalfFOVVRad)
+{
+    float AspectRatio = static_cast<float>(width) / height;
+    tanHalfFOVHRad = FMath::Tan(FMath::DegreesToRadians(FOVH) / 2.0f);
+    // tan(FOVV / 2) with FOVV = 2 * atan(tan(FOVH / 2) / AspectRatio)
+    tanHalfFOVVRad = tanHalfFOVHRad / AspectRatio;
+}
 
-    vCoord = (PI / 2.0f) - vCoord;
-    FVector spherical(r, hCoord, vCoord);
+void MathToolkitLibrary::CalculatePointCloudFromDepth(
+    TConstArrayView<float> Depth,
+    float FOVH,
+    uint32 width,
+    uint32 height,
+    const FDepthPointCloudSoA& Out)
+{
+    float tanHalfFOVHRad, tanHalfFOVVRad;
+    CalculateTanHalfFOV(FOVH, width, height, tanHalfFOVHRad, tanHalfFOVVRad);
+    CalculatePointCloudFromDepth(Depth, tanHalfFOVHRad, tanHalfFOVVRad, width, height, Out);
+}
 
-    return std::pair<FVector, FVector>(spherical, point);
+void MathToolkitLibrary::CalculatePointCloudFromDepth(
+    TConstArrayView<float> Depth,
+    float tanHalfFOVHRad,
+    float tanHalfFOVVRad,
+    uint32 width,
+    uint32 height,
+    const FDepthPointCloudSoA& Out)
+{
+    MATHTOOLKIT_SCOPE(DepthConversion);
+    const int32 NumPixels = static_cast<int32>(width * height);
+    check(Depth.Num() >= NumPixels);
+    check(Out.X.IsEmpty() || Out.X.Num() >= NumPixels);
+    check(Out.Y.IsEmpty() || Out.Y.Num() >= NumPixels);
+    check(Out.Z.IsEmpty() || Out.Z.Num() >= NumPixels);
+    check(Out.Range.IsEmpty() || Out.Range.Num() >= NumPixels);
+    check(Out.Azimuth.IsEmpty() || Out.Azimuth.Num() >= NumPixels);
+    check(Out.Elevation.IsEmpty() || Out.Elevation.Num() >= NumPixels);
+    MATHTOOLKIT_COUNT(PointsConverted, NumPixels);
+
+    // Per-column terms: Y slope of the pixel ray, its azimuth and 1 / |(1, slope)|.
+    // The ray angles only depend on the pixel, so they are hoisted out of the depth loop entirely.
+    TArray<float> ColumnSlope, ColumnAzimuth, ColumnInvHorizontal;
+    ColumnSlope.SetNumUninitialized(width);
+    ColumnAzimuth.SetNumUninitialized(width);
+    ColumnInvHorizontal.SetNumUninitialized(width);
+    for (uint32 x = 0; x < width; ++x)
+    {
+        float NDC_X = (2.0f * x / width) - 1.0f;
+        ColumnSlope[x] = NDC_X * tanHalfFOVHRad;
+        ColumnAzimuth[x] = FMath::Atan(ColumnSlope[x]);
+        ColumnInvHorizontal[x] = FMath::InvSqrt(1.0f + FMath::Square(ColumnSlope[x]));
+    }
+
+    const float* RESTRICT Slope = ColumnSlope.GetData();
+    const float* RESTRICT InvHorizontal = ColumnInvHorizontal.GetData();
+
+    for (uint32 y = 0; y < height; ++y)
+    {
+        float NDC_Y = 1.0f - (2.0f * y / height);
+        const float RowSlope = NDC_Y * tanHalfFOVVRad;
+        const float RowSlopeSq = FMath::Square(RowSlope);
+
+        const int32 RowStart = static_cast<int32>(y * width);
+        const float* RESTRICT D = Depth.GetData() + RowStart;
+
+        // One tight loop per channel keeps every loop trivially vectorizable.
+        if (!Out.X.IsEmpty())
+        {
+            float* RESTRICT OutX = Out.X.GetData() + RowStart;
+            for (uint32 x = 0; x < width; ++x)
+            {
+                OutX[x] = D[x];
+            }
+        }
+        if (!Out.Y.IsEmpty())
+        {
+            float* RESTRICT OutY = Out.Y.GetData() + RowStart;
+            for (uint32 x = 0; x < width; ++x)
+            {
+                OutY[x] = D[x] * Slope[x];
+            }
+        }
+        if (!Out.Z.IsEmpty())
+        {
+            float* RESTRICT OutZ = Out.Z.GetData() + RowStart;
+            for (uint32 x = 0; x < width; ++x)
+            {
+                OutZ[x] = D[x] * RowSlope;
+            }
+        }
+        if (!Out.Range.IsEmpty())
+        {
+            float* RESTRICT OutRange = Out.Range.GetData() + RowStart;
+            for (uint32 x = 0; x < width; ++x)
+            {
+                OutRange[x] = D[x] * FMath::Sqrt(1.0f + Slope[x] * Slope[x] + RowSlopeSq);
+            }
+        }
+        if (!Out.Azimuth.IsEmpty())
+        {
+            FMemory::Memcpy(Out.Azimuth.GetData() + RowStart, ColumnAzimuth.GetData(), width * sizeof(float));
+        }
+        if (!Out.Elevation.IsEmpty())
+        {
+            // asin(z / r) == atan(RowSlope / |(1, ColumnSlope)|), so no per-pixel Acos or division by r
+            float* RESTRICT OutElevation = Out.Elevation.GetData() + RowStart;
+            for (uint32 x = 0; x < width; ++x)
+            {
+                OutElevation[x] = RowSlope * InvHorizontal[x];
+            }
+            TArrayView<float> ElevationRow(OutElevation, width);
+            MathToolkitKernels::Atan(ElevationRow, ElevationRow);
+        }
+    }
 }
 
 
 
 std::pair<float, float> MathToolkitLibrary::CalculateNDCCoordinates(
-    float beta,
-    float alpha,
+    float azimuth,
+    float elevation,
     float FOVH,
     uint32 width,
     uint32 height)
 {
-    float AspectRatio = static_cast<float>(height) / width;
-    float FOVHRad = FMath::DegreesToRadians(FOVH);
-    float FOVVRad = FMath::DegreesToRadians(FOVH) * AspectRatio;
-
-    float a = FMath::Tan(FOVHRad / 2.0f);
-    float b = FMath::Tan(FOVVRad / 2.0f);
-
-    float cos_alpha = FMath::Cos(alpha);
-    float sin_alpha = FMath::Sin(alpha);
-    float sin_beta = FMath::Sin(beta);
+    float tanHalfFOVHRad, tanHalfFOVVRad;
+    CalculateTanHalfFOV(FOVH, width, height, tanHalfFOVHRad, tanHalfFOVVRad);
 
-    
-    // For ndc_x, you should use the appropriate formula. Assuming you need ndc_x as:
-    float ndc_x = FMath::Sqrt(-((FMath::Square(sin_alpha) * FMath::Square(sin_beta)) / (FMath::Square(a) * (-1 + FMath::Square(cos_alpha) + FMath::Square(sin_alpha) * FMath::Square(sin_beta)))));    //UE_LOG(LogTemp, Warning, TEXT("COS_alpha: %f, SIN_alpha: %f, SIN_beta: %f, a: %f, b: %f"), cos_alpha, sin_alpha, sin_beta, a, b);
-    //UE_LOG(LogTemp, Warning, TEXT("NDC: %f"), ndc_x);
+    // Ray direction (cos el cos az, cos el sin az, sin el): Y / X = tan az and Z / X = tan el / cos az
+    float ndc_x = FMath::Tan(azimuth) / tanHalfFOVHRad;
+    float ndc_y = FMath::Tan(elevation) / (FMath::Cos(azimuth) * tanHalfFOVVRad);
 
     float x = (ndc_x + 1.0f) * width / 2.0f;
-    float y = (1.0f - 0) * height / 2.0f;
+    float y = (1.0f - ndc_y) * height / 2.0f;
 
     return std::pair<float, float>(x, y);
 }
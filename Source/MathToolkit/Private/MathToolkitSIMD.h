@@ -0,0 +1,439 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Widest vector ISA the module is compiled for. Selection is compile time: AVX2 needs the
+// target to be built with AVX2 enabled, SSE2 is the x64 baseline and NEON the arm64 one.
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define MATHTOOLKIT_SIMD_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MATHTOOLKIT_SIMD_SSE2 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define MATHTOOLKIT_SIMD_NEON 1
+#endif
+
+#ifndef MATHTOOLKIT_SIMD_AVX2
+#define MATHTOOLKIT_SIMD_AVX2 0
+#endif
+#ifndef MATHTOOLKIT_SIMD_SSE2
+#define MATHTOOLKIT_SIMD_SSE2 0
+#endif
+#ifndef MATHTOOLKIT_SIMD_NEON
+#define MATHTOOLKIT_SIMD_NEON 0
+#endif
+
+/**
+ * Thin per-ISA lane wrappers so every kernel is written once and instantiated for the vector
+ * type and for plain float (used for loop tails and as the scalar fallback). Masks are lanes
+ * with all bits set or clear.
+ */
+namespace MathToolkitSIMD
+{
+
+template<typename V>
+struct TLanes;
+
+/** IEEE binary16 bits of F, rounded to nearest even; overflow gives infinity, NaN stays NaN. */
+FORCEINLINE uint16 FloatToHalf(float F)
+{
+    uint32 Bits;
+    FMemory::Memcpy(&Bits, &F, sizeof(Bits));
+    const uint32 Sign = Bits & 0x80000000u;
+    Bits ^= Sign;
+    uint32 Half;
+    if (Bits >= 0x47800000u)
+    {
+        // At least 2^16 (or Inf / NaN): no finite half left
+        Half = Bits > 0x7F800000u ? 0x7E00u : 0x7C00u;
+    }
+    else if (Bits < 0x38800000u)
+    {
+        // Below the smallest normal half: adding 0.5 lines the subnormal mantissa up with the low bits
+        float Shifted;
+        FMemory::Memcpy(&Shifted, &Bits, sizeof(Shifted));
+        Shifted += 0.5f;
+        FMemory::Memcpy(&Half, &Shifted, sizeof(Half));
+        Half -= 0x3F000000u;
+    }
+    else
+    {
+        // Rebias the exponent and round the 13 dropped mantissa bits to even
+        const uint32 MantissaOdd = (Bits >> 13) & 1u;
+        Half = (Bits + 0xC8000FFFu + MantissaOdd) >> 13;
+    }
+    return static_cast<uint16>(Half | (Sign >> 16));
+}
+
+#if MATHTOOLKIT_SIMD_AVX2 || MATHTOOLKIT_SIMD_SSE2
+/** FloatToHalf of four lanes, each result in the low 16 bits of its 32-bit lane. */
+FORCEINLINE __m128i FloatToHalf(__m128 A)
+{
+    const __m128i Bits = _mm_castps_si128(A);
+    const __m128i Sign = _mm_and_si128(Bits, _mm_set1_epi32(static_cast<int32>(0x80000000u)));
+    const __m128i Abs = _mm_xor_si128(Bits, Sign);
+
+    const __m128i IsInfNaN = _mm_cmpgt_epi32(Abs, _mm_set1_epi32(0x477FFFFF));
+    const __m128i InfNaN = _mm_or_si128(_mm_set1_epi32(0x7C00), _mm_and_si128(_mm_cmpgt_epi32(Abs, _mm_set1_epi32(0x7F800000)), _mm_set1_epi32(0x0200)));
+
+    const __m128i IsSubnormal = _mm_cmplt_epi32(Abs, _mm_set1_epi32(0x38800000));
+    const __m128i Subnormal = _mm_sub_epi32(_mm_castps_si128(_mm_add_ps(_mm_castsi128_ps(Abs), _mm_set1_ps(0.5f))), _mm_set1_epi32(0x3F000000));
+
+    const __m128i MantissaOdd = _mm_and_si128(_mm_srli_epi32(Abs, 13), _mm_set1_epi32(1));
+    const __m128i Normal = _mm_srli_epi32(_mm_add_epi32(_mm_add_epi32(Abs, _mm_set1_epi32(static_cast<int32>(0xC8000FFFu))), MantissaOdd), 13);
+
+    __m128i Half = _mm_or_si128(_mm_and_si128(IsSubnormal, Subnormal), _mm_andnot_si128(IsSubnormal, Normal));
+    Half = _mm_or_si128(_mm_and_si128(IsInfNaN, InfNaN), _mm_andnot_si128(IsInfNaN, Half));
+    return _mm_or_si128(Half, _mm_srli_epi32(Sign, 16));
+}
+
+/** Low 16 bits of each 32-bit lane of A, then of B, as eight packed 16-bit values. */
+FORCEINLINE __m128i PackLow16(__m128i A, __m128i B)
+{
+    // Sign-extending first keeps the saturating pack from clamping anything
+    return _mm_packs_epi32(_mm_srai_epi32(_mm_slli_epi32(A, 16), 16), _mm_srai_epi32(_mm_slli_epi32(B, 16), 16));
+}
+#endif
+
+template<>
+struct TLanes<float>
+{
+    static constexpr int32 Width = 1;
+
+    static FORCEINLINE uint32 AsBits(float A) { uint32 B; FMemory::Memcpy(&B, &A, sizeof(B)); return B; }
+    static FORCEINLINE float FromBits(uint32 B) { float A; FMemory::Memcpy(&A, &B, sizeof(A)); return A; }
+
+    static FORCEINLINE float Load(const float* P) { return *P; }
+    static FORCEINLINE void Store(float* P, float A) { *P = A; }
+    static FORCEINLINE float Set1(float A) { return A; }
+    static FORCEINLINE float Add(float A, float B) { return A + B; }
+    static FORCEINLINE float Sub(float A, float B) { return A - B; }
+    static FORCEINLINE float Mul(float A, float B) { return A * B; }
+    static FORCEINLINE float Div(float A, float B) { return A / B; }
+    static FORCEINLINE float Sqrt(float A) { return std::sqrt(A); }
+    static FORCEINLINE float Min(float A, float B) { return A < B ? A : B; }
+    static FORCEINLINE float Max(float A, float B) { return A > B ? A : B; }
+    static FORCEINLINE float And(float A, float B) { return FromBits(AsBits(A) & AsBits(B)); }
+    static FORCEINLINE float Or(float A, float B) { return FromBits(AsBits(A) | AsBits(B)); }
+    static FORCEINLINE float Xor(float A, float B) { return FromBits(AsBits(A) ^ AsBits(B)); }
+    static FORCEINLINE float AndNot(float A, float B) { return FromBits(~AsBits(A) & AsBits(B)); }
+    static FORCEINLINE float CmpLt(float A, float B) { return FromBits(A < B ? 0xFFFFFFFFu : 0u); }
+    static FORCEINLINE float Select(float Mask, float A, float B) { return Or(And(Mask, A), AndNot(Mask, B)); }
+    /** Bit k set where lane k of Mask is set. */
+    static FORCEINLINE int32 MoveMask(float Mask) { return static_cast<int32>(AsBits(Mask) >> 31); }
+
+    /**
+     * Narrowing stores: binary16, and integers rounded to nearest even and saturated to the type,
+     * except that int16 saturates symmetrically to +-32767 so a stored value can always be negated.
+     * The integer stores write NaN as 0 in every lane implementation.
+     */
+    static FORCEINLINE void StoreHalf(uint16* P, float A) { *P = FloatToHalf(A); }
+    static FORCEINLINE void StoreInt16(int16* P, float A) { *P = A == A ? static_cast<int16>(std::nearbyint(FMath::Clamp(A, -32767.0f, 32767.0f))) : 0; }
+    static FORCEINLINE void StoreUInt16(uint16* P, float A) { *P = A == A ? static_cast<uint16>(std::nearbyint(FMath::Clamp(A, 0.0f, 65535.0f))) : 0; }
+
+    /**
+     * Rounds X (an angle in quarter turns) to the nearest integer J and returns it as float, together
+     * with the quadrant masks of J: swap sin/cos where J is odd, and the sign bits of sin and cos.
+     */
+    static FORCEINLINE float Quadrant(float X, float& SwapMask, float& SinSign, float& CosSign)
+    {
+        const int32 J = FMath::RoundToInt(X);
+        const uint32 Q = static_cast<uint32>(J);
+        SwapMask = FromBits((Q & 1u) ? 0xFFFFFFFFu : 0u);
+        SinSign = FromBits((Q & 2u) << 30);
+        CosSign = FromBits(((Q + 1u) & 2u) << 30);
+        return static_cast<float>(J);
+    }
+};
+
+#if MATHTOOLKIT_SIMD_AVX2
+template<>
+struct TLanes<__m256>
+{
+    static constexpr int32 Width = 8;
+
+    static FORCEINLINE __m256 Load(const float* P) { return _mm256_loadu_ps(P); }
+    static FORCEINLINE void Store(float* P, __m256 A) { _mm256_storeu_ps(P, A); }
+    static FORCEINLINE __m256 Set1(float A) { return _mm256_set1_ps(A); }
+    static FORCEINLINE __m256 Add(__m256 A, __m256 B) { return _mm256_add_ps(A, B); }
+    static FORCEINLINE __m256 Sub(__m256 A, __m256 B) { return _mm256_sub_ps(A, B); }
+    static FORCEINLINE __m256 Mul(__m256 A, __m256 B) { return _mm256_mul_ps(A, B); }
+    static FORCEINLINE __m256 Div(__m256 A, __m256 B) { return _mm256_div_ps(A, B); }
+    static FORCEINLINE __m256 Sqrt(__m256 A) { return _mm256_sqrt_ps(A); }
+    static FORCEINLINE __m256 Min(__m256 A, __m256 B) { return _mm256_min_ps(A, B); }
+    static FORCEINLINE __m256 Max(__m256 A, __m256 B) { return _mm256_max_ps(A, B); }
+    static FORCEINLINE __m256 And(__m256 A, __m256 B) { return _mm256_and_ps(A, B); }
+    static FORCEINLINE __m256 Or(__m256 A, __m256 B) { return _mm256_or_ps(A, B); }
+    static FORCEINLINE __m256 Xor(__m256 A, __m256 B) { return _mm256_xor_ps(A, B); }
+    static FORCEINLINE __m256 AndNot(__m256 A, __m256 B) { return _mm256_andnot_ps(A, B); }
+    static FORCEINLINE __m256 CmpLt(__m256 A, __m256 B) { return _mm256_cmp_ps(A, B, _CMP_LT_OQ); }
+    static FORCEINLINE __m256 Select(__m256 Mask, __m256 A, __m256 B) { return _mm256_blendv_ps(B, A, Mask); }
+    static FORCEINLINE int32 MoveMask(__m256 Mask) { return _mm256_movemask_ps(Mask); }
+
+    static FORCEINLINE void StoreHalf(uint16* P, __m256 A)
+    {
+#if defined(__F16C__) || defined(_MSC_VER)
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(P), _mm256_cvtps_ph(A, _MM_FROUND_TO_NEAREST_INT));
+#else
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(P), PackLow16(FloatToHalf(_mm256_castps256_ps128(A)), FloatToHalf(_mm256_extractf128_ps(A, 1))));
+#endif
+    }
+    static FORCEINLINE void StoreInt16(int16* P, __m256 A)
+    {
+        // max/min return the bound for NaN, so zero NaN lanes first
+        const __m256 Ordered = And(_mm256_cmp_ps(A, A, _CMP_ORD_Q), A);
+        const __m256i I = _mm256_cvtps_epi32(Min(Max(Ordered, Set1(-32767.0f)), Set1(32767.0f)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(P), _mm_packs_epi32(_mm256_castsi256_si128(I), _mm256_extracti128_si256(I, 1)));
+    }
+    static FORCEINLINE void StoreUInt16(uint16* P, __m256 A)
+    {
+        const __m256 Ordered = And(_mm256_cmp_ps(A, A, _CMP_ORD_Q), A);
+        const __m256i I = _mm256_cvtps_epi32(Min(Max(Ordered, Set1(0.0f)), Set1(65535.0f)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(P), PackLow16(_mm256_castsi256_si128(I), _mm256_extracti128_si256(I, 1)));
+    }
+
+    static FORCEINLINE __m256 Quadrant(__m256 X, __m256& SwapMask, __m256& SinSign, __m256& CosSign)
+    {
+        const __m256i Q = _mm256_cvtps_epi32(X);
+        const __m256i One = _mm256_set1_epi32(1);
+        const __m256i Two = _mm256_set1_epi32(2);
+        SwapMask = _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(Q, One), One));
+        SinSign = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(Q, Two), 30));
+        CosSign = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(_mm256_add_epi32(Q, One), Two), 30));
+        return _mm256_cvtepi32_ps(Q);
+    }
+};
+typedef __m256 FVectorLanes;
+#elif MATHTOOLKIT_SIMD_SSE2
+template<>
+struct TLanes<__m128>
+{
+    static constexpr int32 Width = 4;
+
+    static FORCEINLINE __m128 Load(const float* P) { return _mm_loadu_ps(P); }
+    static FORCEINLINE void Store(float* P, __m128 A) { _mm_storeu_ps(P, A); }
+    static FORCEINLINE __m128 Set1(float A) { return _mm_set1_ps(A); }
+    static FORCEINLINE __m128 Add(__m128 A, __m128 B) { return _mm_add_ps(A, B); }
+    static FORCEINLINE __m128 Sub(__m128 A, __m128 B) { return _mm_sub_ps(A, B); }
+    static FORCEINLINE __m128 Mul(__m128 A, __m128 B) { return _mm_mul_ps(A, B); }
+    static FORCEINLINE __m128 Div(__m128 A, __m128 B) { return _mm_div_ps(A, B); }
+    static FORCEINLINE __m128 Sqrt(__m128 A) { return _mm_sqrt_ps(A); }
+    static FORCEINLINE __m128 Min(__m128 A, __m128 B) { return _mm_min_ps(A, B); }
+    static FORCEINLINE __m128 Max(__m128 A, __m128 B) { return _mm_max_ps(A, B); }
+    static FORCEINLINE __m128 And(__m128 A, __m128 B) { return _mm_and_ps(A, B); }
+    static FORCEINLINE __m128 Or(__m128 A, __m128 B) { return _mm_or_ps(A, B); }
+    static FORCEINLINE __m128 Xor(__m128 A, __m128 B) { return _mm_xor_ps(A, B); }
+    static FORCEINLINE __m128 AndNot(__m128 A, __m128 B) { return _mm_andnot_ps(A, B); }
+    static FORCEINLINE __m128 CmpLt(__m128 A, __m128 B) { return _mm_cmplt_ps(A, B); }
+    static FORCEINLINE __m128 Select(__m128 Mask, __m128 A, __m128 B) { return _mm_or_ps(_mm_and_ps(Mask, A), _mm_andnot_ps(Mask, B)); }
+    static FORCEINLINE int32 MoveMask(__m128 Mask) { return _mm_movemask_ps(Mask); }
+
+    static FORCEINLINE void StoreHalf(uint16* P, __m128 A)
+    {
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(P), PackLow16(FloatToHalf(A), _mm_setzero_si128()));
+    }
+    static FORCEINLINE void StoreInt16(int16* P, __m128 A)
+    {
+        // max/min return the bound for NaN, so zero NaN lanes first
+        const __m128 Ordered = And(_mm_cmpord_ps(A, A), A);
+        const __m128i I = _mm_cvtps_epi32(Min(Max(Ordered, Set1(-32767.0f)), Set1(32767.0f)));
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(P), _mm_packs_epi32(I, I));
+    }
+    static FORCEINLINE void StoreUInt16(uint16* P, __m128 A)
+    {
+        const __m128 Ordered = And(_mm_cmpord_ps(A, A), A);
+        const __m128i I = _mm_cvtps_epi32(Min(Max(Ordered, Set1(0.0f)), Set1(65535.0f)));
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(P), PackLow16(I, I));
+    }
+
+    static FORCEINLINE __m128 Quadrant(__m128 X, __m128& SwapMask, __m128& SinSign, __m128& CosSign)
+    {
+        const __m128i Q = _mm_cvtps_epi32(X);
+        const __m128i One = _mm_set1_epi32(1);
+        const __m128i Two = _mm_set1_epi32(2);
+        SwapMask = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(Q, One), One));
+        SinSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(Q, Two), 30));
+        CosSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(_mm_add_epi32(Q, One), Two), 30));
+        return _mm_cvtepi32_ps(Q);
+    }
+};
+typedef __m128 FVectorLanes;
+#elif MATHTOOLKIT_SIMD_NEON
+template<>
+struct TLanes<float32x4_t>
+{
+    static constexpr int32 Width = 4;
+
+    static FORCEINLINE uint32x4_t U(float32x4_t A) { return vreinterpretq_u32_f32(A); }
+    static FORCEINLINE float32x4_t F(uint32x4_t A) { return vreinterpretq_f32_u32(A); }
+
+    static FORCEINLINE float32x4_t Load(const float* P) { return vld1q_f32(P); }
+    static FORCEINLINE void Store(float* P, float32x4_t A) { vst1q_f32(P, A); }
+    static FORCEINLINE float32x4_t Set1(float A) { return vdupq_n_f32(A); }
+    static FORCEINLINE float32x4_t Add(float32x4_t A, float32x4_t B) { return vaddq_f32(A, B); }
+    static FORCEINLINE float32x4_t Sub(float32x4_t A, float32x4_t B) { return vsubq_f32(A, B); }
+    static FORCEINLINE float32x4_t Mul(float32x4_t A, float32x4_t B) { return vmulq_f32(A, B); }
+    static FORCEINLINE float32x4_t Div(float32x4_t A, float32x4_t B) { return vdivq_f32(A, B); }
+    static FORCEINLINE float32x4_t Sqrt(float32x4_t A) { return vsqrtq_f32(A); }
+    static FORCEINLINE float32x4_t Min(float32x4_t A, float32x4_t B) { return vminq_f32(A, B); }
+    static FORCEINLINE float32x4_t Max(float32x4_t A, float32x4_t B) { return vmaxq_f32(A, B); }
+    static FORCEINLINE float32x4_t And(float32x4_t A, float32x4_t B) { return F(vandq_u32(U(A), U(B))); }
+    static FORCEINLINE float32x4_t Or(float32x4_t A, float32x4_t B) { return F(vorrq_u32(U(A), U(B))); }
+    static FORCEINLINE float32x4_t Xor(float32x4_t A, float32x4_t B) { return F(veorq_u32(U(A), U(B))); }
+    static FORCEINLINE float32x4_t AndNot(float32x4_t A, float32x4_t B) { return F(vbicq_u32(U(B), U(A))); }
+    static FORCEINLINE float32x4_t CmpLt(float32x4_t A, float32x4_t B) { return F(vcltq_f32(A, B)); }
+    static FORCEINLINE float32x4_t Select(float32x4_t Mask, float32x4_t A, float32x4_t B) { return vbslq_f32(U(Mask), A, B); }
+    static FORCEINLINE int32 MoveMask(float32x4_t Mask)
+    {
+        const int32x4_t Shift = { 0, 1, 2, 3 };
+        return static_cast<int32>(vaddvq_u32(vshlq_u32(vshrq_n_u32(U(Mask), 31), Shift)));
+    }
+
+    static FORCEINLINE void StoreHalf(uint16* P, float32x4_t A) { vst1_u16(P, vreinterpret_u16_f16(vcvt_f16_f32(A))); }
+    // vcvtn converts NaN to 0 and vqmovn saturates the top; the low end is clamped to match the x86 stores
+    static FORCEINLINE void StoreInt16(int16* P, float32x4_t A) { vst1_s16(P, vqmovn_s32(vmaxq_s32(vcvtnq_s32_f32(A), vdupq_n_s32(-32767)))); }
+    static FORCEINLINE void StoreUInt16(uint16* P, float32x4_t A) { vst1_u16(P, vqmovn_u32(vcvtnq_u32_f32(A))); }
+
+    static FORCEINLINE float32x4_t Quadrant(float32x4_t X, float32x4_t& SwapMask, float32x4_t& SinSign, float32x4_t& CosSign)
+    {
+        const int32x4_t J = vcvtnq_s32_f32(X);
+        const uint32x4_t Q = vreinterpretq_u32_s32(J);
+        const uint32x4_t One = vdupq_n_u32(1);
+        const uint32x4_t Two = vdupq_n_u32(2);
+        SwapMask = F(vceqq_u32(vandq_u32(Q, One), One));
+        SinSign = F(vshlq_n_u32(vandq_u32(Q, Two), 30));
+        CosSign = F(vshlq_n_u32(vandq_u32(vaddq_u32(Q, One), Two), 30));
+        return vcvtq_f32_s32(J);
+    }
+};
+typedef float32x4_t FVectorLanes;
+#else
+typedef float FVectorLanes;
+#endif
+
+/** Widest lane type available in this build (float when there is no vector ISA). */
+typedef TLanes<FVectorLanes> FWideLanes;
+
+/**
+ * Runs Body(Offset, LaneTag) over [0, Count) with the widest lanes, finishing the tail with
+ * scalar lanes so both paths evaluate the same polynomials.
+ */
+template<typename FBody>
+FORCEINLINE void ForEachLane(int32 Count, FBody&& Body)
+{
+    int32 i = 0;
+    for (; i + FWideLanes::Width <= Count; i += FWideLanes::Width)
+    {
+        Body(i, FVectorLanes());
+    }
+    for (; i < Count; ++i)
+    {
+        Body(i, 0.0f);
+    }
+}
+
+/**
+ * Double-precision lanes for kernels that accumulate sums, with the same conventions as the float
+ * lanes: instantiated for the vector type and for plain double, which finishes loop tails.
+ */
+template<typename V>
+struct TDoubleLanes;
+
+template<>
+struct TDoubleLanes<double>
+{
+    static constexpr int32 Width = 1;
+
+    static FORCEINLINE double Load(const double* P) { return *P; }
+    static FORCEINLINE void Store(double* P, double A) { *P = A; }
+    static FORCEINLINE double Set1(double A) { return A; }
+    static FORCEINLINE double Add(double A, double B) { return A + B; }
+    static FORCEINLINE double Mul(double A, double B) { return A * B; }
+    /** A where Lo < Hi, else 0. */
+    static FORCEINLINE double SelectLt(double Lo, double Hi, double A) { return Lo < Hi ? A : 0.0; }
+    /** Wrap-safe difference of uint32 stamps, static_cast<int32>(A - B), as double. */
+    static FORCEINLINE double LoadStampDelta(const uint32* A, const uint32* B) { return static_cast<double>(static_cast<int32>(*A - *B)); }
+};
+
+#if MATHTOOLKIT_SIMD_AVX2
+template<>
+struct TDoubleLanes<__m256d>
+{
+    static constexpr int32 Width = 4;
+
+    static FORCEINLINE __m256d Load(const double* P) { return _mm256_loadu_pd(P); }
+    static FORCEINLINE void Store(double* P, __m256d A) { _mm256_storeu_pd(P, A); }
+    static FORCEINLINE __m256d Set1(double A) { return _mm256_set1_pd(A); }
+    static FORCEINLINE __m256d Add(__m256d A, __m256d B) { return _mm256_add_pd(A, B); }
+    static FORCEINLINE __m256d Mul(__m256d A, __m256d B) { return _mm256_mul_pd(A, B); }
+    static FORCEINLINE __m256d SelectLt(__m256d Lo, __m256d Hi, __m256d A) { return _mm256_and_pd(_mm256_cmp_pd(Lo, Hi, _CMP_LT_OQ), A); }
+    static FORCEINLINE __m256d LoadStampDelta(const uint32* A, const uint32* B)
+    {
+        const __m128i Delta = _mm_sub_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(A)), _mm_loadu_si128(reinterpret_cast<const __m128i*>(B)));
+        return _mm256_cvtepi32_pd(Delta);
+    }
+};
+typedef __m256d FDoubleVectorLanes;
+#elif MATHTOOLKIT_SIMD_SSE2
+template<>
+struct TDoubleLanes<__m128d>
+{
+    static constexpr int32 Width = 2;
+
+    static FORCEINLINE __m128d Load(const double* P) { return _mm_loadu_pd(P); }
+    static FORCEINLINE void Store(double* P, __m128d A) { _mm_storeu_pd(P, A); }
+    static FORCEINLINE __m128d Set1(double A) { return _mm_set1_pd(A); }
+    static FORCEINLINE __m128d Add(__m128d A, __m128d B) { return _mm_add_pd(A, B); }
+    static FORCEINLINE __m128d Mul(__m128d A, __m128d B) { return _mm_mul_pd(A, B); }
+    static FORCEINLINE __m128d SelectLt(__m128d Lo, __m128d Hi, __m128d A) { return _mm_and_pd(_mm_cmplt_pd(Lo, Hi), A); }
+    static FORCEINLINE __m128d LoadStampDelta(const uint32* A, const uint32* B)
+    {
+        const __m128i Delta = _mm_sub_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(A)), _mm_loadl_epi64(reinterpret_cast<const __m128i*>(B)));
+        return _mm_cvtepi32_pd(Delta);
+    }
+};
+typedef __m128d FDoubleVectorLanes;
+#elif MATHTOOLKIT_SIMD_NEON
+template<>
+struct TDoubleLanes<float64x2_t>
+{
+    static constexpr int32 Width = 2;
+
+    static FORCEINLINE float64x2_t Load(const double* P) { return vld1q_f64(P); }
+    static FORCEINLINE void Store(double* P, float64x2_t A) { vst1q_f64(P, A); }
+    static FORCEINLINE float64x2_t Set1(double A) { return vdupq_n_f64(A); }
+    static FORCEINLINE float64x2_t Add(float64x2_t A, float64x2_t B) { return vaddq_f64(A, B); }
+    static FORCEINLINE float64x2_t Mul(float64x2_t A, float64x2_t B) { return vmulq_f64(A, B); }
+    static FORCEINLINE float64x2_t SelectLt(float64x2_t Lo, float64x2_t Hi, float64x2_t A)
+    {
+        return vreinterpretq_f64_u64(vandq_u64(vcltq_f64(Lo, Hi), vreinterpretq_u64_f64(A)));
+    }
+    static FORCEINLINE float64x2_t LoadStampDelta(const uint32* A, const uint32* B)
+    {
+        const int32x2_t Delta = vreinterpret_s32_u32(vsub_u32(vld1_u32(A), vld1_u32(B)));
+        return vcvtq_f64_s64(vmovl_s32(Delta));
+    }
+};
+typedef float64x2_t FDoubleVectorLanes;
+#else
+typedef double FDoubleVectorLanes;
+#endif
+
+/** ForEachLane for double lanes: Body(Offset, LaneTag) with the widest lanes, then a scalar tail. */
+template<typename FBody>
+FORCEINLINE void ForEachDoubleLane(int32 Count, FBody&& Body)
+{
+    int32 i = 0;
+    for (; i + TDoubleLanes<FDoubleVectorLanes>::Width <= Count; i += TDoubleLanes<FDoubleVectorLanes>::Width)
+    {
+        Body(i, FDoubleVectorLanes());
+    }
+    for (; i < Count; ++i)
+    {
+        Body(i, 0.0);
+    }
+}
+
+} // namespace MathToolkitSIMD
@@ -0,0 +1,209 @@
+#include "MathToolkitStats.h"
+
+DEFINE_LOG_CATEGORY(LogMathToolkit);
+
+#if MATHTOOLKIT_ENABLE_INSTRUMENTATION
+DEFINE_STAT(STAT_MathToolkit_Fit);
+DEFINE_STAT(STAT_MathToolkit_DepthConversion);
+DEFINE_STAT(STAT_MathToolkit_FrameConversion);
+DEFINE_STAT(STAT_MathToolkit_Projection);
+DEFINE_STAT(STAT_MathToolkit_LidarResample);
+DEFINE_STAT(STAT_MathToolkit_Serialize);
+DEFINE_STAT(STAT_MathToolkit_Filter);
+DEFINE_STAT(STAT_MathToolkit_Deskew);
+DEFINE_STAT(STAT_MathToolkit_FitsComputed);
+DEFINE_STAT(STAT_MathToolkit_PointsConverted);
+DEFINE_STAT(STAT_MathToolkit_PointsProjected);
+#endif
+
+int32 FMathToolkitLatencyHistogram::GetBucket(uint64 Nanoseconds)
+{
+    return Nanoseconds == 0 ? 0 : FMath::Min<int32>(static_cast<int32>(FMath::FloorLog2_64(Nanoseconds)), NumBuckets - 1);
+}
+
+void FMathToolkitLatencyHistogram::Add(uint64 Nanoseconds)
+{
+    Buckets[GetBucket(Nanoseconds)].fetch_add(1, std::memory_order_relaxed);
+    TotalNanoseconds.fetch_add(Nanoseconds, std::memory_order_relaxed);
+    uint64 Max = MaxNanoseconds.load(std::memory_order_relaxed);
+    while (Nanoseconds > Max && !MaxNanoseconds.compare_exchange_weak(Max, Nanoseconds, std::memory_order_relaxed))
+    {
+    }
+}
+
+void FMathToolkitLatencyHistogram::Reset()
+{
+    for (std::atomic<uint64>& Bucket : Buckets)
+    {
+        Bucket.store(0, std::memory_order_relaxed);
+    }
+    TotalNanoseconds.store(0, std::memory_order_relaxed);
+    MaxNanoseconds.store(0, std::memory_order_relaxed);
+}
+
+uint64 FMathToolkitLatencyHistogram::GetCount() const
+{
+    uint64 Count = 0;
+    for (const std::atomic<uint64>& Bucket : Buckets)
+    {
+        Count += Bucket.load(std::memory_order_relaxed);
+    }
+    return Count;
+}
+
+double FMathToolkitLatencyHistogram::GetMeanNanoseconds() const
+{
+    const uint64 Count = GetCount();
+    return Count == 0 ? 0.0 : static_cast<double>(TotalNanoseconds.load(std::memory_order_relaxed)) / Count;
+}
+
+uint64 FMathToolkitLatencyHistogram::GetPercentileNanoseconds(double Percentile) const
+{
+    const uint64 Count = GetCount();
+    if (Count == 0)
+    {
+        return 0;
+    }
+    // Rank of the sample at this percentile, 1-based
+    const uint64 Rank = FMath::Max<uint64>(1, static_cast<uint64>(FMath::Clamp(Percentile, 0.0, 1.0) * Count + 0.5));
+    uint64 Seen = 0;
+    for (int32 Bucket = 0; Bucket < NumBuckets; ++Bucket)
+    {
+        Seen += Buckets[Bucket].load(std::memory_order_relaxed);
+        if (Seen >= Rank)
+        {
+            // The top bucket is open-ended; the max is the only honest bound there
+            return Bucket == NumBuckets - 1 ? GetMaxNanoseconds() : (uint64(2) << Bucket) - 1;
+        }
+    }
+    return GetMaxNanoseconds();
+}
+
+FMathToolkitStats& FMathToolkitStats::Get()
+{
+    static FMathToolkitStats Instance;
+    return Instance;
+}
+
+FMathToolkitStats::FMathToolkitStats()
+    : ReportIntervalNanoseconds(5000000000ull)
+    , LastReport(NowNanoseconds())
+    , WindowStart(NowNanoseconds())
+    , LastFitReport(0)
+{
+}
+
+uint64 FMathToolkitStats::NowNanoseconds()
+{
+    return static_cast<uint64>(FPlatformTime::Cycles64() * FPlatformTime::GetSecondsPerCycle64() * 1e9);
+}
+
+bool FMathToolkitStats::TryClaim(std::atomic<uint64>& Last, uint64 Now, uint64 Interval)
+{
+    uint64 Previous = Last.load(std::memory_order_relaxed);
+    return Now - Previous >= Interval && Last.compare_exchange_strong(Previous, Now, std::memory_order_relaxed);
+}
+
+void FMathToolkitStats::SetReportInterval(double Seconds)
+{
+    ReportIntervalNanoseconds.store(static_cast<uint64>(FMath::Max(Seconds, 0.0) * 1e9), std::memory_order_relaxed);
+}
+
+double FMathToolkitStats::GetReportInterval() const
+{
+    return ReportIntervalNanoseconds.load(std::memory_order_relaxed) * 1e-9;
+}
+
+bool FMathToolkitStats::MaybeReport()
+{
+    const uint64 Interval = ReportIntervalNanoseconds.load(std::memory_order_relaxed);
+    if (Interval == 0 || !TryClaim(LastReport, NowNanoseconds(), Interval))
+    {
+        return false;
+    }
+    UE_LOG(LogMathToolkit, Log, TEXT("%s"), *Flush());
+    return true;
+}
+
+FString FMathToolkitStats::Flush()
+{
+    const uint64 Now = NowNanoseconds();
+    const double WindowSeconds = (Now - WindowStart.exchange(Now, std::memory_order_relaxed)) * 1e-9;
+
+    FString Summary = FString::Printf(TEXT("MathToolkit over %.1f s:"), WindowSeconds);
+    for (int32 Counter = 0; Counter < static_cast<int32>(EMathToolkitCounter::Count); ++Counter)
+    {
+        const uint64 Amount = Counters[Counter].exchange(0, std::memory_order_relaxed);
+        Summary += FString::Printf(TEXT(" %s %llu;"), GetCounterName(static_cast<EMathToolkitCounter>(Counter)), static_cast<unsigned long long>(Amount));
+    }
+    for (int32 Timer = 0; Timer < static_cast<int32>(EMathToolkitTimer::Count); ++Timer)
+    {
+        FMathToolkitLatencyHistogram& Histogram = Histograms[Timer];
+        if (Histogram.GetCount() > 0)
+        {
+            Summary += FString::Printf(TEXT(" %s n=%llu mean %.1f us p50<%.1f us p99<%.1f us max %.1f us;"),
+                GetTimerName(static_cast<EMathToolkitTimer>(Timer)), static_cast<unsigned long long>(Histogram.GetCount()),
+                Histogram.GetMeanNanoseconds() * 1e-3, Histogram.GetPercentileNanoseconds(0.5) * 1e-3,
+                Histogram.GetPercentileNanoseconds(0.99) * 1e-3, Histogram.GetMaxNanoseconds() * 1e-3);
+        }
+        Histogram.Reset();
+    }
+    return Summary;
+}
+
+void FMathToolkitStats::Reset()
+{
+    for (std::atomic<uint64>& Counter : Counters)
+    {
+        Counter.store(0, std::memory_order_relaxed);
+    }
+    for (FMathToolkitLatencyHistogram& Histogram : Histograms)
+    {
+        Histogram.Reset();
+    }
+    const uint64 Now = NowNanoseconds();
+    WindowStart.store(Now, std::memory_order_relaxed);
+    LastReport.store(Now, std::memory_order_relaxed);
+    FitsSinceReport.store(0, std::memory_order_relaxed);
+}
+
+bool FMathToolkitStats::ReportFit(const FVector& FitA, const FVector& FitB)
+{
+    const uint64 Fits = FitsSinceReport.fetch_add(1, std::memory_order_relaxed) + 1;
+    const uint64 ReportInterval = ReportIntervalNanoseconds.load(std::memory_order_relaxed);
+    if (ReportInterval == 0 || !TryClaim(LastFitReport, NowNanoseconds(), ReportInterval))
+    {
+        return false;
+    }
+    FitsSinceReport.fetch_sub(Fits, std::memory_order_relaxed);
+    UE_LOG(LogMathToolkit, Log, TEXT("Linear fit (%llu since last report): a: %f, %f, %f b: %f, %f, %f"),
+        static_cast<unsigned long long>(Fits), FitA.X, FitA.Y, FitA.Z, FitB.X, FitB.Y, FitB.Z);
+    return true;
+}
+
+const TCHAR* FMathToolkitStats::GetTimerName(EMathToolkitTimer Timer)
+{
+    switch (Timer)
+    {
+    case EMathToolkitTimer::Fit: return TEXT("Fit");
+    case EMathToolkitTimer::DepthConversion: return TEXT("DepthConversion");
+    case EMathToolkitTimer::FrameConversion: return TEXT("FrameConversion");
+    case EMathToolkitTimer::Projection: return TEXT("Projection");
+    case EMathToolkitTimer::LidarResample: return TEXT("LidarResample");
+    case EMathToolkitTimer::Serialize: return TEXT("Serialize");
+    case EMathToolkitTimer::Filter: return TEXT("Filter");
+    case EMathToolkitTimer::Deskew: return TEXT("Deskew");
+    default: return TEXT("Unknown");
+    }
+}
+
+const TCHAR* FMathToolkitStats::GetCounterName(EMathToolkitCounter Counter)
+{
+    switch (Counter)
+    {
+    case EMathToolkitCounter::FitsComputed: return TEXT("FitsComputed");
+    case EMathToolkitCounter::PointsConverted: return TEXT("PointsConverted");
+    case EMathToolkitCounter::PointsProjected: return TEXT("PointsProjected");
+    default: return TEXT("Unknown");
+    }
+}
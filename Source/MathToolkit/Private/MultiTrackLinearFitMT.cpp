@@ -0,0 +1,85 @@
+#include "MultiTrackLinearFitMT.h"
+#include "MathToolkitSIMD.h"
+
+using namespace MathToolkitSIMD;
+
+void FitMultiTrackWindows(const FMultiTrackWindows& Windows, int32 Begin, int32 End, FVector* RESTRICT OutA, FVector* RESTRICT OutB)
+{
+    // Sums of one block of tracks, accumulated slot row by slot row so every row is read contiguously
+    constexpr int32 BlockSize = 128;
+    double Count[BlockSize];
+    double N[BlockSize];
+    double SumT[BlockSize];
+    double SumTT[BlockSize];
+    double SumV[3][BlockSize];
+    double SumTV[3][BlockSize];
+
+    for (int32 First = Begin; First < End; First += BlockSize)
+    {
+        const int32 Num = FMath::Min(BlockSize, End - First);
+        const uint32* RESTRICT Newest = Windows.Newest + First;
+        for (int32 i = 0; i < Num; ++i)
+        {
+            Count[i] = Windows.Counts[First + i];
+            N[i] = SumT[i] = SumTT[i] = 0.0;
+            for (int32 Axis = 0; Axis < 3; ++Axis)
+            {
+                SumV[Axis][i] = SumTV[Axis][i] = 0.0;
+            }
+        }
+
+        for (int32 Slot = 0; Slot < Windows.NumSlots; ++Slot)
+        {
+            const SIZE_T Row = static_cast<SIZE_T>(Slot) * Windows.Stride + First;
+            const double* RESTRICT X = Windows.X + Row;
+            const double* RESTRICT Y = Windows.Y + Row;
+            const double* RESTRICT Z = Windows.Z + Row;
+            const uint32* RESTRICT T = Windows.Timestamps + Row;
+            const double SlotIndex = Slot;
+            // Slots at or past a track's count are masked to zero, so the loop needs no per-track branches
+            ForEachDoubleLane(Num, [&](int32 i, auto Tag)
+            {
+                using L = TDoubleLanes<decltype(Tag)>;
+                const auto Used = L::Load(Count + i);
+                const auto Slots = L::Set1(SlotIndex);
+                const auto W = L::SelectLt(Slots, Used, L::Set1(1.0));
+                const auto Dt = L::SelectLt(Slots, Used, L::LoadStampDelta(T + i, Newest + i));
+                const auto VX = L::SelectLt(Slots, Used, L::Load(X + i));
+                const auto VY = L::SelectLt(Slots, Used, L::Load(Y + i));
+                const auto VZ = L::SelectLt(Slots, Used, L::Load(Z + i));
+                L::Store(N + i, L::Add(L::Load(N + i), W));
+                L::Store(SumT + i, L::Add(L::Load(SumT + i), Dt));
+                L::Store(SumTT + i, L::Add(L::Load(SumTT + i), L::Mul(Dt, Dt)));
+                L::Store(SumV[0] + i, L::Add(L::Load(SumV[0] + i), VX));
+                L::Store(SumV[1] + i, L::Add(L::Load(SumV[1] + i), VY));
+                L::Store(SumV[2] + i, L::Add(L::Load(SumV[2] + i), VZ));
+                L::Store(SumTV[0] + i, L::Add(L::Load(SumTV[0] + i), L::Mul(Dt, VX)));
+                L::Store(SumTV[1] + i, L::Add(L::Load(SumTV[1] + i), L::Mul(Dt, VY)));
+                L::Store(SumTV[2] + i, L::Add(L::Load(SumTV[2] + i), L::Mul(Dt, VZ)));
+            });
+        }
+
+        for (int32 i = 0; i < Num; ++i)
+        {
+            FVector& A = OutA[First + i];
+            FVector& B = OutB[First + i];
+            const double Denominator = N[i] * SumTT[i] - SumT[i] * SumT[i];
+            if (N[i] < 2.0 || FMath::IsNearlyZero(Denominator))
+            {
+                A = FVector::ZeroVector;
+                B = FVector::ZeroVector;
+                continue;
+            }
+            const double InvDenominator = 1.0 / Denominator;
+            const double Reference = static_cast<double>(Newest[i]);
+            for (int32 Axis = 0; Axis < 3; ++Axis)
+            {
+                const double Slope = (N[i] * SumTV[Axis][i] - SumT[i] * SumV[Axis][i]) * InvDenominator;
+                // Intercept relative to the newest timestamp, then moved back to timestamp 0
+                const double Intercept = (SumV[Axis][i] - Slope * SumT[i]) / N[i];
+                A[Axis] = Slope;
+                B[Axis] = Intercept - Slope * Reference;
+            }
+        }
+    }
+}
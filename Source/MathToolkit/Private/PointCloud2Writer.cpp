@@ -0,0 +1,235 @@
+#include "PointCloud2Writer.h"
+#include "MathToolkitStats.h"
+
+#include <limits>
+
+TArray<FPointCloud2Field> FPointCloud2Layout::GetFields() const
+{
+    TArray<FPointCloud2Field> Fields;
+    uint32 Offset = 0;
+    auto AddField = [&Fields, &Offset](const TCHAR* Name)
+    {
+        Fields.Add(FPointCloud2Field{Name, Offset, FPointCloud2Field::Float32, 1});
+        Offset += sizeof(float);
+    };
+    AddField(TEXT("x"));
+    AddField(TEXT("y"));
+    AddField(TEXT("z"));
+    if (bRange)
+    {
+        AddField(TEXT("range"));
+    }
+    if (bAzimuth)
+    {
+        AddField(TEXT("azimuth"));
+    }
+    if (bElevation)
+    {
+        AddField(TEXT("elevation"));
+    }
+    if (bIntensity)
+    {
+        AddField(TEXT("intensity"));
+    }
+    return Fields;
+}
+
+FPointCloud2Writer::FPointCloud2Writer(const FPointCloud2Layout& InLayout, int32 MaxPoints)
+    : Layout(InLayout)
+    , Fields(InLayout.GetFields())
+    , PointStep(InLayout.GetPointStep())
+{
+    check(MaxPoints >= 0);
+    for (FPointCloud2Buffer& Buffer : Buffers)
+    {
+        Buffer.PointStep = PointStep;
+        Buffer.Data.SetNumUninitialized(MaxPoints * static_cast<int32>(PointStep));
+    }
+}
+
+void FPointCloud2Writer::BeginCloud()
+{
+    std::lock_guard<std::mutex> Lock(Mutex);
+    check(WriteIndex < 0);
+    // Any buffer the publisher is not holding will do; prefer one that is not waiting to be published
+    for (int32 Index = 0; Index < 2 && WriteIndex < 0; ++Index)
+    {
+        if (Index != HeldIndex && Index != ReadyIndex)
+        {
+            WriteIndex = Index;
+        }
+    }
+    if (WriteIndex < 0)
+    {
+        WriteIndex = ReadyIndex;
+        ReadyIndex = -1;
+        ++NumDropped;
+    }
+
+    FPointCloud2Buffer& Buffer = Buffers[WriteIndex];
+    Buffer.Sequence = Sequence++;
+    Buffer.Width = 0;
+    Buffer.Height = 1;
+    Buffer.NumPoints = 0;
+    Buffer.bIsDense = true;
+}
+
+uint8* FPointCloud2Writer::Reserve(FPointCloud2Buffer& Buffer, int32 NumPoints)
+{
+    const int32 Bytes = (Buffer.NumPoints + NumPoints) * static_cast<int32>(PointStep);
+    if (Bytes > Buffer.Data.Num())
+    {
+        // Only reached when MaxPoints was too small; grow geometrically so it settles quickly
+        Buffer.Data.SetNumUninitialized(FMath::Max(Bytes, Buffer.Data.Num() * 2));
+    }
+    uint8* Dst = Buffer.Data.GetData() + Buffer.NumPoints * PointStep;
+    Buffer.NumPoints += NumPoints;
+    return Dst;
+}
+
+void FPointCloud2Writer::WritePoint(uint8* Dst, const FVector& ROSPoint, float Range, float Azimuth, float Elevation, float Intensity) const
+{
+    float Point[7];
+    int32 Num = 0;
+    Point[Num++] = static_cast<float>(ROSPoint.X);
+    Point[Num++] = static_cast<float>(ROSPoint.Y);
+    Point[Num++] = static_cast<float>(ROSPoint.Z);
+    if (Layout.bRange)
+    {
+        Point[Num++] = Range;
+    }
+    if (Layout.bAzimuth)
+    {
+        Point[Num++] = Azimuth;
+    }
+    if (Layout.bElevation)
+    {
+        Point[Num++] = Elevation;
+    }
+    if (Layout.bIntensity)
+    {
+        Point[Num++] = Intensity;
+    }
+    // The destination is only byte aligned when PointStep is not a multiple of 16
+    FMemory::Memcpy(Dst, Point, Num * sizeof(float));
+}
+
+void FPointCloud2Writer::AddPoint(const FVector& UEPoint, float Intensity)
+{
+    FVector Spherical = FVector::ZeroVector;
+    if (Layout.HasSpherical())
+    {
+        const double HorizontalSq = UEPoint.X * UEPoint.X + UEPoint.Y * UEPoint.Y;
+        Spherical = FVector(
+            FMath::Sqrt(HorizontalSq + UEPoint.Z * UEPoint.Z),
+            FMath::Atan2(UEPoint.Y, UEPoint.X),
+            FMath::Atan2(UEPoint.Z, FMath::Sqrt(HorizontalSq)));
+    }
+    AddPoint(UEPoint, Spherical, Intensity);
+}
+
+void FPointCloud2Writer::AddPoint(const FVector& UEPoint, const FVector& Spherical, float Intensity)
+{
+    check(WriteIndex >= 0);
+    FPointCloud2Buffer& Buffer = Buffers[WriteIndex];
+    // Mirroring Y also mirrors the azimuth; range only changes unit
+    WritePoint(Reserve(Buffer, 1), FVector(UEPoint.X * 0.01, UEPoint.Y * -0.01, UEPoint.Z * 0.01),
+        static_cast<float>(Spherical.X * 0.01), static_cast<float>(-Spherical.Y), static_cast<float>(Spherical.Z), Intensity);
+    Buffer.Width = static_cast<uint32>(Buffer.NumPoints);
+}
+
+void FPointCloud2Writer::AddDepthFrame(const FDepthRayLUT& LUT, TConstArrayView<float> Depth, TConstArrayView<float> Intensity, bool bOrganized)
+{
+    MATHTOOLKIT_SCOPE(Serialize);
+    check(WriteIndex >= 0);
+    const uint32 Width = LUT.GetWidth();
+    const uint32 Height = LUT.GetHeight();
+    const int32 NumPixels = static_cast<int32>(Width * Height);
+    check(Depth.Num() >= NumPixels);
+    check(Intensity.IsEmpty() || Intensity.Num() >= NumPixels);
+    MATHTOOLKIT_COUNT(PointsConverted, NumPixels);
+
+    FPointCloud2Buffer& Buffer = Buffers[WriteIndex];
+    Buffer.NumPoints = 0;
+    Buffer.bIsDense = true;
+    uint8* Dst = Reserve(Buffer, NumPixels);
+
+    const float NaN = std::numeric_limits<float>::quiet_NaN();
+    const float* RESTRICT D = Depth.GetData();
+    const float* RESTRICT ColumnSlope = LUT.GetColumnSlopes().GetData();
+    const float* RESTRICT ColumnAzimuth = LUT.GetColumnAzimuths().GetData();
+    const float* RESTRICT RangeScale = LUT.GetRangeScales().GetData();
+    const float* RESTRICT Elevation = LUT.GetElevations().GetData();
+    int32 NumWritten = 0;
+    for (uint32 y = 0; y < Height; ++y)
+    {
+        // ROS m straight from the LUT slopes: x = d, y = -d * column slope, z = d * row slope
+        const float RowSlope = LUT.GetRowSlopes()[y];
+        for (uint32 x = 0; x < Width; ++x)
+        {
+            const int32 i = static_cast<int32>(y * Width + x);
+            const float Value = D[i] * 0.01f;
+            const float PixelIntensity = Intensity.IsEmpty() ? 0.0f : Intensity[i];
+            if (D[i] > 0.0f)
+            {
+                WritePoint(Dst + NumWritten * PointStep, FVector(Value, -Value * ColumnSlope[x], Value * RowSlope),
+                    Value * RangeScale[i], -ColumnAzimuth[x], Elevation[i], PixelIntensity);
+                ++NumWritten;
+            }
+            else if (bOrganized)
+            {
+                WritePoint(Dst + NumWritten * PointStep, FVector(NaN, NaN, NaN), NaN, -ColumnAzimuth[x], Elevation[i], PixelIntensity);
+                Buffer.bIsDense = false;
+                ++NumWritten;
+            }
+        }
+    }
+
+    Buffer.NumPoints = NumWritten;
+    Buffer.Width = bOrganized ? Width : static_cast<uint32>(NumWritten);
+    Buffer.Height = bOrganized ? Height : 1;
+}
+
+int32 FPointCloud2Writer::GetNumPoints() const
+{
+    check(WriteIndex >= 0);
+    return Buffers[WriteIndex].NumPoints;
+}
+
+void FPointCloud2Writer::Commit()
+{
+    std::lock_guard<std::mutex> Lock(Mutex);
+    check(WriteIndex >= 0);
+    if (ReadyIndex >= 0)
+    {
+        ++NumDropped;
+    }
+    ReadyIndex = WriteIndex;
+    WriteIndex = -1;
+}
+
+const FPointCloud2Buffer* FPointCloud2Writer::Acquire()
+{
+    std::lock_guard<std::mutex> Lock(Mutex);
+    check(HeldIndex < 0);
+    if (ReadyIndex < 0)
+    {
+        return nullptr;
+    }
+    HeldIndex = ReadyIndex;
+    ReadyIndex = -1;
+    return &Buffers[HeldIndex];
+}
+
+void FPointCloud2Writer::Release()
+{
+    std::lock_guard<std::mutex> Lock(Mutex);
+    check(HeldIndex >= 0);
+    HeldIndex = -1;
+}
+
+uint64 FPointCloud2Writer::GetNumDropped() const
+{
+    std::lock_guard<std::mutex> Lock(Mutex);
+    return NumDropped;
+}
@@ -0,0 +1,294 @@
+#include "PoseHistory.h"
+#include "MathToolkitLibrary.h"
+
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+
+namespace
+{
+    /**
+     * Interpolation between two stored poses with everything that does not depend on the query time
+     * worked out once, so the queries of a batch that fall in the same segment only pay for the blend
+     * weights. Same arithmetic as the lerp and FQuat::Slerp in FPoseHistory::Sample.
+     */
+    struct FSegmentBlend
+    {
+        FSegmentBlend(const double* Times, const FVector* Positions, const FQuat* Rotations, int32 Segment)
+            : T0(Times[Segment]), T1(Times[Segment + 1]), InvDuration(1.0 / (T1 - T0)),
+              P0(Positions[Segment]), Step(Positions[Segment + 1] - Positions[Segment]),
+              Q0(Rotations[Segment]), Q1(Rotations[Segment + 1])
+        {
+            double Cos = Q0.X * Q1.X + Q0.Y * Q1.Y + Q0.Z * Q1.Z + Q0.W * Q1.W;
+            Sign = Cos < 0.0 ? -1.0 : 1.0;
+            Cos *= Sign;
+            bSlerp = Cos < 0.9999;
+            Omega = bSlerp ? std::acos(Cos) : 0.0;
+            InvSin = bSlerp ? Sign / std::sin(Omega) : 0.0;
+        }
+
+        bool Contains(double Timestamp) const { return T0 <= Timestamp && Timestamp < T1; }
+
+        void Evaluate(double Timestamp, FVector& OutPosition, FQuat& OutRotation) const
+        {
+            const double Alpha = (Timestamp - T0) * InvDuration;
+            OutPosition = P0 + Step * Alpha;
+
+            double S0 = 1.0 - Alpha, S1 = Alpha * Sign;
+            if (bSlerp)
+            {
+                S0 = std::sin(S0 * Omega) * InvSin * Sign;
+                S1 = std::sin(Alpha * Omega) * InvSin;
+            }
+            const FQuat Blend(S0 * Q0.X + S1 * Q1.X, S0 * Q0.Y + S1 * Q1.Y, S0 * Q0.Z + S1 * Q1.Z, S0 * Q0.W + S1 * Q1.W);
+            const double InvSize = 1.0 / FMath::Sqrt(Blend.X * Blend.X + Blend.Y * Blend.Y + Blend.Z * Blend.Z + Blend.W * Blend.W);
+            OutRotation = FQuat(Blend.X * InvSize, Blend.Y * InvSize, Blend.Z * InvSize, Blend.W * InvSize);
+        }
+
+        double T0, T1, InvDuration;
+        FVector P0, Step;
+        FQuat Q0, Q1;
+        double Sign, Omega, InvSin;
+        bool bSlerp;
+    };
+}
+
+FPoseHistory::FPoseHistory(const FSettings& InSettings)
+    : Settings(InSettings)
+{
+    check(Settings.Capacity >= 2);
+    check(Settings.FitWindow >= 2);
+    check(Settings.MaxExtrapolation >= 0.0);
+}
+
+int32 FPoseHistory::RegisterFrame(uint32 FrameId)
+{
+    std::unique_lock<std::shared_mutex> Lock(Mutex);
+    for (int32 Frame = 0; Frame < Tracks.Num(); ++Frame)
+    {
+        if (Tracks[Frame].FrameId == FrameId)
+        {
+            return Frame;
+        }
+    }
+
+    FTrack& Track = Tracks.AddDefaulted_GetRef();
+    Track.FrameId = FrameId;
+    Track.Timestamps.SetNumUninitialized(Settings.Capacity * 2);
+    Track.Positions.SetNumUninitialized(Settings.Capacity * 2);
+    Track.Rotations.SetNumUninitialized(Settings.Capacity * 2);
+    return Tracks.Num() - 1;
+}
+
+int32 FPoseHistory::FindFrame(uint32 FrameId) const
+{
+    std::shared_lock<std::shared_mutex> Lock(Mutex);
+    for (int32 Frame = 0; Frame < Tracks.Num(); ++Frame)
+    {
+        if (Tracks[Frame].FrameId == FrameId)
+        {
+            return Frame;
+        }
+    }
+    return INDEX_NONE;
+}
+
+bool FPoseHistory::AddPose(int32 Frame, double Timestamp, const FVector& Position, const FQuat& Rotation)
+{
+    std::unique_lock<std::shared_mutex> Lock(Mutex);
+    FTrack& Track = Tracks[Frame];
+    if (Track.Num > 0 && Timestamp <= Track.Timestamps[Track.Begin + Track.Num - 1])
+    {
+        return false;
+    }
+
+    if (Track.Num == Settings.Capacity)
+    {
+        ++Track.Begin;
+        --Track.Num;
+    }
+    if (Track.Begin + Track.Num == Track.Timestamps.Num())
+    {
+        // Once per Capacity poses, so the move is amortized to one pose per add
+        FMemory::Memmove(Track.Timestamps.GetData(), Track.Timestamps.GetData() + Track.Begin, Track.Num * sizeof(double));
+        FMemory::Memmove(Track.Positions.GetData(), Track.Positions.GetData() + Track.Begin, Track.Num * sizeof(FVector));
+        FMemory::Memmove(Track.Rotations.GetData(), Track.Rotations.GetData() + Track.Begin, Track.Num * sizeof(FQuat));
+        Track.Begin = 0;
+    }
+
+    const int32 Index = Track.Begin + Track.Num;
+    Track.Timestamps[Index] = Timestamp;
+    Track.Positions[Index] = Position;
+    Track.Rotations[Index] = Rotation.GetNormalized();
+    ++Track.Num;
+
+    UpdateExtrapolation(Track);
+    return true;
+}
+
+void FPoseHistory::UpdateExtrapolation(FTrack& Track) const
+{
+    const int32 Newest = Track.Begin + Track.Num - 1;
+    Track.Velocity = FVector::ZeroVector;
+    Track.AngularRate = 0.0;
+    if (Track.Num < 2)
+    {
+        return;
+    }
+
+    FFitMoments Moments;
+    Moments.Origin = Track.Timestamps[Newest];
+    for (int32 i = FMath::Max(Track.Begin, Newest + 1 - Settings.FitWindow); i <= Newest; ++i)
+    {
+        Moments.Add(Track.Timestamps[i], Track.Positions[i]);
+    }
+    FVector FitA, FitB;
+    if (Moments.SolveLinear(FitA, FitB))
+    {
+        Track.Velocity = FitA;
+    }
+
+    // Angular velocity of the last step, as a world-frame axis and rate
+    FQuat Delta = Track.Rotations[Newest] * Track.Rotations[Newest - 1].Inverse();
+    if (Delta.W < 0.0)
+    {
+        Delta = FQuat(-Delta.X, -Delta.Y, -Delta.Z, -Delta.W);
+    }
+    const double SinHalf = FMath::Sqrt(Delta.X * Delta.X + Delta.Y * Delta.Y + Delta.Z * Delta.Z);
+    if (SinHalf > UE_SMALL_NUMBER)
+    {
+        Track.AngularAxis = FVector(Delta.X, Delta.Y, Delta.Z) / SinHalf;
+        Track.AngularRate = 2.0 * FMath::Atan2(SinHalf, Delta.W) / (Track.Timestamps[Newest] - Track.Timestamps[Newest - 1]);
+    }
+}
+
+EPoseQueryResult FPoseHistory::Sample(const FTrack& Track, double Timestamp, int32& Segment, FVector& OutPosition, FQuat& OutRotation) const
+{
+    // NaN compares false against every stored time, so it would fall through to the segment search
+    if (Track.Num == 0 || !FMath::IsFinite(Timestamp))
+    {
+        OutPosition = FVector::ZeroVector;
+        OutRotation = FQuat::Identity;
+        return EPoseQueryResult::OutOfRange;
+    }
+
+    const double* Times = Track.Timestamps.GetData() + Track.Begin;
+    const FVector* Positions = Track.Positions.GetData() + Track.Begin;
+    const FQuat* Rotations = Track.Rotations.GetData() + Track.Begin;
+    const int32 Newest = Track.Num - 1;
+
+    if (Timestamp < Times[0])
+    {
+        OutPosition = Positions[0];
+        OutRotation = Rotations[0];
+        return EPoseQueryResult::OutOfRange;
+    }
+    if (Timestamp == Times[Newest])
+    {
+        OutPosition = Positions[Newest];
+        OutRotation = Rotations[Newest];
+        return EPoseQueryResult::Interpolated;
+    }
+    if (Timestamp > Times[Newest])
+    {
+        const double Ahead = Timestamp - Times[Newest];
+        const double Clamped = FMath::Min(Ahead, Settings.MaxExtrapolation);
+        // Anchored on the newest pose rather than the fit's intercept, so the path stays continuous there
+        OutPosition = Positions[Newest] + Track.Velocity * Clamped;
+        OutRotation = Track.AngularRate == 0.0 ? Rotations[Newest] : FQuat(Track.AngularAxis, Track.AngularRate * Clamped) * Rotations[Newest];
+        return Ahead <= Settings.MaxExtrapolation ? EPoseQueryResult::Extrapolated : EPoseQueryResult::OutOfRange;
+    }
+
+    // Times[Segment] <= Timestamp < Times[Segment + 1]; sorted batches almost always hit the cached segment or the next one
+    if (!(Segment >= 0 && Segment < Newest && Times[Segment] <= Timestamp && Timestamp < Times[Segment + 1]))
+    {
+        if (Segment >= 0 && Segment + 2 <= Newest && Times[Segment + 1] <= Timestamp && Timestamp < Times[Segment + 2])
+        {
+            ++Segment;
+        }
+        else
+        {
+            Segment = static_cast<int32>(std::upper_bound(Times, Times + Track.Num, Timestamp) - Times) - 1;
+        }
+    }
+
+    const double Alpha = (Timestamp - Times[Segment]) / (Times[Segment + 1] - Times[Segment]);
+    OutPosition = Positions[Segment] + (Positions[Segment + 1] - Positions[Segment]) * Alpha;
+    OutRotation = FQuat::Slerp(Rotations[Segment], Rotations[Segment + 1], Alpha);
+    return EPoseQueryResult::Interpolated;
+}
+
+EPoseQueryResult FPoseHistory::GetPose(int32 Frame, double Timestamp, FVector& OutPosition, FQuat& OutRotation) const
+{
+    std::shared_lock<std::shared_mutex> Lock(Mutex);
+    int32 Segment = INDEX_NONE;
+    return Sample(Tracks[Frame], Timestamp, Segment, OutPosition, OutRotation);
+}
+
+int32 FPoseHistory::GetPoses(int32 Frame, TConstArrayView<double> Timestamps, TArrayView<FVector> OutPositions, TArrayView<FQuat> OutRotations,
+    TArrayView<EPoseQueryResult> OutResults) const
+{
+    check(OutPositions.Num() == Timestamps.Num() && OutRotations.Num() == Timestamps.Num());
+    check(OutResults.IsEmpty() || OutResults.Num() == Timestamps.Num());
+
+    std::shared_lock<std::shared_mutex> Lock(Mutex);
+    const FTrack& Track = Tracks[Frame];
+    const double* Times = Track.Timestamps.GetData() + Track.Begin;
+    const double* Queries = Timestamps.GetData();
+    FVector* Positions = OutPositions.GetData();
+    FQuat* Rotations = OutRotations.GetData();
+    EPoseQueryResult* Results = OutResults.IsEmpty() ? nullptr : OutResults.GetData();
+    const int32 NumQueries = Timestamps.Num();
+
+    int32 Segment = INDEX_NONE;
+    int32 NumInRange = 0;
+    for (int32 i = 0; i < NumQueries;)
+    {
+        const double Timestamp = Queries[i];
+        const EPoseQueryResult Result = Sample(Track, Timestamp, Segment, Positions[i], Rotations[i]);
+        NumInRange += Result != EPoseQueryResult::OutOfRange;
+        if (Results)
+        {
+            Results[i] = Result;
+        }
+        ++i;
+
+        // Sorted batches put many queries in one segment (tens per pose for lidar columns); blend those
+        // without going back through the range checks and the per-segment slerp setup
+        if (Result != EPoseQueryResult::Interpolated || i == NumQueries || Segment < 0 || Segment >= Track.Num - 1
+            || !(Times[Segment] <= Timestamp && Timestamp < Times[Segment + 1]) || !(Queries[i] < Times[Segment + 1]))
+        {
+            continue;
+        }
+        const FSegmentBlend Blend(Times, Track.Positions.GetData() + Track.Begin, Track.Rotations.GetData() + Track.Begin, Segment);
+        for (; i < NumQueries && Blend.Contains(Queries[i]); ++i)
+        {
+            Blend.Evaluate(Queries[i], Positions[i], Rotations[i]);
+            ++NumInRange;
+            if (Results)
+            {
+                Results[i] = EPoseQueryResult::Interpolated;
+            }
+        }
+    }
+    return NumInRange;
+}
+
+int32 FPoseHistory::GetNumPoses(int32 Frame) const
+{
+    std::shared_lock<std::shared_mutex> Lock(Mutex);
+    return Tracks[Frame].Num;
+}
+
+bool FPoseHistory::GetTimeRange(int32 Frame, double& OutOldest, double& OutNewest) const
+{
+    std::shared_lock<std::shared_mutex> Lock(Mutex);
+    const FTrack& Track = Tracks[Frame];
+    if (Track.Num == 0)
+    {
+        return false;
+    }
+    OutOldest = Track.Timestamps[Track.Begin];
+    OutNewest = Track.Timestamps[Track.Begin + Track.Num - 1];
+    return true;
+}
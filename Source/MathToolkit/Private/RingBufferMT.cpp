@@ -0,0 +1,39 @@
+#include "RingBufferMT.h"
+
+FRingBufferArena::FRingBufferArena(size_t SlabBytes)
+    : Slab(static_cast<uint8*>(FMemory::Malloc(SlabBytes, PLATFORM_CACHE_LINE_SIZE)))
+    , Capacity(SlabBytes)
+    , Used(0)
+    , LiveAllocations(0)
+{
+}
+
+FRingBufferArena::~FRingBufferArena()
+{
+    check(LiveAllocations == 0);
+    FMemory::Free(Slab);
+}
+
+void* FRingBufferArena::Allocate(size_t Bytes, size_t Alignment)
+{
+    const size_t Offset = (Used + Alignment - 1) & ~(Alignment - 1);
+    checkf(Offset + Bytes <= Capacity, TEXT("FRingBufferArena exhausted: %llu of %llu bytes requested"),
+        static_cast<unsigned long long>(Offset + Bytes), static_cast<unsigned long long>(Capacity));
+
+    Used = Offset + Bytes;
+    ++LiveAllocations;
+    return Slab + Offset;
+}
+
+void FRingBufferArena::Free(void* Ptr, size_t Bytes)
+{
+    check(Ptr >= Slab && static_cast<uint8*>(Ptr) + Bytes <= Slab + Capacity);
+    check(LiveAllocations > 0);
+    --LiveAllocations;
+}
+
+void FRingBufferArena::Reset()
+{
+    check(LiveAllocations == 0);
+    Used = 0;
+}
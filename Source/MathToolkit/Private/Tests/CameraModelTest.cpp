@@ -0,0 +1,186 @@
+#include "Misc/AutomationTest.h"
+#include "MathToolkitLibrary.h"
+#include "CameraModels.h"
+
+namespace
+{
+    struct FTestPinholeIntrinsics
+    {
+        static constexpr double FOVH = 75.0;
+        static constexpr uint32 Width = 64;
+        static constexpr uint32 Height = 48;
+    };
+    typedef TPinholeCameraModel<FTestPinholeIntrinsics> FTestPinhole;
+
+    struct FTestPanoramaIntrinsics
+    {
+        static constexpr double FOVH = 360.0;
+        static constexpr uint32 Width = 128;
+        static constexpr uint32 Height = 32;
+    };
+    typedef TEquirectangularCameraModel<FTestPanoramaIntrinsics> FTestPanorama;
+
+    // The derived intrinsics must be usable in constant expressions
+    static_assert(MathToolkitConstexpr::Abs(MathToolkitConstexpr::Tan(MathToolkitConstexpr::Pi / 4.0) - 1.0) < 1e-12, "constexpr Tan");
+    static_assert(MathToolkitConstexpr::Abs(MathToolkitConstexpr::HorizontalFOV(36.0, 18.0) - 90.0) < 1e-9, "constexpr HorizontalFOV");
+    static_assert(FTestPinhole::TanHalfFOVH > 0.76 && FTestPinhole::TanHalfFOVH < 0.77, "Pinhole intrinsics fold at compile time");
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCameraModelConstexprMathTest, "MathToolkit.CameraModel.ConstexprMath",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FCameraModelConstexprMathTest::RunTest(const FString& Parameters)
+{
+    double MaxError = 0.0;
+    for (int32 i = -400; i <= 400; ++i)
+    {
+        const double X = i * 0.0173;
+        MaxError = FMath::Max(MaxError, FMath::Abs(MathToolkitConstexpr::Sin(X) - std::sin(X)));
+        MaxError = FMath::Max(MaxError, FMath::Abs(MathToolkitConstexpr::Cos(X) - std::cos(X)));
+        MaxError = FMath::Max(MaxError, FMath::Abs(MathToolkitConstexpr::Atan(X * 10.0) - std::atan(X * 10.0)));
+        MaxError = FMath::Max(MaxError, FMath::Abs(MathToolkitConstexpr::Sqrt(FMath::Abs(X)) - std::sqrt(FMath::Abs(X))));
+        if (FMath::Abs(X) < 1.5)
+        {
+            MaxError = FMath::Max(MaxError, FMath::Abs(MathToolkitConstexpr::Tan(X) - std::tan(X)) / (1.0 + FMath::Abs(std::tan(X))));
+        }
+    }
+    AddInfo(FString::Printf(TEXT("constexpr math max error: %g"), MaxError));
+    TestTrue(TEXT("constexpr Sin/Cos/Tan/Atan/Sqrt should match the runtime functions"), MaxError < 1e-12);
+
+    TestTrue(TEXT("constexpr HorizontalFOV should match calculateHorizontalFOV"),
+        FMath::IsNearlyEqual(static_cast<float>(MathToolkitConstexpr::HorizontalFOV(23.5, 16.0)), MathToolkitLibrary::calculateHorizontalFOV(23.5f, 16.0f), 1e-4f));
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCameraModelPinholeTest, "MathToolkit.CameraModel.Pinhole",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FCameraModelPinholeTest::RunTest(const FString& Parameters)
+{
+    const uint32 width = FTestPinhole::Width;
+    const uint32 height = FTestPinhole::Height;
+    const float FOVH = static_cast<float>(FTestPinholeIntrinsics::FOVH);
+    const int32 NumPixels = width * height;
+
+    TArray<float> Depth;
+    Depth.SetNumUninitialized(NumPixels);
+    for (int32 i = 0; i < NumPixels; ++i)
+    {
+        Depth[i] = 100.0f + (i % 37) * 25.0f;
+    }
+
+    TArray<float> X, Y, Z, Range, ExpectedX, ExpectedY, ExpectedZ, ExpectedRange;
+    for (TArray<float>* Channel : { &X, &Y, &Z, &Range, &ExpectedX, &ExpectedY, &ExpectedZ, &ExpectedRange })
+    {
+        Channel->SetNumUninitialized(NumPixels);
+    }
+    FDepthPointCloudSoA Folded;
+    Folded.X = X;
+    Folded.Y = Y;
+    Folded.Z = Z;
+    Folded.Range = Range;
+    TCameraModelKernels<FTestPinhole>::ConvertDepth(Depth, Folded);
+
+    FDepthPointCloudSoA Expected;
+    Expected.X = ExpectedX;
+    Expected.Y = ExpectedY;
+    Expected.Z = ExpectedZ;
+    Expected.Range = ExpectedRange;
+    MathToolkitLibrary::CalculatePointCloudFromDepth(Depth, FOVH, width, height, Expected);
+
+    int32 Mismatches = 0;
+    for (uint32 y = 0; y < height; ++y)
+    {
+        for (uint32 x = 0; x < width; ++x)
+        {
+            const int32 i = y * width + x;
+            const std::pair<FVector, FVector> Runtime = MathToolkitLibrary::CalculateSphericalFromDepth(Depth[i], x, y, FOVH, width, height);
+            const std::pair<FVector, FVector> Specialized = TCameraModelKernels<FTestPinhole>::SphericalFromDepth(Depth[i], x, y);
+            const std::pair<float, float> Pixel = TCameraModelKernels<FTestPinhole>::PixelFromAngles(Runtime.first.Y, Runtime.first.Z);
+
+            const bool bMatches =
+                Specialized.first.Equals(Runtime.first, 0.05) && Specialized.second.Equals(Runtime.second, 0.05) &&
+                FMath::IsNearlyEqual(X[i], ExpectedX[i], 0.05f) &&
+                FMath::IsNearlyEqual(Y[i], ExpectedY[i], 0.05f) &&
+                FMath::IsNearlyEqual(Z[i], ExpectedZ[i], 0.05f) &&
+                FMath::IsNearlyEqual(Range[i], ExpectedRange[i], 0.05f) &&
+                FMath::IsNearlyEqual(Pixel.first, static_cast<float>(x), 1e-2f) &&
+                FMath::IsNearlyEqual(Pixel.second, static_cast<float>(y), 1e-2f);
+            Mismatches += bMatches ? 0 : 1;
+        }
+    }
+    TestEqual(TEXT("Compile-time pinhole model should match the runtime conversions"), Mismatches, 0);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCameraModelEquirectangularTest, "MathToolkit.CameraModel.Equirectangular",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FCameraModelEquirectangularTest::RunTest(const FString& Parameters)
+{
+    // Every pixel's point must lie at the stored range and project back onto the same pixel
+    int32 Mismatches = 0;
+    for (uint32 y = 0; y < FTestPanorama::Height; ++y)
+    {
+        for (uint32 x = 0; x < FTestPanorama::Width; ++x)
+        {
+            const float Depth = 250.0f + x + y;
+            const std::pair<FVector, FVector> Result = TCameraModelKernels<FTestPanorama>::SphericalFromDepth(Depth, x, y);
+            float u, v;
+            FTestPanorama::PointToPixel(Result.second.X, Result.second.Y, Result.second.Z, u, v);
+
+            // Column 0 sits on the +-180 degree seam and may come back as column Width
+            const float WrappedU = FMath::Fmod(u + 0.5f, static_cast<float>(FTestPanorama::Width)) - 0.5f;
+            const bool bMatches =
+                FMath::IsNearlyEqual(Result.first.X, Depth, 1e-2) &&
+                FMath::IsNearlyEqual(WrappedU, static_cast<float>(x), 1e-2f) &&
+                FMath::IsNearlyEqual(v, static_cast<float>(y), 1e-2f);
+            Mismatches += bMatches ? 0 : 1;
+        }
+    }
+    TestEqual(TEXT("Equirectangular pixels should round trip through their points"), Mismatches, 0);
+
+    // Whole-frame conversion against the per-pixel kernel, with every channel and with a subset
+    const int32 NumPixels = FTestPanorama::Width * FTestPanorama::Height;
+    TArray<float> Depth, X, Y, Z, Range, OnlyY, OnlyRange;
+    for (int32 i = 0; i < NumPixels; ++i)
+    {
+        Depth.Add(250.0f + (i % 41) * 30.0f);
+    }
+    for (TArray<float>* Channel : { &X, &Y, &Z, &Range, &OnlyY, &OnlyRange })
+    {
+        Channel->SetNumUninitialized(NumPixels);
+    }
+    FDepthPointCloudSoA Full;
+    Full.X = X;
+    Full.Y = Y;
+    Full.Z = Z;
+    Full.Range = Range;
+    TCameraModelKernels<FTestPanorama>::ConvertDepth(Depth, Full);
+    FDepthPointCloudSoA Partial;
+    Partial.Y = OnlyY;
+    Partial.Range = OnlyRange;
+    TCameraModelKernels<FTestPanorama>::ConvertDepth(Depth, Partial);
+
+    int32 FrameMismatches = 0;
+    for (uint32 y = 0; y < FTestPanorama::Height; ++y)
+    {
+        for (uint32 x = 0; x < FTestPanorama::Width; ++x)
+        {
+            const int32 i = y * FTestPanorama::Width + x;
+            const std::pair<FVector, FVector> Expected = TCameraModelKernels<FTestPanorama>::SphericalFromDepth(Depth[i], x, y);
+            const bool bMatches =
+                FMath::IsNearlyEqual(X[i], Expected.second.X, 1e-3) &&
+                FMath::IsNearlyEqual(Y[i], Expected.second.Y, 1e-3) &&
+                FMath::IsNearlyEqual(Z[i], Expected.second.Z, 1e-3) &&
+                FMath::IsNearlyEqual(Range[i], Expected.first.X, 1e-2) &&
+                OnlyY[i] == Y[i] && OnlyRange[i] == Range[i];
+            FrameMismatches += bMatches ? 0 : 1;
+        }
+    }
+    TestEqual(TEXT("Equirectangular ConvertDepth should match SphericalFromDepth"), FrameMismatches, 0);
+
+    return true;
+}
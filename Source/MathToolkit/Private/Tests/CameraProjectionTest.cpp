@@ -0,0 +1,157 @@
+#include "Misc/AutomationTest.h"
+#include "MathToolkitLibrary.h"
+#include "CameraProjection.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCameraProjectionRoundTripTest, "MathToolkit.CameraProjection.RoundTrip",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FCameraProjectionRoundTripTest::RunTest(const FString& Parameters)
+{
+    const uint32 width = 64;
+    const uint32 height = 48;
+    const float FOVH = 90.0f;
+    const int32 NumPixels = width * height;
+
+    TArray<float> Depth;
+    Depth.SetNumUninitialized(NumPixels);
+    for (int32 i = 0; i < NumPixels; ++i)
+    {
+        Depth[i] = 100.0f + (i % 37) * 25.0f;
+    }
+
+    TArray<float> X, Y, Z, Range, Azimuth, Elevation;
+    X.SetNumUninitialized(NumPixels);
+    Y.SetNumUninitialized(NumPixels);
+    Z.SetNumUninitialized(NumPixels);
+    Range.SetNumUninitialized(NumPixels);
+    Azimuth.SetNumUninitialized(NumPixels);
+    Elevation.SetNumUninitialized(NumPixels);
+    FDepthPointCloudSoA Out{X, Y, Z, Range, Azimuth, Elevation};
+    MathToolkitLibrary::CalculatePointCloudFromDepth(Depth, FOVH, width, height, Out);
+
+    // Projecting the depth point cloud must land every point back on the pixel it came from
+    TArray<float> U, V;
+    TArray<uint8> Visible;
+    U.SetNumUninitialized(NumPixels);
+    V.SetNumUninitialized(NumPixels);
+    Visible.SetNumUninitialized(NumPixels);
+
+    const FCameraProjection Camera(FOVH, width, height);
+    const int32 NumVisible = Camera.Project(X, Y, Z, U, V, Visible);
+    TestEqual(TEXT("Every depth pixel should be visible"), NumVisible, NumPixels);
+
+    int32 Mismatches = 0;
+    int32 NDCMismatches = 0;
+    for (uint32 y = 0; y < height; ++y)
+    {
+        for (uint32 x = 0; x < width; ++x)
+        {
+            const int32 i = y * width + x;
+            Mismatches += (FMath::IsNearlyEqual(U[i], static_cast<float>(x), 1e-3f) && FMath::IsNearlyEqual(V[i], static_cast<float>(y), 1e-3f)) ? 0 : 1;
+
+            const std::pair<float, float> NDC = MathToolkitLibrary::CalculateNDCCoordinates(Azimuth[i], Elevation[i], FOVH, width, height);
+            NDCMismatches += (FMath::IsNearlyEqual(NDC.first, static_cast<float>(x), 1e-2f) && FMath::IsNearlyEqual(NDC.second, static_cast<float>(y), 1e-2f)) ? 0 : 1;
+        }
+    }
+    TestEqual(TEXT("Projection should invert the depth conversion"), Mismatches, 0);
+    TestEqual(TEXT("CalculateNDCCoordinates should invert the depth conversion angles"), NDCMismatches, 0);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCameraProjectionFrustumTest, "MathToolkit.CameraProjection.Frustum",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FCameraProjectionFrustumTest::RunTest(const FString& Parameters)
+{
+    const FCameraProjection Camera(90.0f, 640, 480, 10.0f);
+
+    // Enough points to exercise both the vector loop and the scalar tail
+    TArray<FVector> Points;
+    TArray<uint8> Expected;
+    for (int32 i = 0; i < 5; ++i)
+    {
+        Points.Add(FVector(500.0, -100.0 + 50.0 * i, 20.0)); Expected.Add(1);   // in view
+        Points.Add(FVector(-500.0, 10.0 * i, 0.0)); Expected.Add(0);            // behind the camera
+        Points.Add(FVector(5.0, 0.0, 0.0)); Expected.Add(0);                    // in front of the near plane
+        Points.Add(FVector(100.0, 150.0 + i, 0.0)); Expected.Add(0);            // right of the frustum
+        Points.Add(FVector(100.0, 0.0, -90.0 - i)); Expected.Add(0);            // below the frustum
+    }
+    Points.Add(FVector(NAN, 0.0, 0.0)); Expected.Add(0);
+
+    TArray<float> U, V;
+    TArray<uint8> Visible;
+    U.SetNumUninitialized(Points.Num());
+    V.SetNumUninitialized(Points.Num());
+    Visible.SetNumUninitialized(Points.Num());
+
+    const int32 NumVisible = Camera.Project(Points, U, V, Visible);
+    TestEqual(TEXT("Only the in-view points should count as visible"), NumVisible, 5);
+
+    int32 Mismatches = 0;
+    for (int32 i = 0; i < Points.Num(); ++i)
+    {
+        Mismatches += Visible[i] == Expected[i] ? 0 : 1;
+        if (!Visible[i])
+        {
+            Mismatches += (U[i] == -1.0f && V[i] == -1.0f) ? 0 : 1;
+        }
+    }
+    TestEqual(TEXT("Visibility mask and invalid pixel markers"), Mismatches, 0);
+
+    float PointU, PointV;
+    TestTrue(TEXT("Optical axis should be visible"), Camera.ProjectPoint(FVector(300.0, 0.0, 0.0), PointU, PointV));
+    TestTrue(TEXT("Optical axis should hit the image center"), FMath::IsNearlyEqual(PointU, 320.0f, 1e-3f) && FMath::IsNearlyEqual(PointV, 240.0f, 1e-3f));
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCameraProjectionPoseTest, "MathToolkit.CameraProjection.Pose",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FCameraProjectionPoseTest::RunTest(const FString& Parameters)
+{
+    const FTransform CameraToWorld(FRotator(-10.0, 35.0, 5.0).Quaternion(), FVector(120000.0, -45000.0, 800.0));
+    const FCameraProjection WorldCamera(CameraToWorld, 70.0f, 320, 240);
+    const FCameraProjection LocalCamera(70.0f, 320, 240);
+
+    TArray<FVector> World, Local;
+    TArray<float> WX, WY, WZ;
+    for (int32 i = 0; i < 37; ++i)
+    {
+        const FVector CameraSpace(200.0 + 40.0 * i, -60.0 + 3.0 * i, 25.0 - 2.0 * i);
+        Local.Add(CameraSpace);
+        World.Add(CameraToWorld.TransformPosition(CameraSpace));
+        WX.Add(static_cast<float>(World.Last().X));
+        WY.Add(static_cast<float>(World.Last().Y));
+        WZ.Add(static_cast<float>(World.Last().Z));
+    }
+
+    const int32 Count = World.Num();
+    TArray<float> U, V, ExpectedU, ExpectedV, FloatU, FloatV;
+    TArray<uint8> Visible, ExpectedVisible, FloatVisible;
+    for (TArray<float>* Array : { &U, &V, &ExpectedU, &ExpectedV, &FloatU, &FloatV })
+    {
+        Array->SetNumUninitialized(Count);
+    }
+    Visible.SetNumUninitialized(Count);
+    ExpectedVisible.SetNumUninitialized(Count);
+    FloatVisible.SetNumUninitialized(Count);
+
+    WorldCamera.Project(World, U, V, Visible);
+    LocalCamera.Project(Local, ExpectedU, ExpectedV, ExpectedVisible);
+    WorldCamera.Project(WX, WY, WZ, FloatU, FloatV, FloatVisible);
+
+    int32 Mismatches = 0;
+    int32 FloatMismatches = 0;
+    for (int32 i = 0; i < Count; ++i)
+    {
+        Mismatches += (Visible[i] == ExpectedVisible[i] && FMath::IsNearlyEqual(U[i], ExpectedU[i], 1e-3f) && FMath::IsNearlyEqual(V[i], ExpectedV[i], 1e-3f)) ? 0 : 1;
+        // Float world coordinates around 1 km from the origin only resolve to a few millimetres
+        FloatMismatches += (FloatVisible[i] == ExpectedVisible[i] && FMath::IsNearlyEqual(FloatU[i], ExpectedU[i], 0.05f) && FMath::IsNearlyEqual(FloatV[i], ExpectedV[i], 0.05f)) ? 0 : 1;
+    }
+    TestEqual(TEXT("World-space FVector projection should match camera-space projection"), Mismatches, 0);
+    TestEqual(TEXT("World-space float projection should match camera-space projection"), FloatMismatches, 0);
+
+    return true;
+}
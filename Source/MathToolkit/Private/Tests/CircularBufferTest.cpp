@@ -199,3 +199,141 @@ bool FCircularBufferStressTest::RunTest(const FString& Parameters)
 
     return true;
 }
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCircularBufferFrontBackTest, "MathToolkit.CircularBuffer.FrontBack",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FCircularBufferFrontBackTest::RunTest(const FString& Parameters)
+{
+    CircularBufferMT<int32, 3> buffer;
+
+    buffer.put(1);
+    TestEqual(TEXT("Single element should be both front and back"), buffer.front(), 1);
+    TestEqual(TEXT("Single element should be both front and back"), buffer.back(), 1);
+
+    for(int32 i = 2; i <= 5; ++i) {
+        buffer.put(i);
+        TestEqual(FString::Printf(TEXT("Back should be %d"), i), buffer.back(), i);
+    }
+    TestEqual(TEXT("Front should be the oldest element after wrapping"), buffer.front(), 3);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCircularBufferBulkTest, "MathToolkit.CircularBuffer.Bulk",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FCircularBufferBulkTest::RunTest(const FString& Parameters)
+{
+    // Power-of-two (masked) and generic (modulo) capacities must behave the same
+    CircularBufferMT<int32, 8> masked;
+    CircularBufferMT<int32, 5> generic;
+
+    TArray<int32> input;
+    for(int32 i = 1; i <= 20; ++i) {
+        input.Add(i);
+    }
+
+    // Mix of single puts and bulk puts that wrap around the end of the storage
+    int32 next = 0;
+    for(int32 chunk : {3, 1, 4, 0, 6, 2, 4}) {
+        masked.put_n(MakeArrayView(input.GetData() + next, chunk));
+        for(int32 i = 0; i < chunk; ++i) {
+            generic.put(input[next + i]);
+        }
+        next += chunk;
+
+        TArray<int32> from_segments;
+        const auto segments = masked.contiguous_segments();
+        for (int32 value : segments.first) { from_segments.Add(value); }
+        for (int32 value : segments.second) { from_segments.Add(value); }
+
+        TestEqual(TEXT("Segments should cover the whole contents"), from_segments.Num(), static_cast<int32>(masked.size()));
+        for(int32 i = 0; i < from_segments.Num(); ++i) {
+            TestEqual(FString::Printf(TEXT("Element %d after %d inserts"), i, next), from_segments[i], next - from_segments.Num() + 1 + i);
+        }
+        TestEqual(TEXT("Front should match the first segment"), masked.front(), from_segments[0]);
+        TestEqual(TEXT("Back should be the last inserted element"), masked.back(), next);
+    }
+
+    TestTrue(TEXT("Masked buffer should be full"), masked.full());
+    TestEqual(TEXT("Generic buffer should hold its capacity"), static_cast<int32>(generic.size()), 5);
+    TestEqual(TEXT("Generic buffer front"), generic.front(), 16);
+    TestEqual(TEXT("Masked head should be a physical slot index"), static_cast<int32>(masked.get_head()), 20 % 8);
+
+    // More items than capacity keeps only the newest ones
+    generic.put_n(input);
+    TArray<int32> values;
+    generic.for_each([&values](int32 val) { values.Add(val); });
+    TestEqual(TEXT("Oversized put_n should keep capacity elements"), values.Num(), 5);
+    TestEqual(TEXT("Oversized put_n should keep the newest elements"), values[0], 16);
+    TestEqual(TEXT("Oversized put_n should keep the newest elements"), values[4], 20);
+
+    return true;
+}
+
+namespace
+{
+    // No default constructor; counts live instances so leaks and double destruction show up
+    struct FTrackedPayload
+    {
+        static int32 LiveCount;
+
+        explicit FTrackedPayload(int32 InId) : Id(InId) { ++LiveCount; }
+        FTrackedPayload(const FTrackedPayload& Other) : Id(Other.Id), Samples(Other.Samples) { ++LiveCount; }
+        FTrackedPayload(FTrackedPayload&& Other) : Id(Other.Id), Samples(MoveTemp(Other.Samples)) { ++LiveCount; }
+        ~FTrackedPayload() { --LiveCount; }
+
+        int32 Id;
+        TArray<float> Samples;
+    };
+    int32 FTrackedPayload::LiveCount = 0;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCircularBufferLifetimeTest, "MathToolkit.CircularBuffer.Lifetime",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FCircularBufferLifetimeTest::RunTest(const FString& Parameters)
+{
+    {
+        CircularBufferMT<FTrackedPayload, 3> buffer;
+        TestEqual(TEXT("Empty buffer should construct no elements"), FTrackedPayload::LiveCount, 0);
+
+        for(int32 i = 0; i < 5; ++i) {
+            FTrackedPayload& payload = buffer.emplace(i);
+            payload.Samples.SetNumZeroed(1024);
+        }
+        TestEqual(TEXT("Evicted elements should be destroyed"), FTrackedPayload::LiveCount, 3);
+        TestEqual(TEXT("Oldest live element"), buffer.front().Id, 2);
+
+        // A moved-in payload keeps its allocation
+        FTrackedPayload scan(10);
+        scan.Samples.SetNumZeroed(2048);
+        const float* allocation = scan.Samples.GetData();
+        buffer.put(MoveTemp(scan));
+        TestTrue(TEXT("put(T&&) should move the payload without copying it"), buffer.back().Samples.GetData() == allocation);
+
+        CircularBufferMT<FTrackedPayload, 3> copy(buffer);
+        TestEqual(TEXT("Copy should construct its own elements"), FTrackedPayload::LiveCount, 7);
+
+        CircularBufferMT<FTrackedPayload, 3> moved(MoveTemp(copy));
+        TestTrue(TEXT("Moved-from buffer should be empty"), copy.empty());
+        TestEqual(TEXT("Moved buffer should keep the order"), moved.front().Id, 3);
+        TestEqual(TEXT("Moved buffer should keep the order"), moved.back().Id, 10);
+
+        buffer.pop_front();
+        TestEqual(TEXT("pop_front should destroy the oldest element"), buffer.front().Id, 4);
+
+        // Re-inserting the element that a full buffer is about to evict
+        buffer.emplace(11);
+        TestTrue(TEXT("Buffer should be full"), buffer.full());
+        buffer.put(buffer.front());
+        TestEqual(TEXT("put(front()) should copy the evicted element"), buffer.back().Id, 4);
+        TestEqual(TEXT("put(front()) should copy the evicted payload"), buffer.back().Samples.Num(), 1024);
+        TestEqual(TEXT("Oldest live element after put(front())"), buffer.front().Id, 10);
+        TestEqual(TEXT("put(front()) should not leak or double destroy"), FTrackedPayload::LiveCount, 7);
+    }
+    TestEqual(TEXT("Destroying the buffers should destroy every live element"), FTrackedPayload::LiveCount, 0);
+
+    return true;
+}
@@ -0,0 +1,11 @@
+// Golden outputs of MathToolkitLibrary::CalculateSphericalFromDepth, recorded from the scalar library
+// path: { Depth, x, y, FOVH, width, height, { X, Y, Z, range, azimuth, elevation } }. Re-record only
+// for an intended convention change, never to make a kernel pass.
+{ 350.0f, 0.0f, 0.0f, 90.0f, 640, 480, { 350, -350, 262.5, 560.27337646484375, -0.78539818525314331, 0.48761621117591858 } },
+{ 350.0f, 320.0f, 240.0f, 90.0f, 640, 480, { 350, 0, 0, 350, 0, 0 } },
+{ 1234.5f, 639.0f, 479.0f, 90.0f, 640, 480, { 1234.5, 1230.6422119140625, -922.01715087890625, 1971.9498291015625, 0.78383326530456543, -0.48653554916381836 } },
+{ 0.5f, 17.25f, 3.75f, 60.0f, 64, 48, { 0.5, -0.13306120038032532, 0.18267723917961121, 0.54870414733886719, -0.26009419560432434, 0.33940362930297852 } },
+{ 2500.0f, 100.5f, 20.0f, 120.0f, 320, 240, { 2500, -1610.26611328125, 2706.329345703125, 4020.8427734375, -0.57222098112106323, 0.73835903406143188 } },
+{ 80000.0f, 1919.0f, 0.0f, 110.0f, 1920, 1080, { 80000, 114132.8203125, 64266.65625, 153481.28125, 0.95944130420684814, 0.43204233050346375 } },
+{ 42.0f, 86.0f, 48.0f, 75.0f, 173, 97, { 42, -0.18628722429275513, 0.18628747761249542, 42.000823974609375, -0.0044353813864290714, 0.0044353436678647995 } },
+{ 999.0f, 5.0f, 95.0f, 30.0f, 173, 97, { 999, -252.20834350585938, -143.89801025390625, 1040.344482421875, -0.24729336798191071, -0.13876253366470337 } },
@@ -0,0 +1,564 @@
+#include "Misc/AutomationTest.h"
+#include "MathToolkitLibrary.h"
+#include "MathToolkitKernels.h"
+#include "CameraProjection.h"
+#include "DepthFramePipeline.h"
+#include "DepthRayLUT.h"
+#include "FrameConversion.h"
+#include "HAL/PlatformTime.h"
+
+#include <cfloat>
+
+// Accuracy and throughput regression suite for the conversion kernels. Every kernel is compared
+// against a double-precision reference and reports its max error in float ulps next to its
+// throughput; the budgets below are what a SIMD or approximate-math change has to stay within.
+
+namespace
+{
+    /** Max error of one output channel against a double reference, in absolute units and in ulps. */
+    struct FErrorReport
+    {
+        const TCHAR* Name;
+        /** Ulps are taken relative to max(|reference|, Magnitude), so outputs near zero do not blow up. */
+        double Magnitude;
+        /** Relative size of one ulp: FLT_EPSILON for float outputs, DBL_EPSILON for double ones. */
+        double Epsilon;
+        /** Quantized outputs with a fixed step count errors in steps instead of ulps. */
+        double Step = 0.0;
+        double MaxAbs = 0.0;
+        double MaxUlps = 0.0;
+        int32 Num = 0;
+
+        FErrorReport(const TCHAR* InName, double InMagnitude, double InEpsilon = FLT_EPSILON) : Name(InName), Magnitude(InMagnitude), Epsilon(InEpsilon) {}
+
+        static FErrorReport Quantized(const TCHAR* InName, double InStep)
+        {
+            FErrorReport Report(InName, 0.0);
+            Report.Step = InStep;
+            return Report;
+        }
+
+        void Add(double Value, double Reference, double PointMagnitude = 0.0)
+        {
+            const double Error = FMath::Abs(Value - Reference);
+            const double Scale = FMath::Max(FMath::Max(FMath::Abs(Reference), PointMagnitude), Magnitude);
+            MaxAbs = FMath::Max(MaxAbs, Error);
+            MaxUlps = FMath::Max(MaxUlps, Step > 0.0 ? Error / Step : Error / (Scale * Epsilon));
+            ++Num;
+        }
+    };
+
+    /** Logs the report with the kernel's throughput and fails the test when it exceeds UlpBudget. */
+    void CheckReport(FAutomationTestBase& Test, const FString& Kernel, const FErrorReport& Report, double UlpBudget, double NsPerItem = 0.0)
+    {
+        const FString Throughput = NsPerItem > 0.0 ? FString::Printf(TEXT(", %.2f ns/item"), NsPerItem) : FString();
+        const TCHAR* Unit = Report.Step > 0.0 ? TEXT("steps") : TEXT("ulp");
+        Test.AddInfo(FString::Printf(TEXT("%s %s: max error %.3g (%.2f %s, budget %.1f) over %d values%s"),
+            *Kernel, Report.Name, Report.MaxAbs, Report.MaxUlps, Unit, UlpBudget, Report.Num, *Throughput));
+        Test.TestTrue(FString::Printf(TEXT("%s %s within %.1f %s"), *Kernel, Report.Name, UlpBudget, Unit), Report.MaxUlps <= UlpBudget);
+    }
+
+    /** Median nanoseconds per item of Body, which processes NumItems items per call. */
+    template<typename FBody>
+    double MeasureNsPerItem(int64 NumItems, FBody&& Body, int32 Repeats = 5)
+    {
+        Body();
+        TArray<double> Samples;
+        for (int32 Run = 0; Run < Repeats; ++Run)
+        {
+            const double Start = FPlatformTime::Seconds();
+            Body();
+            Samples.Add((FPlatformTime::Seconds() - Start) * 1e9 / NumItems);
+        }
+        Samples.Sort();
+        return Samples[Repeats / 2];
+    }
+
+    /** Reference frames of the analytic scene: resolutions and FOVs that exercise odd widths and the vector tails. */
+    struct FReferenceFrame
+    {
+        const TCHAR* Name;
+        uint32 Width;
+        uint32 Height;
+        float FOVH;
+    };
+
+    const FReferenceFrame ReferenceFrames[] = {
+        { TEXT("Corridor 64x48 @90"), 64, 48, 90.0f },
+        { TEXT("Yard 173x97 @60"), 173, 97, 60.0f },
+        { TEXT("Wide 320x240 @120"), 320, 240, 120.0f },
+    };
+
+    /**
+     * Planar depth (cm along X) of an analytic scene traced in double: a floor 150 cm below the camera,
+     * a 24 m wide, 5.5 m tall wall 25 m ahead and a 1.2 m ball on the floor. Rays that miss everything
+     * or hit past the 80 m sensor range are no returns (0), as a simulated sensor reports them.
+     */
+    TArray<float> RenderReferenceDepth(const FReferenceFrame& Frame)
+    {
+        double TanH, TanV;
+        TFrameConversion<double>::TanHalfFOV(Frame.FOVH, Frame.Width, Frame.Height, TanH, TanV);
+        const FVector Ball(800.0, -150.0, -30.0);
+        const double BallRadius = 120.0;
+
+        TArray<float> Depth;
+        Depth.SetNumUninitialized(Frame.Width * Frame.Height);
+        for (uint32 y = 0; y < Frame.Height; ++y)
+        {
+            for (uint32 x = 0; x < Frame.Width; ++x)
+            {
+                // Ray with unit X, so the hit parameter is the planar depth
+                const FVector Ray(1.0, (2.0 * x / Frame.Width - 1.0) * TanH, (1.0 - 2.0 * y / Frame.Height) * TanV);
+                double Hit = 0.0;
+                auto Consider = [&Hit](double T) { if (T > 0.0 && (Hit == 0.0 || T < Hit)) { Hit = T; } };
+
+                if (Ray.Z < 0.0)
+                {
+                    Consider(-150.0 / Ray.Z);
+                }
+                if (FMath::Abs(Ray.Y * 2500.0) <= 1200.0 && Ray.Z * 2500.0 <= 400.0)
+                {
+                    Consider(2500.0);
+                }
+                const double B = FVector::DotProduct(Ray, Ball);
+                const double A = Ray.SizeSquared();
+                const double Discriminant = B * B - A * (Ball.SizeSquared() - BallRadius * BallRadius);
+                if (Discriminant >= 0.0)
+                {
+                    Consider((B - FMath::Sqrt(Discriminant)) / A);
+                }
+                Depth[y * Frame.Width + x] = Hit <= 8000.0 ? static_cast<float>(Hit) : 0.0f;
+            }
+        }
+        return Depth;
+    }
+
+    /** The six output channels of one pixel. */
+    struct FPixelOutput
+    {
+        double Values[6];
+    };
+
+    enum EChannel { ChannelX, ChannelY, ChannelZ, ChannelRange, ChannelAzimuth, ChannelElevation };
+
+    /** Per-channel reports for one kernel; points are measured against the pixel's range, angles against 1 rad. */
+    struct FChannelReports
+    {
+        FErrorReport Reports[6] = {
+            { TEXT("X"), 1.0 }, { TEXT("Y"), 1.0 }, { TEXT("Z"), 1.0 },
+            { TEXT("Range"), 1.0 }, { TEXT("Azimuth"), 1.0 }, { TEXT("Elevation"), 1.0 } };
+
+        void Add(const FPixelOutput& Value, const FPixelOutput& Reference)
+        {
+            for (int32 Channel = 0; Channel < 6; ++Channel)
+            {
+                Reports[Channel].Add(Value.Values[Channel], Reference.Values[Channel], Channel <= ChannelRange ? Reference.Values[ChannelRange] : 0.0);
+            }
+        }
+    };
+
+    /** Error budgets in float ulps per channel (X, Y, Z, range, azimuth, elevation). */
+    struct FChannelBudgets
+    {
+        double Values[6];
+    };
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FConversionRegressionDepthTest, "MathToolkit.Regression.DepthKernels",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FConversionRegressionDepthTest::RunTest(const FString& Parameters)
+{
+    // The per-pixel path computes everything in float, the batched paths use the vector atan and
+    // the LUT path rounds its table entries once
+    const FChannelBudgets PerPixelBudget = { { 0.0, 4.0, 4.0, 4.0, 4.0, 4.0 } };
+    const FChannelBudgets BatchedBudget = { { 0.0, 4.0, 4.0, 4.0, 8.0, 8.0 } };
+    const FChannelBudgets LUTBudget = { { 0.0, 4.0, 4.0, 4.0, 4.0, 4.0 } };
+
+    for (const FReferenceFrame& Frame : ReferenceFrames)
+    {
+        const int32 NumPixels = static_cast<int32>(Frame.Width * Frame.Height);
+        const TArray<float> Depth = RenderReferenceDepth(Frame);
+
+        int32 NumReturns = 0;
+        for (float Value : Depth)
+        {
+            NumReturns += Value > 0.0f;
+        }
+        TestTrue(FString::Printf(TEXT("%s has returns and holes"), Frame.Name), NumReturns > NumPixels / 4 && NumReturns < NumPixels);
+
+        // Double reference from the same recorded (float) depth
+        double TanH, TanV;
+        TFrameConversion<double>::TanHalfFOV(Frame.FOVH, Frame.Width, Frame.Height, TanH, TanV);
+        TArray<FPixelOutput> Reference;
+        Reference.SetNumUninitialized(NumPixels);
+        for (uint32 y = 0; y < Frame.Height; ++y)
+        {
+            for (uint32 x = 0; x < Frame.Width; ++x)
+            {
+                const int32 i = y * Frame.Width + x;
+                const std::pair<FVector, FVector> Result = TFrameConversion<double>::SphericalFromDepth(Depth[i], x, y, TanH, TanV, Frame.Width, Frame.Height);
+                Reference[i] = { { Result.second.X, Result.second.Y, Result.second.Z, Result.first.X, Result.first.Y, Result.first.Z } };
+            }
+        }
+
+        // Angles of no-return pixels are atan2(0, 0) in every path, so only returns are compared
+        auto Compare = [&](const FString& Kernel, const FDepthPointCloudSoA& Out, const FChannelBudgets& Budget, double NsPerPixel)
+        {
+            FChannelReports Reports;
+            for (int32 i = 0; i < NumPixels; ++i)
+            {
+                if (Depth[i] > 0.0f)
+                {
+                    Reports.Add({ { Out.X[i], Out.Y[i], Out.Z[i], Out.Range[i], Out.Azimuth[i], Out.Elevation[i] } }, Reference[i]);
+                }
+            }
+            for (int32 Channel = 0; Channel < 6; ++Channel)
+            {
+                CheckReport(*this, FString::Printf(TEXT("%s %s"), Frame.Name, *Kernel), Reports.Reports[Channel], Budget.Values[Channel], Channel == 0 ? NsPerPixel : 0.0);
+            }
+        };
+
+        TArray<float> X, Y, Z, Range, Azimuth, Elevation;
+        for (TArray<float>* Channel : { &X, &Y, &Z, &Range, &Azimuth, &Elevation })
+        {
+            Channel->SetNumUninitialized(NumPixels);
+        }
+        const FDepthPointCloudSoA Out{ X, Y, Z, Range, Azimuth, Elevation };
+
+        const double PerPixelNs = MeasureNsPerItem(NumPixels, [&]()
+        {
+            for (uint32 y = 0; y < Frame.Height; ++y)
+            {
+                for (uint32 x = 0; x < Frame.Width; ++x)
+                {
+                    const int32 i = y * Frame.Width + x;
+                    const std::pair<FVector, FVector> Result = MathToolkitLibrary::CalculateSphericalFromDepth(Depth[i], x, y, Frame.FOVH, Frame.Width, Frame.Height);
+                    X[i] = static_cast<float>(Result.second.X);
+                    Y[i] = static_cast<float>(Result.second.Y);
+                    Z[i] = static_cast<float>(Result.second.Z);
+                    Range[i] = static_cast<float>(Result.first.X);
+                    Azimuth[i] = static_cast<float>(Result.first.Y);
+                    Elevation[i] = static_cast<float>(Result.first.Z);
+                }
+            }
+        }, 1);
+        Compare(TEXT("CalculateSphericalFromDepth"), Out, PerPixelBudget, PerPixelNs);
+
+        const double BatchedNs = MeasureNsPerItem(NumPixels, [&]() { MathToolkitLibrary::CalculatePointCloudFromDepth(Depth, Frame.FOVH, Frame.Width, Frame.Height, Out); }, 1);
+        Compare(TEXT("CalculatePointCloudFromDepth"), Out, BatchedBudget, BatchedNs);
+
+        const FDepthRayLUT LUT(Frame.FOVH, Frame.Width, Frame.Height);
+        const double LUTNs = MeasureNsPerItem(NumPixels, [&]() { LUT.Convert(Depth, Out); }, 1);
+        Compare(TEXT("FDepthRayLUT::Convert"), Out, LUTBudget, LUTNs);
+
+        const double TiledNs = MeasureNsPerItem(NumPixels, [&]() { FDepthFramePipeline::ConvertTiled(LUT, Depth, Out, 8, true); }, 1);
+        Compare(TEXT("FDepthFramePipeline::ConvertTiled"), Out, LUTBudget, TiledNs);
+
+        // Spherical -> Cartesian kernel back from the reference angles reproduces the points
+        FErrorReport Inverse(TEXT("XYZ from spherical"), 1.0);
+        TArray<float> RefRange, RefAzimuth, RefElevation;
+        for (int32 i = 0; i < NumPixels; ++i)
+        {
+            RefRange.Add(static_cast<float>(Reference[i].Values[ChannelRange]));
+            RefAzimuth.Add(static_cast<float>(Reference[i].Values[ChannelAzimuth]));
+            RefElevation.Add(static_cast<float>(Reference[i].Values[ChannelElevation]));
+        }
+        const double InverseNs = MeasureNsPerItem(NumPixels, [&]() { MathToolkitKernels::SphericalToCartesian(RefRange, RefAzimuth, RefElevation, X, Y, Z); }, 1);
+        for (int32 i = 0; i < NumPixels; ++i)
+        {
+            const double Magnitude = Reference[i].Values[ChannelRange];
+            Inverse.Add(X[i], Reference[i].Values[ChannelX], Magnitude);
+            Inverse.Add(Y[i], Reference[i].Values[ChannelY], Magnitude);
+            Inverse.Add(Z[i], Reference[i].Values[ChannelZ], Magnitude);
+        }
+        CheckReport(*this, FString::Printf(TEXT("%s MathToolkitKernels::SphericalToCartesian"), Frame.Name), Inverse, 8.0, InverseNs);
+
+        // Narrow encoders, budgeted by their quantization: 2^13 float ulps is one half ulp of binary16
+        TArray<uint16> Half;
+        Half.SetNumUninitialized(3 * NumPixels);
+        TArray<int16> Fixed;
+        Fixed.SetNumUninitialized(3 * NumPixels);
+        TArray<uint16> RangeImage;
+        RangeImage.SetNumUninitialized(NumPixels);
+        const double HalfNs = MeasureNsPerItem(NumPixels, [&]() { LUT.ConvertHalf(Depth, Half, 100.0f); }, 1);
+        const double FixedNs = MeasureNsPerItem(NumPixels, [&]() { LUT.ConvertFixed16(Depth, Fixed, 1.0f); }, 1);
+        const double RangeImageNs = MeasureNsPerItem(NumPixels, [&]() { LUT.ConvertRangeImage(Depth, RangeImage, 1.0f); }, 1);
+
+        FErrorReport HalfReport(TEXT("XYZ"), 1.0);
+        FErrorReport FixedReport = FErrorReport::Quantized(TEXT("XYZ (cm)"), 1.0);
+        FErrorReport RangeImageReport = FErrorReport::Quantized(TEXT("range (cm)"), 1.0);
+        for (int32 i = 0; i < NumPixels; ++i)
+        {
+            const double Magnitude = Reference[i].Values[ChannelRange];
+            for (int32 Axis = 0; Axis < 3; ++Axis)
+            {
+                const uint16 Bits = Half[3 * i + Axis];
+                const int32 Exponent = (Bits >> 10) & 0x1F;
+                const double Mantissa = Exponent ? 1.0 + (Bits & 0x3FF) / 1024.0 : (Bits & 0x3FF) / 1024.0;
+                const double Decoded = (Bits & 0x8000 ? -1.0 : 1.0) * Mantissa * std::ldexp(1.0, FMath::Max(Exponent, 1) - 15);
+                HalfReport.Add(Decoded * 100.0, Reference[i].Values[Axis], Magnitude);
+                FixedReport.Add(Fixed[3 * i + Axis], FMath::Clamp(Reference[i].Values[Axis], -32767.0, 32767.0));
+            }
+            RangeImageReport.Add(RangeImage[i], Magnitude);
+        }
+        CheckReport(*this, FString::Printf(TEXT("%s FDepthRayLUT::ConvertHalf"), Frame.Name), HalfReport, 8192.0 + 4.0, HalfNs);
+        // Half a step of rounding plus the float rounding of values up to 65535 steps
+        CheckReport(*this, FString::Printf(TEXT("%s FDepthRayLUT::ConvertFixed16"), Frame.Name), FixedReport, 0.51, FixedNs);
+        CheckReport(*this, FString::Printf(TEXT("%s FDepthRayLUT::ConvertRangeImage"), Frame.Name), RangeImageReport, 0.51, RangeImageNs);
+    }
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FConversionRegressionProjectionTest, "MathToolkit.Regression.ProjectionRoundTrip",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FConversionRegressionProjectionTest::RunTest(const FString& Parameters)
+{
+    FRandomStream Random(2024);
+    for (const FReferenceFrame& Frame : ReferenceFrames)
+    {
+        const FCameraProjection Projection(Frame.FOVH, Frame.Width, Frame.Height);
+        const int32 NumSamples = 20000;
+
+        // Unproject a random subpixel position, then project it back both ways. Pixel centres sit on
+        // integer coordinates, so the image spans [-0.5, size - 0.5). Pixel errors are reported in
+        // ulps of the image width, i.e. relative to the largest coordinate
+        FErrorReport NDCU(TEXT("U"), Frame.Width), NDCV(TEXT("V"), Frame.Width);
+        FErrorReport ProjectU(TEXT("U"), Frame.Width), ProjectV(TEXT("V"), Frame.Width);
+        TArray<float> U, V, PX, PY, PZ, OutU, OutV;
+        TArray<uint8> Visible;
+        for (int32 i = 0; i < NumSamples; ++i)
+        {
+            U.Add(Random.FRandRange(-0.49f, Frame.Width - 0.51f));
+            V.Add(Random.FRandRange(-0.49f, Frame.Height - 0.51f));
+            const std::pair<FVector, FVector> Result = MathToolkitLibrary::CalculateSphericalFromDepth(
+                Random.FRandRange(50.0f, 8000.0f), U[i], V[i], Frame.FOVH, Frame.Width, Frame.Height);
+            PX.Add(static_cast<float>(Result.second.X));
+            PY.Add(static_cast<float>(Result.second.Y));
+            PZ.Add(static_cast<float>(Result.second.Z));
+
+            const std::pair<float, float> Pixel = MathToolkitLibrary::CalculateNDCCoordinates(
+                static_cast<float>(Result.first.Y), static_cast<float>(Result.first.Z), Frame.FOVH, Frame.Width, Frame.Height);
+            NDCU.Add(Pixel.first, U[i]);
+            NDCV.Add(Pixel.second, V[i]);
+        }
+        OutU.SetNumUninitialized(NumSamples);
+        OutV.SetNumUninitialized(NumSamples);
+        Visible.SetNumUninitialized(NumSamples);
+        const double ProjectNs = MeasureNsPerItem(NumSamples, [&]() { Projection.Project(PX, PY, PZ, OutU, OutV, Visible); });
+        int32 NumVisible = 0;
+        for (int32 i = 0; i < NumSamples; ++i)
+        {
+            NumVisible += Visible[i];
+            ProjectU.Add(OutU[i], U[i]);
+            ProjectV.Add(OutV[i], V[i]);
+        }
+        TestEqual(FString::Printf(TEXT("%s: every unprojected pixel projects back into the image"), Frame.Name), NumVisible, NumSamples);
+
+        // The NDC path goes through tan / cos of float angles, so it carries the angle rounding
+        CheckReport(*this, FString::Printf(TEXT("%s CalculateNDCCoordinates"), Frame.Name), NDCU, 16.0);
+        CheckReport(*this, FString::Printf(TEXT("%s CalculateNDCCoordinates"), Frame.Name), NDCV, 16.0);
+        CheckReport(*this, FString::Printf(TEXT("%s FCameraProjection::Project"), Frame.Name), ProjectU, 4.0, ProjectNs);
+        CheckReport(*this, FString::Printf(TEXT("%s FCameraProjection::Project"), Frame.Name), ProjectV, 4.0);
+    }
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FConversionRegressionFrameTest, "MathToolkit.Regression.FrameRoundTrip",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FConversionRegressionFrameTest::RunTest(const FString& Parameters)
+{
+    // Points from a millimetre to 100 km, rotations over the whole sphere
+    FRandomStream Random(77);
+    const int32 NumSamples = 50000;
+    TArray<FVector> Points;
+    TArray<FQuat> Rotations;
+    for (int32 i = 0; i < NumSamples; ++i)
+    {
+        const double Magnitude = FMath::Pow(10.0, static_cast<double>(Random.FRandRange(-1.0f, 7.0f)));
+        Points.Add(FVector(Random.FRandRange(-1.0f, 1.0f), Random.FRandRange(-1.0f, 1.0f), Random.FRandRange(-1.0f, 1.0f)) * Magnitude);
+        Rotations.Add(FQuat(FVector(Random.FRandRange(-1.0f, 1.0f), Random.FRandRange(-1.0f, 1.0f), Random.FRandRange(-1.0f, 1.0f)).GetSafeNormal(),
+            Random.FRandRange(-UE_PI, UE_PI)));
+    }
+
+    // Double path: UE -> ROS -> UE, in double ulps relative to each point's size
+    FErrorReport RoundTrip(TEXT("UE -> ROS -> UE"), 0.0, DBL_EPSILON);
+    FErrorReport RotationRoundTrip(TEXT("quaternion UE -> ROS -> UE"), 1.0);
+    FErrorReport BatchReport(TEXT("batched against scalar"), 0.0, DBL_EPSILON);
+    TArray<FVector> ROS;
+    ROS.SetNumUninitialized(NumSamples);
+    const double BatchNs = MeasureNsPerItem(NumSamples, [&]() { MathToolkitLibrary::ConvertUEToROS(Points, ROS); });
+    for (int32 i = 0; i < NumSamples; ++i)
+    {
+        const FVector Scalar = MathToolkitLibrary::ConvertUEToROS(Points[i]);
+        const FVector Back = MathToolkitLibrary::ConvertROSToUE(Scalar);
+        const double Size = Points[i].Size();
+        for (int32 Axis = 0; Axis < 3; ++Axis)
+        {
+            // The batch multiplies by 0.01 where the scalar path divides by 100
+            BatchReport.Add(ROS[i][Axis], Scalar[Axis], Scalar.Size());
+            RoundTrip.Add(Back[Axis], Points[i][Axis], Size);
+        }
+        const FQuat BackRotation = MathToolkitLibrary::ConvertROSToUE(MathToolkitLibrary::ConvertUEToROS(Rotations[i]));
+        for (int32 Axis = 0; Axis < 3; ++Axis)
+        {
+            RotationRoundTrip.Add(BackRotation.RotateVector(FVector(Axis == 0, Axis == 1, Axis == 2))[Axis],
+                Rotations[i].RotateVector(FVector(Axis == 0, Axis == 1, Axis == 2))[Axis]);
+        }
+    }
+    CheckReport(*this, TEXT("ConvertUEToROS (double)"), BatchReport, 2.0, BatchNs);
+    CheckReport(*this, TEXT("ConvertUEToROS (double)"), RoundTrip, 2.0);
+    CheckReport(*this, TEXT("ConvertUEToROS(FQuat)"), RotationRoundTrip, 4.0);
+
+    // Interleaved float path against the double reference
+    TArray<float> Interleaved, InterleavedROS;
+    for (const FVector& Point : Points)
+    {
+        Interleaved.Add(static_cast<float>(Point.X));
+        Interleaved.Add(static_cast<float>(Point.Y));
+        Interleaved.Add(static_cast<float>(Point.Z));
+    }
+    InterleavedROS.SetNumUninitialized(Interleaved.Num());
+    const double InterleavedNs = MeasureNsPerItem(NumSamples, [&]() { MathToolkitLibrary::ConvertUEToROS(Interleaved, InterleavedROS); });
+    FErrorReport FloatReport(TEXT("float XYZ"), 0.0);
+    for (int32 i = 0; i < NumSamples; ++i)
+    {
+        const FVector Expected = TFrameConversion<double>::UEToROS(FVector(Interleaved[3 * i], Interleaved[3 * i + 1], Interleaved[3 * i + 2]));
+        for (int32 Axis = 0; Axis < 3; ++Axis)
+        {
+            FloatReport.Add(InterleavedROS[3 * i + Axis], Expected[Axis], Expected.Size());
+        }
+    }
+    CheckReport(*this, TEXT("ConvertUEToROS(float)"), FloatReport, 1.5, InterleavedNs);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FConversionRegressionGoldenTest, "MathToolkit.Regression.Golden",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FConversionRegressionGoldenTest::RunTest(const FString& Parameters)
+{
+    // Outputs recorded from the scalar library path. They pin the conventions (axes, signs, pixel
+    // centres, FOV handling), so a kernel that drifts from them fails here even if it stays
+    // self-consistent with its own inverse
+    struct FGoldenPixel
+    {
+        float Depth, x, y, FOVH;
+        uint32 Width, Height;
+        double Expected[6];   // X, Y, Z, range, azimuth, elevation
+    };
+    const FGoldenPixel GoldenPixels[] = {
+#include "ConversionRegressionGolden.inl"
+    };
+
+    FChannelReports Reports;
+    for (const FGoldenPixel& Golden : GoldenPixels)
+    {
+        const std::pair<FVector, FVector> Result = MathToolkitLibrary::CalculateSphericalFromDepth(Golden.Depth, Golden.x, Golden.y, Golden.FOVH, Golden.Width, Golden.Height);
+        Reports.Add({ { Result.second.X, Result.second.Y, Result.second.Z, Result.first.X, Result.first.Y, Result.first.Z } }, { { Golden.Expected[0],
+            Golden.Expected[1], Golden.Expected[2], Golden.Expected[3], Golden.Expected[4], Golden.Expected[5] } });
+
+        // The pixel projects back onto itself
+        const std::pair<float, float> Pixel = MathToolkitLibrary::CalculateNDCCoordinates(
+            static_cast<float>(Golden.Expected[4]), static_cast<float>(Golden.Expected[5]), Golden.FOVH, Golden.Width, Golden.Height);
+        TestTrue(FString::Printf(TEXT("Golden pixel (%g, %g) projects back"), Golden.x, Golden.y),
+            FMath::IsNearlyEqual(Pixel.first, Golden.x, 1e-3f * Golden.Width) && FMath::IsNearlyEqual(Pixel.second, Golden.y, 1e-3f * Golden.Width));
+    }
+    for (const FErrorReport& Report : Reports.Reports)
+    {
+        CheckReport(*this, TEXT("Golden CalculateSphericalFromDepth"), Report, 2.0);
+    }
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FConversionRegressionThroughputTest, "MathToolkit.Regression.Throughput",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FConversionRegressionThroughputTest::RunTest(const FString& Parameters)
+{
+    // Absolute timings depend on the machine, so the gates are speedups of each batched kernel over
+    // the per-item path it replaces, measured in the same run. Measured speedups are ~8-12x; the
+    // floors only trip when a kernel loses its vectorization or picks up a per-item cost
+    const uint32 Width = 640;
+    const uint32 Height = 480;
+    const float FOVH = 90.0f;
+    const int32 NumPixels = Width * Height;
+    const TArray<float> Depth = RenderReferenceDepth({ TEXT("Throughput"), Width, Height, FOVH });
+
+    TArray<float> X, Y, Z, Range, Azimuth, Elevation, U, V;
+    TArray<uint8> Visible;
+    for (TArray<float>* Channel : { &X, &Y, &Z, &Range, &Azimuth, &Elevation, &U, &V })
+    {
+        Channel->SetNumUninitialized(NumPixels);
+    }
+    Visible.SetNumUninitialized(NumPixels);
+    const FDepthPointCloudSoA Out{ X, Y, Z, Range, Azimuth, Elevation };
+    const FDepthRayLUT LUT(FOVH, Width, Height);
+    const FCameraProjection Projection(FOVH, Width, Height);
+
+    const double PerPixelNs = MeasureNsPerItem(NumPixels, [&]()
+    {
+        for (uint32 y = 0; y < Height; ++y)
+        {
+            for (uint32 x = 0; x < Width; ++x)
+            {
+                const int32 i = y * Width + x;
+                const std::pair<FVector, FVector> Result = MathToolkitLibrary::CalculateSphericalFromDepth(Depth[i], x, y, FOVH, Width, Height);
+                X[i] = static_cast<float>(Result.second.X);
+                Range[i] = static_cast<float>(Result.first.X);
+            }
+        }
+    });
+    const double BatchedNs = MeasureNsPerItem(NumPixels, [&]() { MathToolkitLibrary::CalculatePointCloudFromDepth(Depth, FOVH, Width, Height, Out); });
+    const double LUTNs = MeasureNsPerItem(NumPixels, [&]() { LUT.Convert(Depth, Out); });
+
+    const double ProjectPointNs = MeasureNsPerItem(NumPixels, [&]()
+    {
+        for (int32 i = 0; i < NumPixels; ++i)
+        {
+            Projection.ProjectPoint(FVector(X[i], Y[i], Z[i]), U[i], V[i]);
+        }
+    });
+    const double ProjectNs = MeasureNsPerItem(NumPixels, [&]() { Projection.Project(X, Y, Z, U, V, Visible); });
+
+    const double LibmSphericalNs = MeasureNsPerItem(NumPixels, [&]()
+    {
+        for (int32 i = 0; i < NumPixels; ++i)
+        {
+            const float Planar = Range[i] * std::cos(Elevation[i]);
+            X[i] = Planar * std::cos(Azimuth[i]);
+            Y[i] = Planar * std::sin(Azimuth[i]);
+            Z[i] = Range[i] * std::sin(Elevation[i]);
+        }
+    });
+    const double KernelSphericalNs = MeasureNsPerItem(NumPixels, [&]() { MathToolkitKernels::SphericalToCartesian(Range, Azimuth, Elevation, X, Y, Z); });
+
+    struct FGate
+    {
+        const TCHAR* Name;
+        double ReferenceNs;
+        double KernelNs;
+        double MinSpeedup;
+    };
+    const FGate Gates[] = {
+        { TEXT("CalculatePointCloudFromDepth vs per pixel"), PerPixelNs, BatchedNs, 3.0 },
+        { TEXT("FDepthRayLUT::Convert vs per pixel"), PerPixelNs, LUTNs, 4.0 },
+        { TEXT("FCameraProjection::Project vs ProjectPoint"), ProjectPointNs, ProjectNs, 3.0 },
+        { TEXT("SphericalToCartesian vs libm"), LibmSphericalNs, KernelSphericalNs, 1.5 },
+    };
+    for (const FGate& Gate : Gates)
+    {
+        const double Speedup = Gate.ReferenceNs / FMath::Max(Gate.KernelNs, 1e-3);
+        AddInfo(FString::Printf(TEXT("%s %s: %.2f ns/item against %.2f ns/item, %.1fx (floor %.1fx)"),
+            MathToolkitKernels::GetSIMDPathName(), Gate.Name, Gate.KernelNs, Gate.ReferenceNs, Speedup, Gate.MinSpeedup));
+        TestTrue(FString::Printf(TEXT("%s at least %.1fx"), Gate.Name, Gate.MinSpeedup), Speedup >= Gate.MinSpeedup);
+    }
+
+    return true;
+}
@@ -0,0 +1,362 @@
+#include "Misc/AutomationTest.h"
+#include "MathToolkitLibrary.h"
+#include "DepthRayLUT.h"
+#include "DepthFramePipeline.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDepthBatchMatchesPerPixelTest, "MathToolkit.DepthConversion.BatchMatchesPerPixel",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FDepthBatchMatchesPerPixelTest::RunTest(const FString& Parameters)
+{
+    const uint32 width = 64;
+    const uint32 height = 48;
+    const float FOVH = 90.0f;
+    const int32 NumPixels = width * height;
+
+    TArray<float> Depth;
+    Depth.SetNumUninitialized(NumPixels);
+    for (int32 i = 0; i < NumPixels; ++i)
+    {
+        Depth[i] = 100.0f + (i % 37) * 25.0f;
+    }
+
+    TArray<float> X, Y, Z, Range, Azimuth, Elevation;
+    X.SetNumUninitialized(NumPixels);
+    Y.SetNumUninitialized(NumPixels);
+    Z.SetNumUninitialized(NumPixels);
+    Range.SetNumUninitialized(NumPixels);
+    Azimuth.SetNumUninitialized(NumPixels);
+    Elevation.SetNumUninitialized(NumPixels);
+
+    FDepthPointCloudSoA Out{X, Y, Z, Range, Azimuth, Elevation};
+    MathToolkitLibrary::CalculatePointCloudFromDepth(Depth, FOVH, width, height, Out);
+
+    int32 Mismatches = 0;
+    for (uint32 y = 0; y < height; ++y)
+    {
+        for (uint32 x = 0; x < width; ++x)
+        {
+            const int32 i = y * width + x;
+            std::pair<FVector, FVector> Expected = MathToolkitLibrary::CalculateSphericalFromDepth(Depth[i], x, y, FOVH, width, height);
+            const FVector& Spherical = Expected.first;
+            const FVector& Point = Expected.second;
+
+            const bool bMatches =
+                FMath::IsNearlyEqual(X[i], Point.X, 0.05f) &&
+                FMath::IsNearlyEqual(Y[i], Point.Y, 0.05f) &&
+                FMath::IsNearlyEqual(Z[i], Point.Z, 0.05f) &&
+                FMath::IsNearlyEqual(Range[i], Spherical.X, 0.05f) &&
+                FMath::IsNearlyEqual(Azimuth[i], Spherical.Y, 1e-4f) &&
+                FMath::IsNearlyEqual(Elevation[i], Spherical.Z, 1e-4f);
+            Mismatches += bMatches ? 0 : 1;
+        }
+    }
+    TestEqual(TEXT("Batched conversion should match CalculateSphericalFromDepth for every pixel"), Mismatches, 0);
+
+    // Skipped channels must be left untouched
+    TArray<float> OnlyRange;
+    OnlyRange.SetNumZeroed(NumPixels);
+    FDepthPointCloudSoA RangeOnly;
+    RangeOnly.Range = OnlyRange;
+    MathToolkitLibrary::CalculatePointCloudFromDepth(Depth, FOVH, width, height, RangeOnly);
+    TestTrue(TEXT("Range-only conversion should fill the range channel"), FMath::IsNearlyEqual(OnlyRange[NumPixels - 1], Range[NumPixels - 1], 0.01f));
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDepthRayLUTTest, "MathToolkit.DepthConversion.RayLUT",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FDepthRayLUTTest::RunTest(const FString& Parameters)
+{
+    const uint32 width = 32;
+    const uint32 height = 24;
+    const float FOVH = 75.0f;
+    const int32 NumPixels = width * height;
+
+    TArray<float> Depth;
+    Depth.Init(350.0f, NumPixels);
+
+    TArray<float> BatchRange, BatchElevation, LUTRange, LUTElevation, LUTY;
+    BatchRange.SetNumUninitialized(NumPixels);
+    BatchElevation.SetNumUninitialized(NumPixels);
+    LUTRange.SetNumUninitialized(NumPixels);
+    LUTElevation.SetNumUninitialized(NumPixels);
+    LUTY.SetNumUninitialized(NumPixels);
+
+    FDepthPointCloudSoA Batch;
+    Batch.Range = BatchRange;
+    Batch.Elevation = BatchElevation;
+    MathToolkitLibrary::CalculatePointCloudFromDepth(Depth, FOVH, width, height, Batch);
+
+    FDepthRayLUTHandle Handle;
+    const FDepthRayLUT& LUT = Handle.Resolve(FOVH, width, height);
+    FDepthPointCloudSoA FromLUT;
+    FromLUT.Y = LUTY;
+    FromLUT.Range = LUTRange;
+    FromLUT.Elevation = LUTElevation;
+    LUT.Convert(Depth, FromLUT);
+
+    int32 Mismatches = 0;
+    for (int32 i = 0; i < NumPixels; ++i)
+    {
+        Mismatches += (FMath::IsNearlyEqual(LUTRange[i], BatchRange[i], 0.01f) && FMath::IsNearlyEqual(LUTElevation[i], BatchElevation[i], 1e-5f)) ? 0 : 1;
+    }
+    TestEqual(TEXT("LUT conversion should match the batched conversion"), Mismatches, 0);
+
+    std::pair<FVector, FVector> Corner = MathToolkitLibrary::CalculateSphericalFromDepth(Depth[0], 0, 0, FOVH, width, height);
+    TestTrue(TEXT("LUT Y should match the per-pixel conversion"), FMath::IsNearlyEqual(LUTY[0], Corner.second.Y, 0.01f));
+
+    // Identical intrinsics share one table, different ones get their own
+    FDepthRayLUTHandle OtherSensor;
+    TestTrue(TEXT("Sensors with identical intrinsics should share a table"), &OtherSensor.Resolve(FOVH, width, height) == &LUT);
+    TestTrue(TEXT("Changed intrinsics should resolve to another table"), &OtherSensor.Resolve(FOVH, width * 2, height) != &LUT);
+    TestEqual(TEXT("Rebuilt table should have the new width"), static_cast<int32>(OtherSensor.Resolve(FOVH, width * 2, height).GetWidth()), static_cast<int32>(width * 2));
+
+    FDepthRayLUTCache& Cache = FDepthRayLUTCache::Get();
+    TestTrue(TEXT("Cache should account for the table memory"), Cache.GetAllocatedSize() >= LUT.GetAllocatedSize() + OtherSensor.Resolve(FOVH, width * 2, height).GetAllocatedSize());
+
+    // Once no sensor holds a table any more it can be trimmed; other tests may share the cache, so
+    // only the tables this test created are checked
+    TestTrue(TEXT("Cache should hold the rebuilt table"), Cache.Contains(FOVH, width * 2, height));
+    OtherSensor.Reset();
+    Cache.Trim();
+    TestFalse(TEXT("Trim should drop the table nobody references"), Cache.Contains(FOVH, width * 2, height));
+    TestTrue(TEXT("Trim should keep the table a sensor still holds"), Cache.Contains(FOVH, width, height));
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDepthFramePipelineTest, "MathToolkit.DepthConversion.Pipeline",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FDepthFramePipelineTest::RunTest(const FString& Parameters)
+{
+    const uint32 width = 96;
+    const uint32 height = 61;
+    const float FOVH = 75.0f;
+    const int32 NumPixels = width * height;
+
+    TArray<TArray<float>> Frames;
+    for (int32 f = 0; f < 4; ++f)
+    {
+        TArray<float>& Depth = Frames.AddDefaulted_GetRef();
+        Depth.SetNumUninitialized(NumPixels);
+        for (int32 i = 0; i < NumPixels; ++i)
+        {
+            Depth[i] = 50.0f + ((i * (f + 3)) % 101) * 10.0f;
+        }
+    }
+
+    auto MatchesReference = [&](FDepthFrame& Frame, const TArray<float>& Depth)
+    {
+        TArray<float> X, Y, Z, Range, Azimuth, Elevation;
+        for (TArray<float>* Channel : { &X, &Y, &Z, &Range, &Azimuth, &Elevation })
+        {
+            Channel->SetNumUninitialized(NumPixels);
+        }
+        MathToolkitLibrary::CalculatePointCloudFromDepth(Depth, FOVH, width, height, FDepthPointCloudSoA{X, Y, Z, Range, Azimuth, Elevation});
+
+        int32 Mismatches = 0;
+        for (int32 i = 0; i < NumPixels; ++i)
+        {
+            const bool bMatches =
+                FMath::IsNearlyEqual(Frame.X[i], X[i], 0.05f) &&
+                FMath::IsNearlyEqual(Frame.Y[i], Y[i], 0.05f) &&
+                FMath::IsNearlyEqual(Frame.Z[i], Z[i], 0.05f) &&
+                FMath::IsNearlyEqual(Frame.Range[i], Range[i], 0.05f) &&
+                FMath::IsNearlyEqual(Frame.Azimuth[i], Azimuth[i], 1e-4f) &&
+                FMath::IsNearlyEqual(Frame.Elevation[i], Elevation[i], 1e-4f);
+            Mismatches += bMatches ? 0 : 1;
+        }
+        return Mismatches == 0;
+    };
+
+    for (bool bAsync : { false, true })
+    {
+        FDepthFramePipeline::FSettings Settings;
+        Settings.FOVH = FOVH;
+        Settings.Width = width;
+        Settings.Height = height;
+        Settings.RowsPerTile = 8;   // 61 rows: the last tile is partial
+        Settings.NumFrames = 2;
+        Settings.bAsync = bAsync;
+        FDepthFramePipeline Pipeline(Settings);
+
+        TestTrue(TEXT("First frame should be accepted"), Pipeline.Submit(Frames[0]));
+        TestTrue(TEXT("Second frame should be accepted"), Pipeline.Submit(Frames[1]));
+        TestFalse(TEXT("Third frame should be rejected while two are in flight"), Pipeline.Submit(Frames[2]));
+        TestEqual(TEXT("Two frames should be in flight"), Pipeline.NumInFlight(), 2);
+
+        int32 Expected = 0;
+        for (int32 Next = 2; Next <= 4; ++Next)
+        {
+            FDepthFrame* Frame = Pipeline.WaitForFrame();
+            TestNotNull(TEXT("A submitted frame should come back"), Frame);
+            if (!Frame)
+            {
+                break;
+            }
+            TestEqual(TEXT("Frames should come back in submission order"), static_cast<int32>(Frame->FrameNumber), Expected);
+            TestTrue(FString::Printf(TEXT("Frame %d should match CalculatePointCloudFromDepth"), Expected), MatchesReference(*Frame, Frames[Expected]));
+            TestEqual(TEXT("Frame should report its tile count"), Frame->Timings.NumTiles, 8);
+            TestTrue(TEXT("Stage timings should be non-negative"),
+                Frame->Timings.CaptureSeconds >= 0.0 && Frame->Timings.QueueSeconds >= 0.0 && Frame->Timings.ConvertSeconds >= 0.0);
+            Pipeline.ReleaseFrame();
+            ++Expected;
+
+            if (Next < 4)
+            {
+                TestTrue(TEXT("A released slot should accept the next frame"), Pipeline.Submit(Frames[Next]));
+            }
+        }
+
+        // Two more frames were submitted after the first release; drain them
+        while (FDepthFrame* Frame = Pipeline.WaitForFrame())
+        {
+            TestTrue(FString::Printf(TEXT("Frame %d should match CalculatePointCloudFromDepth"), Expected), MatchesReference(*Frame, Frames[Expected]));
+            Pipeline.ReleaseFrame();
+            ++Expected;
+        }
+        TestEqual(TEXT("Every accepted frame should be delivered"), Expected, 4);
+        TestNull(TEXT("Nothing should be left in flight"), Pipeline.WaitForFrame());
+    }
+
+    return true;
+}
+
+namespace
+{
+    float HalfToFloat(uint16 Half)
+    {
+        const int32 Exponent = (Half >> 10) & 0x1F;
+        const int32 Mantissa = Half & 0x3FF;
+        const float Magnitude = Exponent == 0 ? FMath::Pow(2.0f, -24.0f) * Mantissa
+            : Exponent == 31 ? (Mantissa ? NAN : INFINITY)
+            : FMath::Pow(2.0f, static_cast<float>(Exponent - 15)) * (1.0f + Mantissa / 1024.0f);
+        return (Half & 0x8000) ? -Magnitude : Magnitude;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDepthNarrowOutputTest, "MathToolkit.DepthConversion.NarrowOutput",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FDepthNarrowOutputTest::RunTest(const FString& Parameters)
+{
+    // Odd width so every row ends in the scalar tail of the vector loop
+    const uint32 width = 37;
+    const uint32 height = 9;
+    const float FOVH = 90.0f;
+    const int32 NumPixels = width * height;
+    const FDepthRayLUT LUT(FOVH, width, height);
+
+    TArray<float> Depth;
+    FRandomStream Random(9);
+    for (int32 i = 0; i < NumPixels; ++i)
+    {
+        Depth.Add(i % 7 == 0 ? 0.0f : Random.FRandRange(1.0f, 3000.0f));
+    }
+    Depth[1] = 1.0e6f;   // saturates the fixed-point and range encodings, overflows half
+    // NaN (no return) in vector lanes and in the scalar tails of the rows and of the whole frame
+    const int32 NaNPixels[] = { 5, 36, 40, NumPixels - 1 };
+    for (int32 i : NaNPixels)
+    {
+        Depth[i] = NAN;
+    }
+
+    TArray<float> X, Y, Z, Range;
+    for (TArray<float>* Channel : { &X, &Y, &Z, &Range })
+    {
+        Channel->SetNumUninitialized(NumPixels);
+    }
+    FDepthPointCloudSoA Wide;
+    Wide.X = X;
+    Wide.Y = Y;
+    Wide.Z = Z;
+    Wide.Range = Range;
+    LUT.Convert(Depth, Wide);
+
+    // Half: within half an ulp (11 significant bits) of the float conversion, in metres
+    TArray<uint16> Half;
+    Half.SetNumUninitialized(3 * NumPixels);
+    LUT.ConvertHalf(Depth, Half, 100.0f);
+    int32 HalfMismatches = 0;
+    for (int32 i = 2; i < NumPixels; ++i)
+    {
+        if (FMath::IsNaN(Depth[i]))
+        {
+            continue;
+        }
+        const float Reference[3] = { X[i] / 100.0f, Y[i] / 100.0f, Z[i] / 100.0f };
+        for (int32 Axis = 0; Axis < 3; ++Axis)
+        {
+            const float Tolerance = FMath::Abs(Reference[Axis]) * (1.0f / 2048.0f) + 1.0e-7f;
+            HalfMismatches += FMath::Abs(HalfToFloat(Half[3 * i + Axis]) - Reference[Axis]) <= Tolerance ? 0 : 1;
+        }
+    }
+    TestEqual(TEXT("Half output should round the float conversion"), HalfMismatches, 0);
+    TArray<uint16> HalfCm;
+    HalfCm.SetNumUninitialized(3 * NumPixels);
+    LUT.ConvertHalf(Depth, HalfCm);
+    TestEqual(TEXT("Half past 65504 units is infinity"), static_cast<int32>(HalfCm[3]), 0x7C00);
+    TestEqual(TEXT("Zero depth encodes as +0"), static_cast<int32>(HalfCm[0]), 0);
+
+    // Fixed point in mm: within half a unit, saturated at the int16 limit
+    TArray<int16> Fixed;
+    Fixed.SetNumUninitialized(3 * NumPixels);
+    LUT.ConvertFixed16(Depth, Fixed, 0.1f);
+    int32 FixedMismatches = 0;
+    for (int32 i = 2; i < NumPixels; ++i)
+    {
+        if (FMath::IsNaN(Depth[i]))
+        {
+            continue;
+        }
+        const float Reference[3] = { X[i] * 10.0f, Y[i] * 10.0f, Z[i] * 10.0f };
+        for (int32 Axis = 0; Axis < 3; ++Axis)
+        {
+            const float Expected = FMath::Clamp(Reference[Axis], -32767.0f, 32767.0f);
+            FixedMismatches += FMath::Abs(Fixed[3 * i + Axis] - Expected) <= 0.51f ? 0 : 1;
+        }
+    }
+    TestEqual(TEXT("Fixed-point output should round the float conversion"), FixedMismatches, 0);
+    TestEqual(TEXT("Fixed-point X saturates"), static_cast<int32>(Fixed[3]), 32767);
+    TestEqual(TEXT("Fixed-point Y saturates negative at the left edge"), static_cast<int32>(Fixed[4]), -32767);
+    int32 NumBelowLimit = 0;
+    for (int16 Value : Fixed)
+    {
+        NumBelowLimit += Value < -32767 ? 1 : 0;
+    }
+    TestEqual(TEXT("Fixed-point saturation is symmetric in every lane"), NumBelowLimit, 0);
+
+    // Range image in cm: 0 for no return, saturated at 65535
+    TArray<uint16> RangeImage;
+    RangeImage.SetNumUninitialized(NumPixels);
+    LUT.ConvertRangeImage(Depth, RangeImage, 1.0f);
+    int32 RangeMismatches = 0;
+    for (int32 i = 0; i < NumPixels; ++i)
+    {
+        if (FMath::IsNaN(Depth[i]))
+        {
+            continue;
+        }
+        const float Expected = FMath::Clamp(Range[i], 0.0f, 65535.0f);
+        RangeMismatches += FMath::Abs(RangeImage[i] - Expected) <= 0.51f ? 0 : 1;
+    }
+    TestEqual(TEXT("Range image should round the float range"), RangeMismatches, 0);
+    TestEqual(TEXT("Missing return encodes as 0"), static_cast<int32>(RangeImage[0]), 0);
+    TestEqual(TEXT("Far range saturates"), static_cast<int32>(RangeImage[1]), 65535);
+
+    // NaN depths encode as 0 in the integer outputs whichever path converts them, and stay NaN in half
+    for (int32 i : NaNPixels)
+    {
+        for (int32 Axis = 0; Axis < 3; ++Axis)
+        {
+            TestEqual(FString::Printf(TEXT("NaN pixel %d fixed-point axis %d"), i, Axis), static_cast<int32>(Fixed[3 * i + Axis]), 0);
+            TestTrue(FString::Printf(TEXT("NaN pixel %d half axis %d"), i, Axis), FMath::IsNaN(HalfToFloat(Half[3 * i + Axis])));
+        }
+        TestEqual(FString::Printf(TEXT("NaN pixel %d range image"), i), static_cast<int32>(RangeImage[i]), 0);
+    }
+
+    return true;
+}
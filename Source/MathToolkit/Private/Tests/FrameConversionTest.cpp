@@ -0,0 +1,358 @@
+#include "Misc/AutomationTest.h"
+#include "MathToolkitLibrary.h"
+#include "FrameConversion.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFrameConversionBatchVectorTest, "MathToolkit.FrameConversion.BatchVector",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FFrameConversionBatchVectorTest::RunTest(const FString& Parameters)
+{
+    FRandomStream Random(42);
+    TArray<FVector> Cloud;
+    for (int32 i = 0; i < 1001; ++i)
+    {
+        Cloud.Add(FVector(Random.FRandRange(-1e4f, 1e4f), Random.FRandRange(-1e4f, 1e4f), Random.FRandRange(-1e4f, 1e4f)));
+    }
+
+    TArray<FVector> ROS;
+    ROS.SetNumUninitialized(Cloud.Num());
+    MathToolkitLibrary::ConvertUEToROS(Cloud, ROS);
+
+    bool bMatches = true;
+    for (int32 i = 0; i < Cloud.Num(); ++i)
+    {
+        bMatches &= ROS[i].Equals(MathToolkitLibrary::ConvertUEToROS(Cloud[i]), 1e-9);
+    }
+    TestTrue(TEXT("Batch UE -> ROS should match the per-point conversion"), bMatches);
+
+    // In place back to UE
+    MathToolkitLibrary::ConvertROSToUE(ROS, ROS);
+    bMatches = true;
+    for (int32 i = 0; i < Cloud.Num(); ++i)
+    {
+        bMatches &= ROS[i].Equals(Cloud[i], 1e-6);
+    }
+    TestTrue(TEXT("In-place ROS -> UE should restore the original cloud"), bMatches);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFrameConversionInterleavedTest, "MathToolkit.FrameConversion.Interleaved",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FFrameConversionInterleavedTest::RunTest(const FString& Parameters)
+{
+    FRandomStream Random(43);
+    TArray<FVector> Cloud;
+    for (int32 i = 0; i < 517; ++i)
+    {
+        Cloud.Add(FVector(Random.FRandRange(-1e4f, 1e4f), Random.FRandRange(-1e4f, 1e4f), Random.FRandRange(-1e4f, 1e4f)));
+    }
+
+    for (int32 Stride : {3, 4, 5})
+    {
+        // Padding floats carry a marker that must survive every conversion
+        TArray<float> UEXYZ, ROSXYZ, Direct;
+        UEXYZ.Init(-7.0f, Cloud.Num() * Stride);
+        ROSXYZ.Init(-7.0f, Cloud.Num() * Stride);
+        Direct.Init(-7.0f, Cloud.Num() * Stride);
+        for (int32 i = 0; i < Cloud.Num(); ++i)
+        {
+            UEXYZ[i * Stride + 0] = Cloud[i].X;
+            UEXYZ[i * Stride + 1] = Cloud[i].Y;
+            UEXYZ[i * Stride + 2] = Cloud[i].Z;
+        }
+
+        MathToolkitLibrary::ConvertUEToROS(UEXYZ, ROSXYZ, Stride);
+        MathToolkitLibrary::ConvertUEToROS(Cloud, Direct, Stride);
+
+        bool bMatches = true;
+        bool bPaddingKept = true;
+        for (int32 i = 0; i < Cloud.Num(); ++i)
+        {
+            const FVector Expected = MathToolkitLibrary::ConvertUEToROS(Cloud[i]);
+            for (int32 Axis = 0; Axis < 3; ++Axis)
+            {
+                bMatches &= FMath::IsNearlyEqual(ROSXYZ[i * Stride + Axis], Expected[Axis], 1e-3);
+                bMatches &= FMath::IsNearlyEqual(Direct[i * Stride + Axis], Expected[Axis], 1e-3);
+            }
+            for (int32 Pad = 3; Pad < Stride; ++Pad)
+            {
+                bPaddingKept &= ROSXYZ[i * Stride + Pad] == -7.0f && Direct[i * Stride + Pad] == -7.0f;
+            }
+        }
+        TestTrue(FString::Printf(TEXT("Interleaved UE -> ROS with stride %d should match the per-point conversion"), Stride), bMatches);
+        TestTrue(FString::Printf(TEXT("Interleaved conversion with stride %d should not touch padding"), Stride), bPaddingKept);
+
+        // In place back to UE
+        MathToolkitLibrary::ConvertROSToUE(ROSXYZ, ROSXYZ, Stride);
+        bMatches = true;
+        for (int32 i = 0; i < ROSXYZ.Num(); ++i)
+        {
+            bMatches &= FMath::IsNearlyEqual(ROSXYZ[i], UEXYZ[i], 0.01f);
+        }
+        TestTrue(FString::Printf(TEXT("In-place ROS -> UE with stride %d should restore the cloud"), Stride), bMatches);
+    }
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFrameConversionEulerInverseTest, "MathToolkit.FrameConversion.EulerInverse",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FFrameConversionEulerInverseTest::RunTest(const FString& Parameters)
+{
+    FRandomStream Random(5);
+    bool bRoundTrips = true;
+    for (int32 i = 0; i < 200; ++i)
+    {
+        const FRotator Rotation(Random.FRandRange(-89.0f, 89.0f), Random.FRandRange(-180.0f, 180.0f), Random.FRandRange(-180.0f, 180.0f));
+        const FRotator RoundTrip = MathToolkitLibrary::ConvertROSToUEAngleDegree(MathToolkitLibrary::ConvertUEToROSAngleDegree(Rotation));
+        bRoundTrips &= RoundTrip.Equals(Rotation, 1e-3f);
+    }
+    TestTrue(TEXT("ConvertROSToUEAngleDegree should undo ConvertUEToROSAngleDegree"), bRoundTrips);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFrameConversionPoseTest, "MathToolkit.FrameConversion.Pose",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FFrameConversionPoseTest::RunTest(const FString& Parameters)
+{
+    FRandomStream Random(6);
+    TArray<FTransform> Transforms;
+    for (int32 i = 0; i < 257; ++i)
+    {
+        const FRotator Rotation(Random.FRandRange(-89.0f, 89.0f), Random.FRandRange(-180.0f, 180.0f), Random.FRandRange(-180.0f, 180.0f));
+        Transforms.Add(FTransform(Rotation, FVector(Random.FRandRange(-1e4f, 1e4f), Random.FRandRange(-1e4f, 1e4f), Random.FRandRange(-1e4f, 1e4f))));
+    }
+
+    TArray<FROSPose> Poses;
+    Poses.SetNum(Transforms.Num());
+    MathToolkitLibrary::ConvertUEToROS(Transforms, Poses);
+
+    // The ROS pose must map every mirrored UE point exactly like the UE transform does
+    bool bConsistent = true;
+    for (int32 i = 0; i < Transforms.Num(); ++i)
+    {
+        const FVector LocalPoint(Random.FRandRange(-500.0f, 500.0f), Random.FRandRange(-500.0f, 500.0f), Random.FRandRange(-500.0f, 500.0f));
+        const FVector ExpectedROS = MathToolkitLibrary::ConvertUEToROS(Transforms[i].TransformPosition(LocalPoint));
+        const FVector ActualROS = Poses[i].Orientation.RotateVector(MathToolkitLibrary::ConvertUEToROS(LocalPoint)) + Poses[i].Position;
+        bConsistent &= ActualROS.Equals(ExpectedROS, 1e-6);
+    }
+    TestTrue(TEXT("ROS pose should transform mirrored points like the UE transform"), bConsistent);
+
+    TArray<FTransform> Back;
+    Back.SetNum(Poses.Num());
+    MathToolkitLibrary::ConvertROSToUE(Poses, Back);
+    bool bRoundTrips = true;
+    for (int32 i = 0; i < Transforms.Num(); ++i)
+    {
+        bRoundTrips &= Back[i].GetTranslation().Equals(Transforms[i].GetTranslation(), 1e-6) && Back[i].GetRotation().Equals(Transforms[i].GetRotation(), 1e-9);
+    }
+    TestTrue(TEXT("ROS -> UE should restore the transforms"), bRoundTrips);
+
+    // Split arrays, in place
+    TArray<FVector> Positions;
+    TArray<FQuat> Rotations;
+    for (const FTransform& Transform : Transforms)
+    {
+        Positions.Add(Transform.GetTranslation());
+        Rotations.Add(Transform.GetRotation());
+    }
+    MathToolkitLibrary::ConvertUEToROS(Positions, Rotations, Positions, Rotations);
+    bool bMatchesPoses = true;
+    for (int32 i = 0; i < Poses.Num(); ++i)
+    {
+        bMatchesPoses &= Positions[i].Equals(Poses[i].Position, 1e-9) && Rotations[i].Equals(Poses[i].Orientation, 1e-9);
+    }
+    TestTrue(TEXT("In-place position + quaternion conversion should match the transform path"), bMatchesPoses);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFrameConversionPoseBenchmark, "MathToolkit.FrameConversion.PoseBenchmark",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FFrameConversionPoseBenchmark::RunTest(const FString& Parameters)
+{
+    const int32 NumPoses = 100000;
+    FRandomStream Random(8);
+    TArray<FTransform> Transforms;
+    Transforms.Reserve(NumPoses);
+    for (int32 i = 0; i < NumPoses; ++i)
+    {
+        const FRotator Rotation(Random.FRandRange(-89.0f, 89.0f), Random.FRandRange(-180.0f, 180.0f), Random.FRandRange(-180.0f, 180.0f));
+        Transforms.Add(FTransform(Rotation, FVector(Random.FRandRange(-1e4f, 1e4f), Random.FRandRange(-1e4f, 1e4f), Random.FRandRange(-1e4f, 1e4f))));
+    }
+    TArray<FROSPose> Poses;
+    Poses.SetNum(NumPoses);
+
+    // Current path: rotator out of the transform, Euler conversion with Fmod, quaternion for the message
+    const double PerRotatorStart = FPlatformTime::Seconds();
+    for (int32 i = 0; i < NumPoses; ++i)
+    {
+        Poses[i].Position = MathToolkitLibrary::ConvertUEToROS(Transforms[i].GetTranslation());
+        Poses[i].Orientation = MathToolkitLibrary::ConvertUEToROSAngleDegree(Transforms[i].Rotator()).Quaternion();
+    }
+    const double PerRotatorSeconds = FPlatformTime::Seconds() - PerRotatorStart;
+
+    const double BatchStart = FPlatformTime::Seconds();
+    MathToolkitLibrary::ConvertUEToROS(Transforms, Poses);
+    const double BatchSeconds = FPlatformTime::Seconds() - BatchStart;
+
+    AddInfo(FString::Printf(TEXT("Per-rotator path: %.1f ns/pose, batched quaternion path: %.1f ns/pose (%.1fx)"),
+        PerRotatorSeconds * 1e9 / NumPoses, BatchSeconds * 1e9 / NumPoses, PerRotatorSeconds / FMath::Max(BatchSeconds, 1e-12)));
+
+    return true;
+}
+
+namespace
+{
+    // Points scattered 1 km around a spot 20 km from the world origin (cm)
+    TArray<FVector> MakeFarCloud(int32 NumPoints, FRandomStream& Random)
+    {
+        const FVector Center(2e6, -1.5e6, 3e4);
+        TArray<FVector> Cloud;
+        Cloud.Reserve(NumPoints);
+        for (int32 i = 0; i < NumPoints; ++i)
+        {
+            Cloud.Add(Center + FVector(Random.FRandRange(-1e5f, 1e5f), Random.FRandRange(-1e5f, 1e5f), Random.FRandRange(-1e3f, 1e3f)));
+        }
+        return Cloud;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFrameConversionPrecisionTest, "MathToolkit.FrameConversion.Precision",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FFrameConversionPrecisionTest::RunTest(const FString& Parameters)
+{
+    FRandomStream Random(17);
+    const TArray<FVector> Cloud = MakeFarCloud(1000, Random);
+
+    // The double instantiation is the library path, and the float one follows it to float precision
+    bool bDoubleMatches = true;
+    double MaxFloatError = 0.0;
+    for (const FVector& Point : Cloud)
+    {
+        const FVector ROS = TFrameConversion<double>::UEToROS(Point);
+        bDoubleMatches &= ROS == MathToolkitLibrary::ConvertUEToROS(Point);
+        bDoubleMatches &= TFrameConversion<double>::ROSToUE(ROS).Equals(Point, 1e-9);
+        const FVector3f ROSFloat = TFrameConversion<float>::UEToROS(FVector3f(Point));
+        MaxFloatError = FMath::Max(MaxFloatError, (FVector(ROSFloat) - ROS).GetAbsMax());
+    }
+    TestTrue(TEXT("TFrameConversion<double> should match ConvertUEToROS and round-trip exactly"), bDoubleMatches);
+    // 20 km in float: the ulp of 2e6 cm is 0.25 cm, rounded once on input and once on output
+    TestTrue(TEXT("Float conversion at 20 km should lose millimetres"), MaxFloatError > 1e-4 && MaxFloatError < 4e-3);
+
+    // Rebased: local floats within 1 km stay well below a tenth of a millimetre
+    FRebasedFrame Frame;
+    TestTrue(TEXT("The far cloud should require a rebase for 0.01 cm"), Frame.RebaseIfNeeded(Cloud[0], 0.01));
+    TestFalse(TEXT("Points near the new origin should not"), Frame.RebaseIfNeeded(Cloud[1], 0.01));
+    TestEqual(TEXT("Safe radius for 0.01 cm"), FRebasedFrame::GetSafeRadius(0.01), 0.01 * 16777216.0);
+
+    TArray<FVector3f> Local;
+    Local.SetNumUninitialized(Cloud.Num());
+    Frame.ToLocal(Cloud, Local);
+    TArray<FVector> World;
+    World.SetNumUninitialized(Cloud.Num());
+    Frame.ToWorld(Local, World);
+
+    TArray<float> ROSLocal;
+    ROSLocal.SetNumUninitialized(Cloud.Num() * 4);
+    Frame.ToROSLocal(Cloud, ROSLocal, 4);
+    const FVector ROSOrigin = Frame.GetROSOrigin();
+
+    double MaxWorldError = 0.0;
+    double MaxROSError = 0.0;
+    bool bWithinBound = true;
+    for (int32 i = 0; i < Cloud.Num(); ++i)
+    {
+        const double Error = (World[i] - Cloud[i]).GetAbsMax();
+        MaxWorldError = FMath::Max(MaxWorldError, Error);
+        bWithinBound &= Error <= Frame.GetLocalError(Cloud[i]) + 1e-12;
+        bWithinBound &= Frame.ToWorld(Frame.ToLocal(Cloud[i])) == World[i];
+
+        const FVector ROS = ROSOrigin + FVector(ROSLocal[i * 4 + 0], ROSLocal[i * 4 + 1], ROSLocal[i * 4 + 2]);
+        MaxROSError = FMath::Max(MaxROSError, (ROS - MathToolkitLibrary::ConvertUEToROS(Cloud[i])).GetAbsMax());
+    }
+    TestTrue(TEXT("Rebased round trip should stay within GetLocalError"), bWithinBound);
+    TestTrue(TEXT("Rebased round trip should stay below 0.01 cm within 2 km"), MaxWorldError < 0.01);
+    TestTrue(TEXT("Rebased ROS output should stay below 0.1 mm"), MaxROSError < 1e-4);
+
+    // Depth unprojection keeps the caller's precision
+    double tanH, tanV;
+    TFrameConversion<double>::TanHalfFOV(90.0, 640, 480, tanH, tanV);
+    const std::pair<FVector, FVector> DoubleResult = TFrameConversion<double>::SphericalFromDepth(1e6, 100.25, 50.5, tanH, tanV, 640, 480);
+    const std::pair<FVector, FVector> LibraryResult = MathToolkitLibrary::CalculateSphericalFromDepth(1e6f, 100.25f, 50.5f, 90.0f, 640, 480);
+    TestTrue(TEXT("Double and float unprojection should agree to float precision"), DoubleResult.second.Equals(LibraryResult.second, 1.0));
+    TestTrue(TEXT("Double unprojection keeps the range consistent"),
+        FMath::IsNearlyEqual(DoubleResult.first.X, DoubleResult.second.Size(), 1e-8));
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFrameConversionPrecisionBenchmark, "MathToolkit.FrameConversion.PrecisionBenchmark",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FFrameConversionPrecisionBenchmark::RunTest(const FString& Parameters)
+{
+    const int32 NumPoints = 1000000;
+    FRandomStream Random(23);
+    const TArray<FVector> Cloud = MakeFarCloud(NumPoints, Random);
+    TArray<FVector3f> CloudFloat;
+    TArray<float> CloudInterleaved;
+    CloudFloat.Reserve(NumPoints);
+    CloudInterleaved.Reserve(NumPoints * 3);
+    for (const FVector& Point : Cloud)
+    {
+        CloudFloat.Add(FVector3f(Point));
+        CloudInterleaved.Add(static_cast<float>(Point.X));
+        CloudInterleaved.Add(static_cast<float>(Point.Y));
+        CloudInterleaved.Add(static_cast<float>(Point.Z));
+    }
+
+    TArray<FVector> Reference;
+    Reference.SetNumUninitialized(NumPoints);
+    const double DoubleStart = FPlatformTime::Seconds();
+    TFrameConversion<double>::UEToROS(Cloud, Reference);
+    const double DoubleSeconds = FPlatformTime::Seconds() - DoubleStart;
+
+    TArray<FVector3f> OutFloat;
+    OutFloat.SetNumUninitialized(NumPoints);
+    const double FloatStart = FPlatformTime::Seconds();
+    TFrameConversion<float>::UEToROS(CloudFloat, OutFloat);
+    const double FloatSeconds = FPlatformTime::Seconds() - FloatStart;
+
+    TArray<float> OutInterleaved;
+    OutInterleaved.SetNumUninitialized(NumPoints * 3);
+    const double InterleavedStart = FPlatformTime::Seconds();
+    MathToolkitLibrary::ConvertUEToROS(TConstArrayView<float>(CloudInterleaved), TArrayView<float>(OutInterleaved));
+    const double InterleavedSeconds = FPlatformTime::Seconds() - InterleavedStart;
+
+    const FRebasedFrame Frame(Cloud[0]);
+    TArray<float> OutRebased;
+    OutRebased.SetNumUninitialized(NumPoints * 3);
+    const double RebasedStart = FPlatformTime::Seconds();
+    Frame.ToROSLocal(Cloud, OutRebased);
+    const double RebasedSeconds = FPlatformTime::Seconds() - RebasedStart;
+
+    const FVector ROSOrigin = Frame.GetROSOrigin();
+    double FloatError = 0.0, InterleavedError = 0.0, RebasedError = 0.0;
+    for (int32 i = 0; i < NumPoints; ++i)
+    {
+        FloatError = FMath::Max(FloatError, (FVector(OutFloat[i]) - Reference[i]).GetAbsMax());
+        InterleavedError = FMath::Max(InterleavedError,
+            (FVector(OutInterleaved[i * 3 + 0], OutInterleaved[i * 3 + 1], OutInterleaved[i * 3 + 2]) - Reference[i]).GetAbsMax());
+        RebasedError = FMath::Max(RebasedError,
+            (ROSOrigin + FVector(OutRebased[i * 3 + 0], OutRebased[i * 3 + 1], OutRebased[i * 3 + 2]) - Reference[i]).GetAbsMax());
+    }
+
+    AddInfo(FString::Printf(TEXT("20 km cloud, UE -> ROS: double %.2f ns/pt; float %.2f ns/pt (max err %.3f mm); interleaved float %.2f ns/pt (max err %.3f mm); rebased float %.2f ns/pt (max err %.4f mm)"),
+        DoubleSeconds * 1e9 / NumPoints, FloatSeconds * 1e9 / NumPoints, FloatError * 1e3, InterleavedSeconds * 1e9 / NumPoints, InterleavedError * 1e3,
+        RebasedSeconds * 1e9 / NumPoints, RebasedError * 1e3));
+
+    return true;
+}
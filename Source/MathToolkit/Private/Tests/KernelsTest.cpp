@@ -0,0 +1,108 @@
+#include "Misc/AutomationTest.h"
+#include "MathToolkitKernels.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FKernelsAtan2AccuracyTest, "MathToolkit.Kernels.Atan2Accuracy",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FKernelsAtan2AccuracyTest::RunTest(const FString& Parameters)
+{
+    // Odd count so the scalar tail is exercised as well
+    const int32 Count = 100003;
+    FRandomStream Random(1234);
+
+    TArray<float> Y, X, Out;
+    Y.SetNumUninitialized(Count);
+    X.SetNumUninitialized(Count);
+    Out.SetNumUninitialized(Count);
+    for (int32 i = 0; i < Count; ++i)
+    {
+        Y[i] = Random.FRandRange(-1000.0f, 1000.0f);
+        X[i] = Random.FRandRange(-1000.0f, 1000.0f);
+    }
+    // Axes and the origin
+    Y[0] = 0.0f; X[0] = 0.0f;
+    Y[1] = 5.0f; X[1] = 0.0f;
+    Y[2] = 0.0f; X[2] = -5.0f;
+    Y[3] = -5.0f; X[3] = 0.0f;
+
+    MathToolkitKernels::Atan2(Y, X, Out);
+
+    double MaxError = 0.0;
+    for (int32 i = 0; i < Count; ++i)
+    {
+        MaxError = FMath::Max(MaxError, FMath::Abs(Out[i] - std::atan2(static_cast<double>(Y[i]), static_cast<double>(X[i]))));
+    }
+    AddInfo(FString::Printf(TEXT("%s Atan2 max error: %g rad"), MathToolkitKernels::GetSIMDPathName(), MaxError));
+    TestTrue(TEXT("Atan2 should stay within its documented error bound"), MaxError <= MathToolkitKernels::AtanMaxError);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FKernelsSinCosAccuracyTest, "MathToolkit.Kernels.SinCosAccuracy",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FKernelsSinCosAccuracyTest::RunTest(const FString& Parameters)
+{
+    const int32 Count = 100003;
+    FRandomStream Random(99);
+
+    TArray<float> Angles, Sin, Cos;
+    Angles.SetNumUninitialized(Count);
+    Sin.SetNumUninitialized(Count);
+    Cos.SetNumUninitialized(Count);
+    for (int32 i = 0; i < Count; ++i)
+    {
+        Angles[i] = Random.FRandRange(-1000.0f, 1000.0f);
+    }
+
+    MathToolkitKernels::SinCos(Angles, Sin, Cos);
+
+    double MaxError = 0.0;
+    for (int32 i = 0; i < Count; ++i)
+    {
+        MaxError = FMath::Max(MaxError, FMath::Abs(Sin[i] - std::sin(static_cast<double>(Angles[i]))));
+        MaxError = FMath::Max(MaxError, FMath::Abs(Cos[i] - std::cos(static_cast<double>(Angles[i]))));
+    }
+    AddInfo(FString::Printf(TEXT("%s SinCos max error: %g"), MathToolkitKernels::GetSIMDPathName(), MaxError));
+    TestTrue(TEXT("SinCos should stay within its documented error bound"), MaxError <= MathToolkitKernels::SinCosMaxError);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FKernelsSphericalRoundTripTest, "MathToolkit.Kernels.SphericalRoundTrip",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FKernelsSphericalRoundTripTest::RunTest(const FString& Parameters)
+{
+    const int32 Count = 4099;
+    FRandomStream Random(7);
+
+    TArray<float> X, Y, Z, Range, Azimuth, Elevation, X2, Y2, Z2;
+    for (TArray<float>* Channel : {&X, &Y, &Z, &Range, &Azimuth, &Elevation, &X2, &Y2, &Z2})
+    {
+        Channel->SetNumUninitialized(Count);
+    }
+    for (int32 i = 0; i < Count; ++i)
+    {
+        X[i] = Random.FRandRange(-5000.0f, 5000.0f);
+        Y[i] = Random.FRandRange(-5000.0f, 5000.0f);
+        Z[i] = Random.FRandRange(-5000.0f, 5000.0f);
+    }
+
+    MathToolkitKernels::CartesianToSpherical(X, Y, Z, Range, Azimuth, Elevation);
+    MathToolkitKernels::SphericalToCartesian(Range, Azimuth, Elevation, X2, Y2, Z2);
+
+    double MaxAngleError = 0.0;
+    double MaxRoundTripError = 0.0;
+    for (int32 i = 0; i < Count; ++i)
+    {
+        const double Horizontal = FMath::Sqrt(static_cast<double>(X[i]) * X[i] + static_cast<double>(Y[i]) * Y[i]);
+        MaxAngleError = FMath::Max(MaxAngleError, FMath::Abs(Azimuth[i] - std::atan2(static_cast<double>(Y[i]), static_cast<double>(X[i]))));
+        MaxAngleError = FMath::Max(MaxAngleError, FMath::Abs(Elevation[i] - std::atan2(static_cast<double>(Z[i]), Horizontal)));
+        MaxRoundTripError = FMath::Max(MaxRoundTripError, static_cast<double>(FVector3f(X[i] - X2[i], Y[i] - Y2[i], Z[i] - Z2[i]).Size()) / Range[i]);
+    }
+    TestTrue(TEXT("Spherical angles should stay within the Atan2 error bound"), MaxAngleError <= MathToolkitKernels::AtanMaxError);
+    TestTrue(TEXT("Cartesian -> spherical -> Cartesian should round trip to 1e-6 relative error"), MaxRoundTripError <= 1e-6);
+
+    return true;
+}
@@ -0,0 +1,169 @@
+#include "Misc/AutomationTest.h"
+#include "LidarDeskew.h"
+#include "MathToolkitLibrary.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLidarDeskewMotionTest, "MathToolkit.LidarDeskew.Motion",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FLidarDeskewMotionTest::RunTest(const FString& Parameters)
+{
+    // 10 Hz scan while driving at 20 m/s and turning at 0.5 rad/s (time in s, distances in cm)
+    const FLidarSpec Spec = FLidarSpec::MakeUniform(4, -15.0f, 15.0f, 1.0f);
+    const float ScanPeriod = 0.1f;
+    FLidarDeskew Deskew(Spec, ScanPeriod);
+    const int32 NumColumns = Deskew.GetNumColumns();
+    const int32 NumBeams = Spec.GetNumBeams();
+    TestTrue(TEXT("Last column fires at the scan end"), Deskew.GetColumnTimes()[NumColumns - 1] == 0.0f);
+    TestTrue(TEXT("First column fires a period earlier"), FMath::IsNearlyEqual(Deskew.GetColumnTimes()[0], -ScanPeriod * (NumColumns - 1) / NumColumns, 1e-7));
+
+    const FVector Velocity(2000.0, 150.0, 0.0);
+    const FVector AngularVelocity(0.0, 0.0, 0.5);
+
+    // Static points in the scan-end frame, seen by the moving sensor at each column's time
+    FRandomStream Random(17);
+    TArray<FVector> Expected;
+    TArray<float> X, Y, Z;
+    for (int32 Beam = 0; Beam < NumBeams; ++Beam)
+    {
+        const FVector End(Random.FRandRange(-5000.0f, 5000.0f), Random.FRandRange(-5000.0f, 5000.0f), Random.FRandRange(-300.0f, 300.0f));
+        const double Time = Deskew.GetColumnTimes()[Beam % NumColumns];
+        const FQuat Delta(AngularVelocity.GetSafeNormal(), AngularVelocity.Size() * Time);
+        const FVector Seen = Delta.UnrotateVector(End - Velocity * Time);
+        Expected.Add(End);
+        X.Add(static_cast<float>(Seen.X));
+        Y.Add(static_cast<float>(Seen.Y));
+        Z.Add(static_cast<float>(Seen.Z));
+    }
+
+    double SkewedError = 0.0;
+    for (int32 Beam = 0; Beam < NumBeams; ++Beam)
+    {
+        SkewedError = FMath::Max(SkewedError, (FVector(X[Beam], Y[Beam], Z[Beam]) - Expected[Beam]).Size());
+    }
+
+    Deskew.SetMotion(Velocity, AngularVelocity);
+    Deskew.Apply(X, Y, Z);
+    double MaxError = 0.0;
+    for (int32 Beam = 0; Beam < NumBeams; ++Beam)
+    {
+        MaxError = FMath::Max(MaxError, (FVector(X[Beam], Y[Beam], Z[Beam]) - Expected[Beam]).Size());
+    }
+    AddInfo(FString::Printf(TEXT("Max error before de-skew %.1f cm, after %.4f cm"), SkewedError, MaxError));
+    TestTrue(TEXT("The scan is visibly skewed"), SkewedError > 100.0);
+    TestTrue(TEXT("De-skewed points land in the scan-end frame"), MaxError < 0.05);
+
+    // A world-frame fit slope is rotated into the sensor frame
+    const FQuat SensorRotation(FVector(0.0, 0.0, 1.0), UE_PI / 2);
+    FLidarDeskew FromFit(Spec, ScanPeriod);
+    FromFit.SetMotionFromFit(SensorRotation.RotateVector(Velocity), SensorRotation, AngularVelocity);
+    TArray<float> FX, FY, FZ;
+    FX.Init(100.0f, NumBeams);
+    FY.Init(0.0f, NumBeams);
+    FZ.Init(0.0f, NumBeams);
+    TArray<float> DX = FX, DY = FY, DZ = FZ;
+    FromFit.Apply(FX, FY, FZ);
+    Deskew.Apply(DX, DY, DZ);
+    TestTrue(TEXT("SetMotionFromFit matches SetMotion in the sensor frame"),
+        FVector(FX[0], FY[0], FZ[0]).Equals(FVector(DX[0], DY[0], DZ[0]), 1e-3));
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLidarDeskewRangesTest, "MathToolkit.LidarDeskew.Ranges",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FLidarDeskewRangesTest::RunTest(const FString& Parameters)
+{
+    // Odd column count so the scalar tail of every row runs too
+    const FLidarSpec Spec = FLidarSpec::MakeUniform(3, -10.0f, 10.0f, 360.0f / 37);
+    FLidarDeskew Deskew(Spec, 0.1f);
+    Deskew.SetMotion(FVector(1000.0, -300.0, 20.0), FVector(0.05, 0.0, -0.8));
+    const int32 NumBeams = Spec.GetNumBeams();
+
+    TArray<float> Azimuth, Elevation, Range;
+    Azimuth.SetNumUninitialized(NumBeams);
+    Elevation.SetNumUninitialized(NumBeams);
+    Spec.CalculateBeamAngles(Azimuth, Elevation);
+    FRandomStream Random(3);
+    for (int32 Beam = 0; Beam < NumBeams; ++Beam)
+    {
+        Range.Add(Beam % 5 == 0 ? 0.0f : Random.FRandRange(100.0f, 8000.0f));
+    }
+
+    // Fused conversion versus spherical -> Cartesian followed by Apply
+    TArray<float> X, Y, Z, RX, RY, RZ;
+    for (TArray<float>* Channel : {&X, &Y, &Z, &RX, &RY, &RZ})
+    {
+        Channel->SetNumUninitialized(NumBeams);
+    }
+    Deskew.ConvertRanges(Range, X, Y, Z);
+    for (int32 Beam = 0; Beam < NumBeams; ++Beam)
+    {
+        RX[Beam] = Range[Beam] * FMath::Cos(Elevation[Beam]) * FMath::Cos(Azimuth[Beam]);
+        RY[Beam] = Range[Beam] * FMath::Cos(Elevation[Beam]) * FMath::Sin(Azimuth[Beam]);
+        RZ[Beam] = Range[Beam] * FMath::Sin(Elevation[Beam]);
+    }
+    Deskew.Apply(RX, RY, RZ);
+
+    double MaxError = 0.0;
+    for (int32 Beam = 0; Beam < NumBeams; ++Beam)
+    {
+        if (Range[Beam] <= 0.0f)
+        {
+            TestTrue(TEXT("Missing returns stay at the origin"), X[Beam] == 0.0f && Y[Beam] == 0.0f && Z[Beam] == 0.0f);
+            continue;
+        }
+        MaxError = FMath::Max(MaxError, (FVector(X[Beam], Y[Beam], Z[Beam]) - FVector(RX[Beam], RY[Beam], RZ[Beam])).Size());
+    }
+    TestTrue(FString::Printf(TEXT("Fused conversion matches the two-pass path (max error %g cm)"), MaxError), MaxError < 0.01);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLidarDeskewColumnTimesTest, "MathToolkit.LidarDeskew.ColumnTimes",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FLidarDeskewColumnTimesTest::RunTest(const FString& Parameters)
+{
+    const FLidarSpec Spec = FLidarSpec::MakeUniform(2, -5.0f, 5.0f, 90.0f);
+    FLidarDeskew Deskew(Spec, 0.1f);
+    const int32 NumColumns = Deskew.GetNumColumns();
+    const int32 NumBeams = Spec.GetNumBeams();
+    const FVector Velocity(100.0, 0.0, 0.0);
+    const FVector AngularVelocity(0.0, 0.0, 0.3);
+    Deskew.SetMotion(Velocity, AngularVelocity);
+
+    // Custom times set after the motion must rebuild the transforms
+    TArray<float> Times;
+    for (int32 Column = 0; Column < NumColumns; ++Column)
+    {
+        Times.Add(-0.02f * Column);
+    }
+    Deskew.SetColumnTimes(Times);
+
+    TArray<float> X, Y, Z;
+    X.Init(500.0f, NumBeams);
+    Y.Init(-200.0f, NumBeams);
+    Z.Init(30.0f, NumBeams);
+    Deskew.Apply(X, Y, Z);
+    for (int32 Beam = 0; Beam < NumBeams; ++Beam)
+    {
+        const double Time = Times[Beam % NumColumns];
+        const FVector Expected = FQuat(FVector(0.0, 0.0, 1.0), AngularVelocity.Z * Time).RotateVector(FVector(500.0, -200.0, 30.0)) + Velocity * Time;
+        TestTrue(FString::Printf(TEXT("Beam %d uses its custom column time"), Beam), FVector(X[Beam], Y[Beam], Z[Beam]).Equals(Expected, 1e-3));
+    }
+
+    // All columns at the scan end: nothing moves
+    Times.Init(0.0f, NumColumns);
+    Deskew.SetColumnTimes(Times);
+    X.Init(500.0f, NumBeams);
+    Y.Init(-200.0f, NumBeams);
+    Z.Init(30.0f, NumBeams);
+    Deskew.Apply(X, Y, Z);
+    for (int32 Beam = 0; Beam < NumBeams; ++Beam)
+    {
+        TestTrue(FString::Printf(TEXT("Beam %d at the scan end is unchanged"), Beam), FVector(X[Beam], Y[Beam], Z[Beam]).Equals(FVector(500.0, -200.0, 30.0), 1e-4));
+    }
+
+    return true;
+}
@@ -0,0 +1,97 @@
+#include "Misc/AutomationTest.h"
+#include "LidarResampler.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLidarResamplerCoverageTest, "MathToolkit.LidarResampler.Coverage",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FLidarResamplerCoverageTest::RunTest(const FString& Parameters)
+{
+    // Four 90 degree cameras around the sensor, each looking at a wall 10 m away in planar depth
+    const uint32 width = 256;
+    const uint32 height = 256;
+    const float WallDepth = 1000.0f;
+    const FLidarSpec Spec = FLidarSpec::MakeUniform(16, -15.0f, 15.0f, 1.0f);
+
+    TArray<float> Depth;
+    Depth.Init(WallDepth, width * height);
+
+    TArray<float> Range;
+    Range.Init(-1.0f, Spec.GetNumBeams());
+
+    int32 CoveredBeams = 0;
+    for (float Yaw : { 0.0f, 90.0f, 180.0f, -90.0f })
+    {
+        const FLidarResampler Resampler(Spec, 90.0f, width, height, Yaw);
+        CoveredBeams += Resampler.GetNumBeams();
+        Resampler.Resample(Depth, Range);
+    }
+    TestEqual(TEXT("Four cameras should cover every beam exactly once"), CoveredBeams, Spec.GetNumBeams());
+    AddInfo(FString::Printf(TEXT("%d beams from %d depth pixels"), CoveredBeams, static_cast<int32>(4 * width * height)));
+
+    TArray<float> Azimuth, Elevation;
+    Azimuth.SetNumUninitialized(Spec.GetNumBeams());
+    Elevation.SetNumUninitialized(Spec.GetNumBeams());
+    Spec.CalculateBeamAngles(Azimuth, Elevation);
+
+    // Every beam hits the wall of its own camera: range = depth / (cos el * cos(az relative to that camera))
+    int32 Mismatches = 0;
+    for (int32 Beam = 0; Beam < Spec.GetNumBeams(); ++Beam)
+    {
+        const float Relative = FMath::Fmod(Azimuth[Beam] + 2.0f * PI + 0.25f * PI, 0.5f * PI) - 0.25f * PI;
+        const float Expected = WallDepth / (FMath::Cos(Elevation[Beam]) * FMath::Cos(Relative));
+        Mismatches += FMath::IsNearlyEqual(Range[Beam], Expected, Expected * 1e-4f) ? 0 : 1;
+    }
+    TestEqual(TEXT("Resampled ranges should match the analytic wall distance"), Mismatches, 0);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLidarResamplerInterpolationTest, "MathToolkit.LidarResampler.Interpolation",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FLidarResamplerInterpolationTest::RunTest(const FString& Parameters)
+{
+    const uint32 width = 128;
+    const uint32 height = 64;
+    const FLidarSpec Spec = FLidarSpec::MakeUniform(8, -10.0f, 10.0f, 0.7f);
+    const FLidarResampler Resampler(Spec, 90.0f, width, height);
+
+    // Depth ramps smoothly across columns in the left half and jumps to a far background on the right
+    TArray<float> Depth;
+    Depth.SetNumUninitialized(width * height);
+    for (uint32 y = 0; y < height; ++y)
+    {
+        for (uint32 x = 0; x < width; ++x)
+        {
+            Depth[y * width + x] = x < width / 2 ? 500.0f + 0.5f * x : 4000.0f;
+        }
+    }
+    Depth[10 * width + 10] = 0.0f;   // a missing return
+
+    TArray<float> Range, Azimuth, Elevation;
+    Range.Init(-1.0f, Spec.GetNumBeams());
+    Azimuth.SetNumUninitialized(Spec.GetNumBeams());
+    Elevation.SetNumUninitialized(Spec.GetNumBeams());
+    Spec.CalculateBeamAngles(Azimuth, Elevation);
+    Resampler.Resample(Depth, Range);
+
+    int32 MixedPoints = 0;
+    int32 Covered = 0;
+    for (int32 Beam = 0; Beam < Spec.GetNumBeams(); ++Beam)
+    {
+        if (Range[Beam] < 0.0f)
+        {
+            continue;
+        }
+        ++Covered;
+        // Planar depth back from the range; it must be on the ramp or the background, never in between
+        const float BeamDepth = Range[Beam] * FMath::Cos(Elevation[Beam]) * FMath::Cos(Azimuth[Beam]);
+        const bool bOnRamp = BeamDepth >= 499.0f && BeamDepth <= 500.0f + 0.5f * width / 2 + 1.0f;
+        const bool bBackground = FMath::IsNearlyEqual(BeamDepth, 4000.0f, 1.0f);
+        MixedPoints += (bOnRamp || bBackground || Range[Beam] == 0.0f) ? 0 : 1;
+    }
+    TestEqual(TEXT("Every covered beam should be written"), Covered, Resampler.GetNumBeams());
+    TestEqual(TEXT("No beam should interpolate across the depth edge"), MixedPoints, 0);
+
+    return true;
+}
@@ -1,6 +1,8 @@
 #include "Misc/AutomationTest.h"
 #include "MathToolkitLibrary.h"
 #include "CircularBufferMT.h"
+#include "StreamingLinearFitMT.h"
+#include "MultiTrackLinearFitMT.h"
 
 IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLinearFitBasicTest, "MathToolkit.LinearFit.Basic",
     EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
@@ -92,3 +94,216 @@ bool FLinearFitPerfectLineTest::RunTest(const FString& Parameters)
 
     return true;
 }
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLinearFitStreamingMatchesBatchTest, "MathToolkit.LinearFit.StreamingMatchesBatch",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FLinearFitStreamingMatchesBatchTest::RunTest(const FString& Parameters)
+{
+    StreamingLinearFitMT<16> streaming;
+    FRandomStream random(21);
+
+    uint32 timestamp = 1000;
+    bool bMatches = true;
+    for (int32 i = 0; i < 500; ++i)
+    {
+        timestamp += 10 + random.RandRange(0, 5);
+        const FVector value(3.0f * timestamp + random.FRandRange(-5.0f, 5.0f), -0.5f * timestamp, random.FRandRange(-100.0f, 100.0f));
+        streaming.put(value, timestamp);
+
+        FVector stream_a, stream_b, batch_a, batch_b;
+        streaming.get_fit(stream_a, stream_b);
+        MathToolkitLibrary::calculateLinearFit(streaming.get_buffer(), batch_a, batch_b, false);
+
+        bMatches &= stream_a.Equals(batch_a, 1e-6) && stream_b.Equals(batch_b, 1e-2);
+    }
+    TestTrue(TEXT("Streaming fit should match calculateLinearFit after every put"), bMatches);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLinearFitStreamingLargeTimestampTest, "MathToolkit.LinearFit.StreamingLargeTimestamp",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FLinearFitStreamingLargeTimestampTest::RunTest(const FString& Parameters)
+{
+    // Timestamps near the top of the uint32 range, velocity 0.25 units per tick
+    StreamingLinearFitMT<64> streaming(1000000);
+    const uint32 start = 4000000000u;
+    for (uint32 i = 0; i < 5000; ++i)
+    {
+        const uint32 timestamp = start + i * 3;
+        streaming.put(FVector(0.25 * (timestamp - start) + 7.0, 1.0, -2.0), timestamp);
+    }
+
+    FVector fit_a, fit_b;
+    streaming.get_fit(fit_a, fit_b);
+    TestTrue(TEXT("Slope should stay exact with large timestamps and no re-sum"),
+        FMath::IsNearlyEqual(fit_a.X, 0.25, 1e-9) &&
+        FMath::IsNearlyZero(fit_a.Y, 1e-9) &&
+        FMath::IsNearlyZero(fit_a.Z, 1e-9));
+
+    const uint32 last = start + 4999 * 3;
+    TestTrue(TEXT("Fit should reproduce the newest sample"),
+        FMath::IsNearlyEqual(fit_a.X * last + fit_b.X, 0.25 * (last - start) + 7.0, 1e-3));
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLinearFitMultiTrackTest, "MathToolkit.LinearFit.MultiTrack",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FLinearFitMultiTrackTest::RunTest(const FString& Parameters)
+{
+    const int32 num_tracks = 300;
+    MultiTrackLinearFitMT<8> tracks(16);
+    TArray<CircularBufferMT<TPair<FVector, uint32>, 8>> buffers;
+    FRandomStream random(3);
+
+    for (int32 track = 0; track < num_tracks; ++track)
+    {
+        TestEqual(TEXT("Tracks should be numbered in order"), tracks.add_track(), track);
+        buffers.Add(CircularBufferMT<TPair<FVector, uint32>, 8>());
+    }
+
+    // Tracks get a different number of samples, so windows are empty, partial, full and wrapped
+    for (int32 track = 0; track < num_tracks; ++track)
+    {
+        uint32 timestamp = 100000u + track * 1000;
+        const int32 num_samples = track % 20;
+        for (int32 i = 0; i < num_samples; ++i)
+        {
+            timestamp += 5 + random.RandRange(0, 3);
+            const FVector value(random.FRandRange(-1e3f, 1e3f), 2.0 * i, random.FRandRange(-1.0f, 1.0f));
+            tracks.put(track, value, timestamp);
+            buffers[track].put(TPair<FVector, uint32>(value, timestamp));
+        }
+    }
+
+    TArray<FVector> fit_a, fit_b;
+    fit_a.SetNum(num_tracks);
+    fit_b.SetNum(num_tracks);
+    for (bool bParallel : {false, true})
+    {
+        tracks.fit_all(fit_a, fit_b, bParallel);
+
+        bool bMatches = true;
+        for (int32 track = 0; track < num_tracks; ++track)
+        {
+            FVector expected_a, expected_b;
+            MathToolkitLibrary::calculateLinearFit(buffers[track], expected_a, expected_b, false);
+            bMatches &= fit_a[track].Equals(expected_a, 1e-6) && fit_b[track].Equals(expected_b, 1e-6 * FMath::Max(1.0, expected_b.Size()));
+        }
+        TestTrue(bParallel ? TEXT("Parallel multi-track fit should match calculateLinearFit") : TEXT("Multi-track fit should match calculateLinearFit"), bMatches);
+    }
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLinearFitMultiTrackBenchmark, "MathToolkit.LinearFit.MultiTrackBenchmark",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FLinearFitMultiTrackBenchmark::RunTest(const FString& Parameters)
+{
+    const int32 num_tracks = 10000;
+    MultiTrackLinearFitMT<16> tracks(num_tracks);
+    for (int32 track = 0; track < num_tracks; ++track)
+    {
+        tracks.add_track();
+    }
+
+    TArray<FVector> positions;
+    positions.SetNum(num_tracks);
+    for (uint32 tick = 0; tick < 16; ++tick)
+    {
+        for (int32 track = 0; track < num_tracks; ++track)
+        {
+            positions[track] = FVector(track + 3.0 * tick, track - 1.0 * tick, 0.5 * tick);
+        }
+        tracks.put_all(positions, 1000 + tick * 16);
+    }
+
+    TArray<FVector> fit_a, fit_b;
+    fit_a.SetNum(num_tracks);
+    fit_b.SetNum(num_tracks);
+    for (bool bParallel : {false, true})
+    {
+        const int32 iterations = 20;
+        const double start = FPlatformTime::Seconds();
+        for (int32 i = 0; i < iterations; ++i)
+        {
+            tracks.fit_all(fit_a, fit_b, bParallel);
+        }
+        const double milliseconds = (FPlatformTime::Seconds() - start) * 1000.0 / iterations;
+        AddInfo(FString::Printf(TEXT("%d tracks x 16 samples, %s: %.3f ms per fit_all"), num_tracks, bParallel ? TEXT("parallel") : TEXT("single thread"), milliseconds));
+    }
+    TestTrue(TEXT("Slope of the benchmark tracks should be recovered"), FMath::IsNearlyEqual(fit_a[num_tracks - 1].X, 3.0 / 16.0, 1e-9));
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLinearFitModelsTest, "MathToolkit.LinearFit.Models",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FLinearFitModelsTest::RunTest(const FString& Parameters)
+{
+    typedef TPair<FVector, uint32> Sample;
+
+    // Perfect line y = 2x + 1 with one wild outlier near the end
+    CircularBufferMT<Sample, 9> buffer;
+    for (uint32 i = 0; i < 9; ++i)
+    {
+        const double y = (i == 7) ? 500.0 : 2.0 * i + 1.0;
+        buffer.put(Sample(FVector(y, 2.0 * i + 1.0, -3.0 * i), 1000000 + i));
+    }
+
+    FVector fit_a, fit_b;
+    MathToolkitLibrary::calculateWeightedLinearFit(buffer, [](const Sample& elem) { return elem.Key.X > 100.0 ? 0.0 : 1.0; }, fit_a, fit_b);
+    TestTrue(TEXT("Zero weight should remove the outlier"),
+        FMath::IsNearlyEqual(fit_a.X, 2.0, 1e-9) && FMath::IsNearlyEqual(fit_a.X * 1000004 + fit_b.X, 9.0, 1e-6));
+
+    MathToolkitLibrary::calculateDecayedLinearFit(buffer, 2.0, fit_a, fit_b);
+    TestTrue(TEXT("Decayed fit should reproduce an exact line"),
+        FMath::IsNearlyEqual(fit_a.Y, 2.0, 1e-9) && FMath::IsNearlyEqual(fit_a.Z, -3.0, 1e-9));
+
+    FVector plain_a, plain_b;
+    MathToolkitLibrary::calculateLinearFit(buffer, plain_a, plain_b);
+    MathToolkitLibrary::calculateRobustLinearFit(buffer, 1.0, fit_a, fit_b, 20);
+    TestTrue(TEXT("Robust fit should be much closer to the true slope than least squares"),
+        FMath::Abs(fit_a.X - 2.0) < 0.1 * FMath::Abs(plain_a.X - 2.0));
+    TestTrue(TEXT("Robust fit should keep clean axes exact"), FMath::IsNearlyEqual(fit_a.Y, 2.0, 1e-6));
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLinearFitQuadraticTest, "MathToolkit.LinearFit.Quadratic",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FLinearFitQuadraticTest::RunTest(const FString& Parameters)
+{
+    // Constant acceleration of 0.5 per tick^2 along X, with large timestamps
+    CircularBufferMT<TPair<FVector, uint32>, 32> buffer;
+    const uint32 start = 3000000000u;
+    for (uint32 i = 0; i < 40; ++i)
+    {
+        const double t = i * 2.0;
+        buffer.put(TPair<FVector, uint32>(FVector(0.25 * t * t + 3.0 * t + 10.0, 5.0 * t, 7.0), start + i * 2));
+    }
+
+    FVector fit_a2, fit_a1, fit_a0;
+    MathToolkitLibrary::calculateQuadraticFit(buffer, fit_a2, fit_a1, fit_a0);
+
+    const double newest = 39 * 2.0;
+    TestTrue(TEXT("Acceleration should be recovered"), FMath::IsNearlyEqual(2.0 * fit_a2.X, 0.5, 1e-9));
+    TestTrue(TEXT("Velocity at the newest sample should be recovered"), FMath::IsNearlyEqual(fit_a1.X, 0.5 * newest + 3.0, 1e-7));
+    TestTrue(TEXT("Position at the newest sample should be recovered"), FMath::IsNearlyEqual(fit_a0.X, 0.25 * newest * newest + 3.0 * newest + 10.0, 1e-6));
+    TestTrue(TEXT("Linear and constant axes should have no acceleration"), FMath::IsNearlyZero(fit_a2.Y, 1e-9) && FMath::IsNearlyZero(fit_a2.Z, 1e-9));
+
+    CircularBufferMT<TPair<FVector, uint32>, 4> short_buffer;
+    short_buffer.put(TPair<FVector, uint32>(FVector(1.0), 0));
+    short_buffer.put(TPair<FVector, uint32>(FVector(2.0), 1));
+    MathToolkitLibrary::calculateQuadraticFit(short_buffer, fit_a2, fit_a1, fit_a0);
+    TestTrue(TEXT("Two samples are not enough for a quadratic fit"), fit_a2.IsNearlyZero() && fit_a1.IsNearlyZero() && fit_a0.IsNearlyZero());
+
+    return true;
+}
@@ -0,0 +1,122 @@
+#include "Misc/AutomationTest.h"
+#include "LockFreeRingBufferMT.h"
+
+#include <thread>
+#include <vector>
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpscRingBufferBasicTest, "MathToolkit.LockFreeRingBuffer.SpscBasic",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FSpscRingBufferBasicTest::RunTest(const FString& Parameters)
+{
+    SpscRingBufferMT<int32, 4> buffer;
+    int32 value = 0;
+
+    TestTrue(TEXT("Buffer should be empty initially"), buffer.empty());
+    TestFalse(TEXT("Pop from an empty buffer should fail"), buffer.try_pop(value));
+
+    for(int32 i = 1; i <= 4; ++i) {
+        TestTrue(FString::Printf(TEXT("Push %d should succeed"), i), buffer.try_push(i));
+    }
+    TestFalse(TEXT("Push into a full buffer should be rejected"), buffer.try_push(5));
+
+    TestTrue(TEXT("Pop should succeed"), buffer.try_pop(value));
+    TestEqual(TEXT("Oldest element should come out first"), value, 1);
+    TestTrue(TEXT("Push after a pop should succeed"), buffer.try_push(5));
+
+    TArray<int32> drained;
+    drained.SetNumZeroed(8);
+    TestEqual(TEXT("Drain should return every remaining element"), static_cast<int32>(buffer.drain_into(drained)), 4);
+    TestEqual(TEXT("Drain should preserve order"), drained[0], 2);
+    TestEqual(TEXT("Drain should preserve order"), drained[3], 5);
+    TestTrue(TEXT("Buffer should be empty after drain"), buffer.empty());
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpscRingBufferThreadedTest, "MathToolkit.LockFreeRingBuffer.SpscThreaded",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FSpscRingBufferThreadedTest::RunTest(const FString& Parameters)
+{
+    const int32 count = 200000;
+    SpscRingBufferMT<int32, 256> buffer;
+
+    std::thread producer([&buffer, count]() {
+        for(int32 i = 0; i < count; ) {
+            if (buffer.try_push(i)) {
+                ++i;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    int32 expected = 0;
+    bool bInOrder = true;
+    while (expected < count) {
+        const size_t drained = buffer.drain([&](int32 value) {
+            bInOrder &= value == expected;
+            ++expected;
+        });
+        if (drained == 0) {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+
+    TestTrue(TEXT("Consumer should see every item exactly once, in order"), bInOrder);
+    TestTrue(TEXT("Buffer should be empty at the end"), buffer.empty());
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMpscRingBufferThreadedTest, "MathToolkit.LockFreeRingBuffer.MpscThreaded",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMpscRingBufferThreadedTest::RunTest(const FString& Parameters)
+{
+    const int32 num_producers = 4;
+    const int32 per_producer = 50000;
+    MpscRingBufferMT<TPair<int32, int32>, 128> buffer;
+
+    std::vector<std::thread> producers;
+    for(int32 p = 0; p < num_producers; ++p) {
+        producers.emplace_back([&buffer, p, per_producer]() {
+            for(int32 i = 0; i < per_producer; ) {
+                if (buffer.try_push(TPair<int32, int32>(p, i))) {
+                    ++i;
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    // Items from one producer must arrive in the order that producer pushed them
+    TArray<int32> next_expected;
+    next_expected.SetNumZeroed(num_producers);
+    int32 received = 0;
+    bool bPerProducerOrder = true;
+    TPair<int32, int32> item;
+    while (received < num_producers * per_producer) {
+        if (buffer.try_pop(item)) {
+            bPerProducerOrder &= item.Value == next_expected[item.Key];
+            next_expected[item.Key] = item.Value + 1;
+            ++received;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    for (std::thread& producer : producers) {
+        producer.join();
+    }
+
+    TestTrue(TEXT("Each producer's items should arrive in order"), bPerProducerOrder);
+    for(int32 p = 0; p < num_producers; ++p) {
+        TestEqual(FString::Printf(TEXT("Producer %d should deliver every item"), p), next_expected[p], per_producer);
+    }
+    TestTrue(TEXT("Buffer should be empty at the end"), buffer.empty());
+
+    return true;
+}
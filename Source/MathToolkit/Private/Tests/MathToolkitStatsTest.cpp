@@ -0,0 +1,93 @@
+#include "Misc/AutomationTest.h"
+#include "MathToolkitStats.h"
+#include "MathToolkitLibrary.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMathToolkitStatsHistogramTest, "MathToolkit.Stats.Histogram",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMathToolkitStatsHistogramTest::RunTest(const FString& Parameters)
+{
+    TestEqual(TEXT("Zero lands in the first bucket"), FMathToolkitLatencyHistogram::GetBucket(0), 0);
+    TestEqual(TEXT("1 ns lands in the first bucket"), FMathToolkitLatencyHistogram::GetBucket(1), 0);
+    TestEqual(TEXT("1023 ns lands in bucket 9"), FMathToolkitLatencyHistogram::GetBucket(1023), 9);
+    TestEqual(TEXT("1024 ns lands in bucket 10"), FMathToolkitLatencyHistogram::GetBucket(1024), 10);
+    TestEqual(TEXT("Huge samples clamp to the top bucket"), FMathToolkitLatencyHistogram::GetBucket(~0ull), FMathToolkitLatencyHistogram::NumBuckets - 1);
+
+    FMathToolkitLatencyHistogram Histogram;
+    TestEqual(TEXT("Empty histogram has no percentile"), Histogram.GetPercentileNanoseconds(0.5), uint64(0));
+
+    // 90 fast samples around 1 us and 10 slow ones around 1 ms
+    for (int32 i = 0; i < 90; ++i)
+    {
+        Histogram.Add(1000);
+    }
+    for (int32 i = 0; i < 10; ++i)
+    {
+        Histogram.Add(1000000);
+    }
+    TestEqual(TEXT("Count"), Histogram.GetCount(), uint64(100));
+    TestEqual(TEXT("Max"), Histogram.GetMaxNanoseconds(), uint64(1000000));
+    TestTrue(TEXT("Mean"), FMath::IsNearlyEqual(Histogram.GetMeanNanoseconds(), 100900.0, 1e-6));
+
+    const uint64 P50 = Histogram.GetPercentileNanoseconds(0.5);
+    const uint64 P99 = Histogram.GetPercentileNanoseconds(0.99);
+    TestTrue(TEXT("p50 bounds the fast samples within a factor of two"), P50 >= 1000 && P50 < 2000);
+    TestTrue(TEXT("p99 bounds the slow samples within a factor of two"), P99 >= 1000000 && P99 < 2000000);
+
+    Histogram.Reset();
+    TestEqual(TEXT("Reset clears the count"), Histogram.GetCount(), uint64(0));
+    TestEqual(TEXT("Reset clears the max"), Histogram.GetMaxNanoseconds(), uint64(0));
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMathToolkitStatsWindowTest, "MathToolkit.Stats.Window",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMathToolkitStatsWindowTest::RunTest(const FString& Parameters)
+{
+    FMathToolkitStats& Stats = FMathToolkitStats::Get();
+    const double Interval = Stats.GetReportInterval();
+    Stats.SetReportInterval(0.0);
+    Stats.Reset();
+
+    Stats.AddCount(EMathToolkitCounter::FitsComputed, 3);
+    Stats.AddLatency(EMathToolkitTimer::Fit, 4000);
+    TestFalse(TEXT("A zero interval disables reporting"), Stats.MaybeReport());
+    for (int32 i = 0; i < 3; ++i)
+    {
+        TestFalse(TEXT("A zero interval disables fit reports"), Stats.ReportFit(FVector(1.0, 2.0, 3.0), FVector::ZeroVector));
+    }
+
+    // Intervals under a second are honoured as set
+    Stats.SetReportInterval(0.001);
+    Stats.ReportFit(FVector(1.0, 2.0, 3.0), FVector::ZeroVector);
+    for (const double Start = FPlatformTime::Seconds(); FPlatformTime::Seconds() - Start < 0.002;)
+    {
+    }
+    TestTrue(TEXT("A 1 ms interval reports again after 2 ms"), Stats.ReportFit(FVector(1.0, 2.0, 3.0), FVector::ZeroVector));
+    Stats.SetReportInterval(0.0);
+
+    const FString Summary = Stats.Flush();
+    TestTrue(TEXT("Summary lists the counter"), Summary.Contains(TEXT("FitsComputed 3;")));
+    TestTrue(TEXT("Summary lists the timed section"), Summary.Contains(TEXT("Fit n=1")));
+    TestEqual(TEXT("Flush restarts the counters"), Stats.GetCount(EMathToolkitCounter::FitsComputed), uint64(0));
+    TestEqual(TEXT("Flush restarts the histograms"), Stats.GetHistogram(EMathToolkitTimer::Fit).GetCount(), uint64(0));
+
+    // Work done through the library only shows up when the hooks are compiled in
+    TArray<float> Depth;
+    Depth.Init(500.0f, 16 * 8);
+    TArray<float> X;
+    X.SetNumUninitialized(Depth.Num());
+    FDepthPointCloudSoA Out;
+    Out.X = X;
+    MathToolkitLibrary::CalculatePointCloudFromDepth(Depth, 90.0f, 16, 8, Out);
+    TestEqual(TEXT("Points converted"), Stats.GetCount(EMathToolkitCounter::PointsConverted),
+        uint64(MATHTOOLKIT_ENABLE_INSTRUMENTATION ? Depth.Num() : 0));
+    TestEqual(TEXT("Depth conversion samples"), Stats.GetHistogram(EMathToolkitTimer::DepthConversion).GetCount(),
+        uint64(MATHTOOLKIT_ENABLE_INSTRUMENTATION ? 1 : 0));
+
+    Stats.Reset();
+    Stats.SetReportInterval(Interval);
+    return true;
+}
@@ -0,0 +1,190 @@
+#include "Misc/AutomationTest.h"
+#include "PointCloud2Writer.h"
+#include "MathToolkitLibrary.h"
+
+namespace
+{
+    float ReadFloat(const FPointCloud2Buffer& Buffer, int32 Point, uint32 Offset)
+    {
+        float Value;
+        FMemory::Memcpy(&Value, Buffer.Data.GetData() + Point * Buffer.PointStep + Offset, sizeof(float));
+        return Value;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPointCloud2WriterLayoutTest, "MathToolkit.PointCloud2Writer.Layout",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FPointCloud2WriterLayoutTest::RunTest(const FString& Parameters)
+{
+    const FPointCloud2Layout XYZ;
+    TestEqual(TEXT("XYZ point step"), XYZ.GetPointStep(), uint32(12));
+    TestEqual(TEXT("XYZ fields"), XYZ.GetFields().Num(), 3);
+
+    const FPointCloud2Layout Full(true, true, true, true);
+    const TArray<FPointCloud2Field> Fields = Full.GetFields();
+    TestEqual(TEXT("Full point step"), Full.GetPointStep(), uint32(28));
+    TestEqual(TEXT("Full fields"), Fields.Num(), 7);
+    for (int32 i = 0; i < Fields.Num(); ++i)
+    {
+        TestEqual(FString::Printf(TEXT("Offset of %s"), Fields[i].Name), Fields[i].Offset, uint32(i * sizeof(float)));
+        TestEqual(FString::Printf(TEXT("Datatype of %s"), Fields[i].Name), Fields[i].Datatype, FPointCloud2Field::Float32);
+    }
+
+    const FPointCloud2Layout RangeIntensity(true, false, false, true);
+    const TArray<FPointCloud2Field> Sparse = RangeIntensity.GetFields();
+    TestEqual(TEXT("Intensity follows range when the angles are off"), Sparse[4].Offset, uint32(16));
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPointCloud2WriterDepthFrameTest, "MathToolkit.PointCloud2Writer.DepthFrame",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FPointCloud2WriterDepthFrameTest::RunTest(const FString& Parameters)
+{
+    const uint32 Width = 32;
+    const uint32 Height = 24;
+    const float FOVH = 90.0f;
+    const FDepthRayLUT LUT(FOVH, Width, Height);
+    float TanH, TanV;
+    MathToolkitLibrary::CalculateTanHalfFOV(FOVH, Width, Height, TanH, TanV);
+
+    TArray<float> Depth, Intensity;
+    FRandomStream Random(7);
+    for (uint32 i = 0; i < Width * Height; ++i)
+    {
+        Depth.Add(i % 11 == 0 ? 0.0f : Random.FRandRange(50.0f, 5000.0f));
+        Intensity.Add(static_cast<float>(i));
+    }
+
+    const FPointCloud2Layout Layout(true, true, true, true);
+    FPointCloud2Writer Writer(Layout, Depth.Num());
+    for (bool bOrganized : {true, false})
+    {
+        Writer.BeginCloud();
+        Writer.AddDepthFrame(LUT, Depth, Intensity, bOrganized);
+        Writer.Commit();
+        const FPointCloud2Buffer* Cloud = Writer.Acquire();
+        if (!TestNotNull(TEXT("Committed cloud should be available"), Cloud))
+        {
+            return false;
+        }
+        TestEqual(TEXT("Dense flag"), Cloud->bIsDense, !bOrganized);
+        TestEqual(TEXT("Height"), Cloud->Height, bOrganized ? Height : 1u);
+        TestEqual(TEXT("Row step"), Cloud->GetRowStep() * Cloud->Height, static_cast<uint32>(Cloud->GetBytes().Num()));
+
+        // Reference: per-pixel CalculateSphericalFromDepth followed by ConvertUEToROS
+        int32 Point = 0;
+        double MaxError = 0.0;
+        for (uint32 y = 0; y < Height; ++y)
+        {
+            for (uint32 x = 0; x < Width; ++x)
+            {
+                const int32 i = static_cast<int32>(y * Width + x);
+                if (Depth[i] <= 0.0f)
+                {
+                    if (bOrganized)
+                    {
+                        TestTrue(TEXT("Missing returns are NaN in organized clouds"), FMath::IsNaN(ReadFloat(*Cloud, Point, 0)));
+                        ++Point;
+                    }
+                    continue;
+                }
+                const std::pair<FVector, FVector> Expected = MathToolkitLibrary::CalculateSphericalFromDepth(
+                    Depth[i], static_cast<float>(x), static_cast<float>(y), TanH, TanV, Width, Height);
+                const FVector ROS = MathToolkitLibrary::ConvertUEToROS(Expected.second);
+                MaxError = FMath::Max(MaxError, FMath::Abs(ReadFloat(*Cloud, Point, 0) - ROS.X));
+                MaxError = FMath::Max(MaxError, FMath::Abs(ReadFloat(*Cloud, Point, 4) - ROS.Y));
+                MaxError = FMath::Max(MaxError, FMath::Abs(ReadFloat(*Cloud, Point, 8) - ROS.Z));
+                MaxError = FMath::Max(MaxError, FMath::Abs(ReadFloat(*Cloud, Point, 12) - Expected.first.X * 0.01));
+                MaxError = FMath::Max(MaxError, FMath::Abs(ReadFloat(*Cloud, Point, 16) + Expected.first.Y));
+                MaxError = FMath::Max(MaxError, FMath::Abs(ReadFloat(*Cloud, Point, 20) - Expected.first.Z));
+                TestEqual(TEXT("Intensity"), ReadFloat(*Cloud, Point, 24), Intensity[i]);
+                ++Point;
+            }
+        }
+        TestEqual(TEXT("Point count"), Cloud->NumPoints, Point);
+        TestTrue(FString::Printf(TEXT("Streamed fields match the per-pixel path (max error %g)"), MaxError), MaxError < 1e-4);
+        Writer.Release();
+    }
+
+    // AddPoint derives the spherical fields from the point itself
+    Writer.BeginCloud();
+    const FVector UEPoint(300.0, 400.0, -120.0);
+    Writer.AddPoint(UEPoint, 0.5f);
+    Writer.Commit();
+    const FPointCloud2Buffer* Cloud = Writer.Acquire();
+    TestEqual(TEXT("Single point width"), Cloud->Width, 1u);
+    TestTrue(TEXT("Y is flipped"), FMath::IsNearlyEqual(ReadFloat(*Cloud, 0, 4), -4.0, 1e-6));
+    TestTrue(TEXT("Range in m"), FMath::IsNearlyEqual(ReadFloat(*Cloud, 0, 12), UEPoint.Size() * 0.01, 1e-5));
+    TestTrue(TEXT("Azimuth is mirrored"), FMath::IsNearlyEqual(ReadFloat(*Cloud, 0, 16), -FMath::Atan2(400.0, 300.0), 1e-6));
+    Writer.Release();
+
+    // The pair from CalculateSphericalFromDepth goes in as is
+    const std::pair<FVector, FVector> SphericalAndPoint = MathToolkitLibrary::CalculateSphericalFromDepth(250.0f, 10.0f, 30.0f, 90.0f, 64, 48);
+    Writer.BeginCloud();
+    Writer.AddPoint(SphericalAndPoint, 0.25f);
+    Writer.Commit();
+    Cloud = Writer.Acquire();
+    const FVector PairROS = MathToolkitLibrary::ConvertUEToROS(SphericalAndPoint.second);
+    TestTrue(TEXT("Pair point"), FMath::IsNearlyEqual(ReadFloat(*Cloud, 0, 0), PairROS.X, 1e-4) && FMath::IsNearlyEqual(ReadFloat(*Cloud, 0, 4), PairROS.Y, 1e-4));
+    TestTrue(TEXT("Pair range"), FMath::IsNearlyEqual(ReadFloat(*Cloud, 0, 12), SphericalAndPoint.first.X * 0.01, 1e-5));
+    TestTrue(TEXT("Pair elevation"), FMath::IsNearlyEqual(ReadFloat(*Cloud, 0, 20), SphericalAndPoint.first.Z, 1e-6));
+    Writer.Release();
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPointCloud2WriterHandoffTest, "MathToolkit.PointCloud2Writer.Handoff",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FPointCloud2WriterHandoffTest::RunTest(const FString& Parameters)
+{
+    FPointCloud2Writer Writer(FPointCloud2Layout(), 4);
+    TestNull(TEXT("Nothing to publish before the first commit"), Writer.Acquire());
+
+    Writer.BeginCloud();
+    Writer.AddPoint(FVector(100.0, 0.0, 0.0));
+    Writer.Commit();
+    const FPointCloud2Buffer* First = Writer.Acquire();
+    TestNotNull(TEXT("First cloud"), First);
+    const uint8* FirstData = First->Data.GetData();
+
+    // While the publisher holds the first cloud the producer keeps going in the other buffer
+    Writer.BeginCloud();
+    Writer.AddPoint(FVector(200.0, 0.0, 0.0));
+    Writer.Commit();
+    Writer.BeginCloud();
+    for (int32 i = 0; i < 10; ++i)
+    {
+        Writer.AddPoint(FVector(300.0, 0.0, 0.0));
+    }
+    TestEqual(TEXT("Held cloud is untouched"), First->NumPoints, 1);
+    TestEqual(TEXT("Held cloud keeps its storage"), First->Data.GetData(), FirstData);
+    TestEqual(TEXT("Overwritten cloud counts as dropped"), Writer.GetNumDropped(), uint64(1));
+    Writer.Commit();
+    Writer.Release();
+
+    const FPointCloud2Buffer* Latest = Writer.Acquire();
+    TestNotNull(TEXT("Latest cloud"), Latest);
+    TestEqual(TEXT("Clouds past MaxPoints grow the buffer"), Latest->NumPoints, 10);
+    TestEqual(TEXT("Sequence numbers count every cloud begun"), Latest->Sequence, uint64(2));
+    TestTrue(TEXT("Latest point"), FMath::IsNearlyEqual(ReadFloat(*Latest, 9, 0), 3.0, 1e-6));
+    Writer.Release();
+
+    // With an idle publisher every commit but the last is replaced before it is acquired
+    for (int32 i = 0; i < 3; ++i)
+    {
+        Writer.BeginCloud();
+        Writer.AddPoint(FVector(400.0 + i, 0.0, 0.0));
+        Writer.Commit();
+    }
+    TestEqual(TEXT("Replaced commits count as dropped"), Writer.GetNumDropped(), uint64(3));
+    const FPointCloud2Buffer* Newest = Writer.Acquire();
+    TestNotNull(TEXT("Newest cloud"), Newest);
+    TestEqual(TEXT("Newest cloud is the last one committed"), Newest->Sequence, uint64(5));
+    Writer.Release();
+
+    return true;
+}
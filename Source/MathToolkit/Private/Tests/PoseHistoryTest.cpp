@@ -0,0 +1,147 @@
+#include "Misc/AutomationTest.h"
+#include "PoseHistory.h"
+
+#include <limits>
+
+namespace
+{
+    // Constant velocity and constant yaw rate, sampled at 100 Hz
+    FVector TruePosition(double Time) { return FVector(100.0 + 250.0 * Time, -40.0 * Time, 5.0); }
+    FQuat TrueRotation(double Time) { return FQuat(FVector(0.0, 0.0, 1.0), 0.8 * Time); }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPoseHistoryQueryTest, "MathToolkit.PoseHistory.Query",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FPoseHistoryQueryTest::RunTest(const FString& Parameters)
+{
+    FPoseHistory::FSettings Settings;
+    Settings.Capacity = 16;
+    Settings.MaxExtrapolation = 0.05;
+    FPoseHistory History(Settings);
+
+    const int32 Frame = History.RegisterFrame(42);
+    TestEqual(TEXT("Registering twice returns the same handle"), History.RegisterFrame(42), Frame);
+    TestEqual(TEXT("Find"), History.FindFrame(42), Frame);
+    TestEqual(TEXT("Unknown frame"), History.FindFrame(7), static_cast<int32>(INDEX_NONE));
+
+    FVector Position;
+    FQuat Rotation;
+    TestTrue(TEXT("Empty history is out of range"), History.GetPose(Frame, 0.0, Position, Rotation) == EPoseQueryResult::OutOfRange);
+
+    // Far more poses than the capacity, so the window wraps and compacts several times
+    const int32 NumPoses = 100;
+    for (int32 i = 0; i < NumPoses; ++i)
+    {
+        const double Time = 1000.0 + i * 0.01;
+        TestTrue(TEXT("In-order poses are accepted"), History.AddPose(Frame, Time, TruePosition(Time), TrueRotation(Time)));
+    }
+    TestFalse(TEXT("Out-of-order poses are rejected"), History.AddPose(Frame, 1000.0, FVector::ZeroVector, FQuat::Identity));
+    TestEqual(TEXT("Only Capacity poses are kept"), History.GetNumPoses(Frame), Settings.Capacity);
+
+    double Oldest, Newest;
+    TestTrue(TEXT("Time range"), History.GetTimeRange(Frame, Oldest, Newest));
+    TestTrue(TEXT("Newest"), FMath::IsNearlyEqual(Newest, 1000.0 + (NumPoses - 1) * 0.01, 1e-9));
+    TestTrue(TEXT("Oldest"), FMath::IsNearlyEqual(Oldest, 1000.0 + (NumPoses - Settings.Capacity) * 0.01, 1e-9));
+
+    const double Mid = Oldest + 0.0537;
+    TestTrue(TEXT("Between poses interpolates"), History.GetPose(Frame, Mid, Position, Rotation) == EPoseQueryResult::Interpolated);
+    TestTrue(TEXT("Interpolated position"), Position.Equals(TruePosition(Mid), 1e-6));
+    TestTrue(TEXT("Slerped rotation"), Rotation.Equals(TrueRotation(Mid), 1e-6));
+
+    const double Ahead = Newest + 0.03;
+    TestTrue(TEXT("Past the newest pose extrapolates"), History.GetPose(Frame, Ahead, Position, Rotation) == EPoseQueryResult::Extrapolated);
+    TestTrue(TEXT("Extrapolated position follows the fit"), Position.Equals(TruePosition(Ahead), 1e-4));
+    TestTrue(TEXT("Extrapolated rotation follows the angular rate"), Rotation.Equals(TrueRotation(Ahead), 1e-6));
+
+    TestTrue(TEXT("Past the horizon is out of range"), History.GetPose(Frame, Newest + 1.0, Position, Rotation) == EPoseQueryResult::OutOfRange);
+    TestTrue(TEXT("Clamped to the horizon"), Position.Equals(TruePosition(Newest + Settings.MaxExtrapolation), 1e-4));
+    TestTrue(TEXT("Before the oldest pose is out of range"), History.GetPose(Frame, Oldest - 1.0, Position, Rotation) == EPoseQueryResult::OutOfRange);
+    TestTrue(TEXT("Clamped to the oldest pose"), Position.Equals(TruePosition(Oldest), 1e-6));
+
+    for (const double Invalid : {std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity()})
+    {
+        TestTrue(TEXT("Non-finite time is out of range"), History.GetPose(Frame, Invalid, Position, Rotation) == EPoseQueryResult::OutOfRange);
+        TestTrue(TEXT("Non-finite time gives a finite pose"), FMath::IsFinite(Position.X) && FMath::IsFinite(Rotation.W));
+    }
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPoseHistoryBatchTest, "MathToolkit.PoseHistory.Batch",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FPoseHistoryBatchTest::RunTest(const FString& Parameters)
+{
+    FPoseHistory::FSettings Settings;
+    Settings.Capacity = 64;
+    FPoseHistory History(Settings);
+    const int32 Frame = History.RegisterFrame(1);
+    for (int32 i = 0; i < 50; ++i)
+    {
+        const double Time = i * 0.01;
+        History.AddPose(Frame, Time, TruePosition(Time), TrueRotation(Time));
+    }
+
+    // One timestamp per lidar column across the history, then unsorted ones with some out of range
+    TArray<double> Timestamps;
+    for (int32 Column = 0; Column < 1800; ++Column)
+    {
+        Timestamps.Add(-0.01 + Column * (0.55 / 1800));
+    }
+    FRandomStream Random(5);
+    for (int32 i = 0; i < 200; ++i)
+    {
+        Timestamps.Add(Random.FRandRange(-0.1f, 0.7f));
+    }
+    Timestamps.Add(std::numeric_limits<double>::quiet_NaN());
+    Timestamps.Add(0.105);
+    Timestamps.Add(std::numeric_limits<double>::infinity());
+    Timestamps.Add(0.106);
+
+    TArray<FVector> Positions;
+    TArray<FQuat> Rotations;
+    TArray<EPoseQueryResult> Results;
+    Positions.SetNumUninitialized(Timestamps.Num());
+    Rotations.SetNumUninitialized(Timestamps.Num());
+    Results.SetNumUninitialized(Timestamps.Num());
+    const int32 NumInRange = History.GetPoses(Frame, Timestamps, Positions, Rotations, Results);
+
+    int32 ExpectedInRange = 0;
+    for (int32 i = 0; i < Timestamps.Num(); ++i)
+    {
+        FVector Position;
+        FQuat Rotation;
+        const EPoseQueryResult Result = History.GetPose(Frame, Timestamps[i], Position, Rotation);
+        ExpectedInRange += Result != EPoseQueryResult::OutOfRange;
+        TestTrue(FString::Printf(TEXT("Batch result %d"), i), Results[i] == Result);
+        TestTrue(FString::Printf(TEXT("Batch position %d"), i), Positions[i].Equals(Position, 1e-9));
+        TestTrue(FString::Printf(TEXT("Batch rotation %d"), i), Rotations[i].Equals(Rotation, 1e-9));
+    }
+    TestEqual(TEXT("In-range count"), NumInRange, ExpectedInRange);
+    TestTrue(TEXT("NaN in a batch is out of range"), Results[Timestamps.Num() - 4] == EPoseQueryResult::OutOfRange);
+    TestTrue(TEXT("Batch resumes after a NaN"), Results[Timestamps.Num() - 3] == EPoseQueryResult::Interpolated);
+
+    // Steps of 0.4 rad per pose take the full slerp rather than the small-angle lerp
+    const int32 FastFrame = History.RegisterFrame(2);
+    for (int32 i = 0; i < 10; ++i)
+    {
+        History.AddPose(FastFrame, i * 0.01, TruePosition(i * 0.01), FQuat(FVector(0.0, 0.0, 1.0), 0.4 * i));
+    }
+    Timestamps.Reset();
+    for (int32 Column = 0; Column < 900; ++Column)
+    {
+        Timestamps.Add(Column * (0.09 / 900));
+    }
+    History.GetPoses(FastFrame, Timestamps, MakeArrayView(Positions.GetData(), 900), MakeArrayView(Rotations.GetData(), 900));
+    for (int32 i = 0; i < Timestamps.Num(); ++i)
+    {
+        FVector Position;
+        FQuat Rotation;
+        History.GetPose(FastFrame, Timestamps[i], Position, Rotation);
+        TestTrue(FString::Printf(TEXT("Slerp batch rotation %d"), i), Rotations[i].Equals(Rotation, 1e-9));
+        TestTrue(FString::Printf(TEXT("Slerp batch follows the yaw %d"), i), Rotations[i].Equals(FQuat(FVector(0.0, 0.0, 1.0), 40.0 * Timestamps[i]), 1e-9));
+    }
+
+    return true;
+}
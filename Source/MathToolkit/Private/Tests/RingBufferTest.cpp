@@ -0,0 +1,139 @@
+#include "Misc/AutomationTest.h"
+#include "RingBufferMT.h"
+#include "CircularBufferMT.h"
+#include "MathToolkitLibrary.h"
+
+#include <vector>
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRingBufferBasicTest, "MathToolkit.RingBuffer.Basic",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FRingBufferBasicTest::RunTest(const FString& Parameters)
+{
+    RingBufferMT<int32> buffer(5);
+    CircularBufferMT<int32, 5> reference;
+
+    TestTrue(TEXT("Buffer should be empty initially"), buffer.empty());
+    TestEqual(TEXT("Capacity should be the runtime value"), static_cast<int32>(buffer.capacity()), 5);
+
+    TArray<int32> input;
+    for(int32 i = 1; i <= 23; ++i) {
+        input.Add(i);
+    }
+
+    // Runtime and compile-time buffers must agree after every mix of single and bulk puts
+    int32 next = 0;
+    for(int32 chunk : {2, 1, 4, 0, 3, 7, 1, 5}) {
+        buffer.put_n(MakeArrayView(input.GetData() + next, chunk));
+        for(int32 i = 0; i < chunk; ++i) {
+            reference.put(input[next + i]);
+        }
+        next += chunk;
+
+        TArray<int32> values, expected;
+        buffer.for_each([&values](int32 val) { values.Add(val); });
+        reference.for_each([&expected](int32 val) { expected.Add(val); });
+
+        TestEqual(FString::Printf(TEXT("Size after %d inserts"), next), values.Num(), expected.Num());
+        for(int32 i = 0; i < FMath::Min(values.Num(), expected.Num()); ++i) {
+            TestEqual(FString::Printf(TEXT("Element %d after %d inserts"), i, next), values[i], expected[i]);
+        }
+    }
+
+    TestTrue(TEXT("Buffer should be full"), buffer.full());
+    TestEqual(TEXT("Back should be the newest element"), buffer.back(), 23);
+    buffer.pop_front();
+    TestEqual(TEXT("pop_front should drop the oldest element"), buffer.front(), 20);
+
+    // Re-inserting the element that a full buffer is about to evict
+    RingBufferMT<TArray<float>> scans(2);
+    for(int32 i = 1; i <= 3; ++i) {
+        TArray<float> scan;
+        scan.Init(static_cast<float>(i), 40 * i);
+        scans.put(MoveTemp(scan));
+    }
+    TestTrue(TEXT("Buffer should be full"), scans.full());
+    scans.put(scans.front());
+    TestEqual(TEXT("put(front()) should copy the evicted element"), scans.back().Num(), 80);
+    TestTrue(TEXT("put(front()) should copy the evicted payload"), scans.back()[79] == 2.0f);
+    TestEqual(TEXT("Oldest live element after put(front())"), scans.front().Num(), 120);
+    TestEqual(TEXT("put(front()) should keep the size"), static_cast<int32>(scans.size()), 2);
+
+    // A moved-from buffer is empty but can still be written and read
+    RingBufferMT<TArray<float>> moved(MoveTemp(scans));
+    TestEqual(TEXT("Move should take the elements"), static_cast<int32>(moved.size()), 2);
+    TestTrue(TEXT("Moved-from buffer should be empty"), scans.empty());
+    TestEqual(TEXT("Moved-from buffer should keep its capacity"), static_cast<int32>(scans.capacity()), 2);
+    for(int32 i = 1; i <= 3; ++i) {
+        TArray<float> scan;
+        scan.Init(static_cast<float>(i), i);
+        scans.put(MoveTemp(scan));
+    }
+    TestEqual(TEXT("Moved-from buffer should wrap as usual"), scans.front().Num(), 2);
+    TestEqual(TEXT("Moved-from buffer should keep the newest element"), scans.back().Num(), 3);
+    scans.pop_front();
+    TestEqual(TEXT("Moved-from buffer should pop as usual"), static_cast<int32>(scans.size()), 1);
+
+    // Move assignment frees the target's elements and leaves the source reusable too
+    moved = MoveTemp(scans);
+    TestEqual(TEXT("Move assignment should take the elements"), moved.back().Num(), 3);
+    TestTrue(TEXT("Move-assigned-from buffer should be empty"), scans.empty());
+    scans.put_n(MakeArrayView(&moved.back(), 1));
+    TestEqual(TEXT("Move-assigned-from buffer should accept put_n"), scans.front().Num(), 3);
+
+    RingBufferMT<int32> ints(3);
+    ints.put(1);
+    RingBufferMT<int32> other(MoveTemp(ints));
+    ints.put(2);
+    ints = MoveTemp(ints);
+    TestEqual(TEXT("Self move assignment should keep the elements"), ints.front(), 2);
+    TestEqual(TEXT("Moved-to buffer should keep its element"), other.front(), 1);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRingBufferArenaTest, "MathToolkit.RingBuffer.Arena",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FRingBufferArenaTest::RunTest(const FString& Parameters)
+{
+    typedef TPair<FVector, uint32> Sample;
+    typedef RingBufferMT<Sample, FRingBufferArenaAllocator> ArenaBuffer;
+
+    const int32 num_buffers = 300;
+    const size_t window = 48;
+    FRingBufferArena arena(num_buffers * window * sizeof(Sample));
+
+    {
+        std::vector<ArenaBuffer> buffers;
+        buffers.reserve(num_buffers);
+        for(int32 i = 0; i < num_buffers; ++i) {
+            buffers.emplace_back(window, FRingBufferArenaAllocator(arena));
+        }
+        TestEqual(TEXT("Every buffer should be carved from the arena"), arena.GetLiveAllocations(), num_buffers);
+        TestEqual(TEXT("Buffers should be packed back to back"), static_cast<int64>(arena.GetUsedBytes()), static_cast<int64>(num_buffers * window * sizeof(Sample)));
+
+        // The fits accept the runtime buffer and match the fixed-size one
+        CircularBufferMT<Sample, window> reference;
+        for(uint32 t = 0; t < 100; ++t) {
+            const Sample sample(FVector(3.0 * t + 1.0, -0.5 * t, FMath::Sin(0.1 * t)), t);
+            buffers[7].put(sample);
+            reference.put(sample);
+        }
+
+        FVector fit_a, fit_b, expected_a, expected_b;
+        MathToolkitLibrary::calculateLinearFit(buffers[7], fit_a, fit_b);
+        MathToolkitLibrary::calculateLinearFit(reference, expected_a, expected_b);
+        TestTrue(TEXT("Linear fit on RingBufferMT should match CircularBufferMT"),
+            fit_a.Equals(expected_a, 1e-9) && fit_b.Equals(expected_b, 1e-9));
+
+        MathToolkitLibrary::calculateQuadraticFit(buffers[7], fit_a, fit_b, expected_a);
+        TestTrue(TEXT("Quadratic fit should accept RingBufferMT"), FMath::IsFinite(fit_a.X));
+    }
+
+    TestEqual(TEXT("Destroyed buffers should release their arena blocks"), arena.GetLiveAllocations(), 0);
+    arena.Reset();
+    TestEqual(TEXT("Reset should recycle the slab"), static_cast<int64>(arena.GetUsedBytes()), static_cast<int64>(0));
+
+    return true;
+}
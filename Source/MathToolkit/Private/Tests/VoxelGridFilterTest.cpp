@@ -0,0 +1,153 @@
+#include "Misc/AutomationTest.h"
+#include "VoxelGridFilter.h"
+#include "PointCloud2Writer.h"
+
+#include <limits>
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FVoxelGridFilterCentroidTest, "MathToolkit.VoxelGridFilter.Centroids",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FVoxelGridFilterCentroidTest::RunTest(const FString& Parameters)
+{
+    FVoxelGridFilter::FSettings Settings;
+    Settings.VoxelSize = 10.0f;
+    Settings.MinPointsPerVoxel = 2;
+    Settings.MaxVoxels = 16;
+    FVoxelGridFilter Filter(Settings);
+
+    const float NaN = std::numeric_limits<float>::quiet_NaN();
+    TArray<FVector> Points = {
+        // Voxel (0, 0, 0)
+        FVector(1.0, 1.0, 1.0), FVector(3.0, 5.0, 9.0),
+        // Voxel (-1, 2, 0), negative coordinates must floor rather than truncate
+        FVector(-2.0, 21.0, 4.0), FVector(-8.0, 29.0, 6.0), FVector(-5.0, 25.0, 5.0),
+        // Lone return
+        FVector(500.0, 500.0, 500.0),
+        FVector(NaN, 0.0, 0.0),
+    };
+
+    for (int32 Frame = 0; Frame < 3; ++Frame)
+    {
+        Filter.BeginFrame();
+        Filter.AddPoints(Points);
+        TestEqual(TEXT("Occupied voxels"), Filter.GetNumVoxels(), 3);
+        TestEqual(TEXT("Invalid points"), Filter.GetFrameStats().NumInvalid, 1);
+
+        TArray<FVector> Centroids;
+        Centroids.SetNumUninitialized(Filter.GetNumVoxels());
+        TestEqual(TEXT("Sparse voxels are dropped"), Filter.GetCentroids(Centroids), 2);
+        TestTrue(TEXT("First centroid"), Centroids[0].Equals(FVector(2.0, 3.0, 5.0), 1e-5));
+        TestTrue(TEXT("Second centroid"), Centroids[1].Equals(FVector(-5.0, 25.0, 5.0), 1e-5));
+    }
+
+    // The table never grows: voxels beyond MaxVoxels are counted and discarded
+    const SIZE_T Allocated = Filter.GetAllocatedSize();
+    Filter.BeginFrame();
+    for (int32 i = 0; i < 40; ++i)
+    {
+        Filter.AddPoints(MakeArrayView(&Points[0], 1));
+        Points[0].X += 10.0;
+    }
+    TestEqual(TEXT("Voxels are capped"), Filter.GetNumVoxels(), Settings.MaxVoxels);
+    TestEqual(TEXT("Overflow is counted"), Filter.GetFrameStats().NumOverflowed, 40 - Settings.MaxVoxels);
+    TestEqual(TEXT("No allocation across frames"), Filter.GetAllocatedSize(), Allocated);
+
+    // Without MaxRange, finite points past the 21-bit key range are cropped instead of overflowing or aliasing
+    const double KeyRange = 1048576.0 * Settings.VoxelSize;
+    const TArray<FVector> Far = {
+        FVector(1.0e12, 0.0, 0.0), FVector(0.0, -3.0e38, 0.0),
+        // Would alias onto voxel (0, 0, 0)
+        FVector(2.0 * KeyRange + 1.0, 1.0, 1.0), FVector(1.0, 1.0, -2.0 * KeyRange + 1.0),
+        // Last voxel that still fits
+        FVector(KeyRange - Settings.VoxelSize, 0.0, 0.0),
+    };
+    Filter.BeginFrame();
+    Filter.AddPoints(Far);
+    TestEqual(TEXT("Out-of-key-range points are cropped"), Filter.GetFrameStats().NumCropped, 4);
+    TestEqual(TEXT("Only the representable point gets a voxel"), Filter.GetNumVoxels(), 1);
+
+    // Many points in one voxel 8 km out: the centroid must not drift with the point count
+    TArray<FVector> Dense;
+    for (int32 i = 0; i < 20000; ++i)
+    {
+        const double Step = (i % 40) * 0.25;
+        Dense.Add(FVector(800000.0 + Step, -600000.0 + Step, 300000.0 + 0.5 * Step));
+    }
+    Filter.BeginFrame();
+    Filter.AddPoints(Dense);
+    TArray<FVector> Centroids;
+    Centroids.SetNumUninitialized(Filter.GetNumVoxels());
+    TestEqual(TEXT("Dense far points share one voxel"), Filter.GetCentroids(Centroids), 1);
+    TestTrue(TEXT("Far centroid does not drift"), Centroids[0].Equals(FVector(800004.875, -599995.125, 300002.4375), 1e-3));
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FVoxelGridFilterDepthFrameTest, "MathToolkit.VoxelGridFilter.DepthFrame",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FVoxelGridFilterDepthFrameTest::RunTest(const FString& Parameters)
+{
+    const uint32 Width = 64;
+    const uint32 Height = 48;
+    const FDepthRayLUT LUT(90.0f, Width, Height);
+    const int32 NumPixels = static_cast<int32>(Width * Height);
+
+    TArray<float> Depth;
+    FRandomStream Random(11);
+    for (int32 i = 0; i < NumPixels; ++i)
+    {
+        Depth.Add(i % 7 == 0 ? 0.0f : Random.FRandRange(100.0f, 3000.0f));
+    }
+
+    FVoxelGridFilter::FSettings Settings;
+    Settings.VoxelSize = 25.0f;
+    Settings.MinRange = 200.0f;
+    Settings.MaxRange = 2500.0f;
+    Settings.MinAzimuth = -0.5f;
+    Settings.MaxAzimuth = 0.5f;
+    Settings.MaxVoxels = NumPixels;
+
+    // The depth path must agree with filtering the converted cloud
+    TArray<float> X, Y, Z;
+    X.SetNumUninitialized(NumPixels);
+    Y.SetNumUninitialized(NumPixels);
+    Z.SetNumUninitialized(NumPixels);
+    LUT.Convert(Depth, FDepthPointCloudSoA{X, Y, Z, {}, {}, {}});
+    for (int32 i = 0; i < NumPixels; ++i)
+    {
+        if (Depth[i] <= 0.0f)
+        {
+            X[i] = Y[i] = Z[i] = std::numeric_limits<float>::quiet_NaN();
+        }
+    }
+
+    FVoxelGridFilter FromDepth(Settings);
+    FromDepth.AddDepthFrame(LUT, Depth);
+    FVoxelGridFilter FromPoints(Settings);
+    FromPoints.AddPoints(X, Y, Z);
+
+    const FVoxelGridFilter::FFrameStats& Stats = FromDepth.GetFrameStats();
+    TestEqual(TEXT("Input"), Stats.NumInput, NumPixels);
+    TestEqual(TEXT("Invalid depth"), Stats.NumInvalid, (NumPixels + 6) / 7);
+    TestTrue(TEXT("Crop removes points"), Stats.NumCropped > 0);
+    TestEqual(TEXT("Same crop as the point path"), Stats.NumCropped, FromPoints.GetFrameStats().NumCropped);
+    TestEqual(TEXT("Same voxels as the point path"), FromDepth.GetNumVoxels(), FromPoints.GetNumVoxels());
+
+    TArray<FVector> Centroids;
+    Centroids.SetNumUninitialized(FromDepth.GetNumVoxels());
+    const int32 NumCentroids = FromDepth.GetCentroids(Centroids);
+    for (int32 i = 0; i < NumCentroids; ++i)
+    {
+        const double Range = Centroids[i].Size();
+        TestTrue(TEXT("Centroids stay inside the range crop"), Range >= 200.0 - 25.0 && Range <= 2500.0 + 25.0);
+    }
+
+    FPointCloud2Writer Writer(FPointCloud2Layout(), NumCentroids);
+    Writer.BeginCloud();
+    TestEqual(TEXT("Every centroid is streamed"), FromDepth.WriteCentroids(Writer), NumCentroids);
+    TestEqual(TEXT("Writer point count"), Writer.GetNumPoints(), NumCentroids);
+    Writer.Commit();
+
+    return true;
+}
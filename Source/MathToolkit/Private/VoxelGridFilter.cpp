@@ -0,0 +1,203 @@
+#include "VoxelGridFilter.h"
+#include "PointCloud2Writer.h"
+#include "MathToolkitStats.h"
+
+namespace
+{
+    // 21 bits per axis: +-2^20 voxels, i.e. +-1000 km at 10 cm; InKeyRange crops anything farther
+    constexpr uint64 VoxelAxisMask = (uint64(1) << 21) - 1;
+
+    FORCEINLINE uint64 PackVoxelKey(int32 VX, int32 VY, int32 VZ)
+    {
+        return ((static_cast<uint64>(VX) & VoxelAxisMask) << 42) | ((static_cast<uint64>(VY) & VoxelAxisMask) << 21) | (static_cast<uint64>(VZ) & VoxelAxisMask);
+    }
+
+    FORCEINLINE int32 UnpackVoxelAxis(uint64 Key, int32 Shift)
+    {
+        // Sign-extends the 21-bit field
+        return static_cast<int32>(static_cast<uint32>((Key >> Shift) & VoxelAxisMask) << 11) >> 11;
+    }
+}
+
+FVoxelGridFilter::FVoxelGridFilter(const FSettings& InSettings)
+    : Settings(InSettings)
+{
+    check(Settings.VoxelSize > 0.0f);
+    check(Settings.MaxVoxels > 0);
+    InvVoxelSize = 1.0f / Settings.VoxelSize;
+    bCropDirection = Settings.MinAzimuth > -UE_PI || Settings.MaxAzimuth < UE_PI
+        || Settings.MinElevation > -UE_PI / 2 || Settings.MaxElevation < UE_PI / 2;
+
+    // At most half full, so linear probes stay short
+    const uint32 NumSlots = FMath::RoundUpToPowerOfTwo(static_cast<uint32>(Settings.MaxVoxels) * 2);
+    HashShift = 64 - FMath::FloorLog2(NumSlots);
+    Slots.SetNumZeroed(static_cast<int32>(NumSlots));
+    Occupied.Reserve(Settings.MaxVoxels);
+}
+
+void FVoxelGridFilter::BeginFrame()
+{
+    Occupied.Reset(Settings.MaxVoxels);
+    FrameStats = FFrameStats();
+    if (++Generation == 0)
+    {
+        // Stamps wrapped: stale slots could look current again, so clear them once every 2^32 frames
+        for (FVoxel& Slot : Slots)
+        {
+            Slot.Generation = 0;
+        }
+        Generation = 1;
+    }
+}
+
+void FVoxelGridFilter::Accumulate(float X, float Y, float Z)
+{
+    const int32 VX = FMath::FloorToInt(X * InvVoxelSize);
+    const int32 VY = FMath::FloorToInt(Y * InvVoxelSize);
+    const int32 VZ = FMath::FloorToInt(Z * InvVoxelSize);
+    const uint64 Key = PackVoxelKey(VX, VY, VZ);
+    // Far from the origin a float sum of raw coordinates loses the centroid after a few hundred points
+    X -= GetCorner(VX);
+    Y -= GetCorner(VY);
+    Z -= GetCorner(VZ);
+    const uint32 Mask = static_cast<uint32>(Slots.Num() - 1);
+    FVoxel* RESTRICT Table = Slots.GetData();
+    for (uint32 Index = static_cast<uint32>((Key * 0x9E3779B97F4A7C15ull) >> HashShift);; Index = (Index + 1) & Mask)
+    {
+        FVoxel& Slot = Table[Index];
+        if (Slot.Generation != Generation)
+        {
+            if (Occupied.Num() >= Settings.MaxVoxels)
+            {
+                ++FrameStats.NumOverflowed;
+                return;
+            }
+            Slot = FVoxel{Key, Generation, 1, X, Y, Z};
+            Occupied.Add(static_cast<int32>(Index));
+            return;
+        }
+        if (Slot.Key == Key)
+        {
+            ++Slot.Count;
+            Slot.SumX += X;
+            Slot.SumY += Y;
+            Slot.SumZ += Z;
+            return;
+        }
+    }
+}
+
+void FVoxelGridFilter::AddPoint(float X, float Y, float Z)
+{
+    if (!FMath::IsFinite(X) || !FMath::IsFinite(Y) || !FMath::IsFinite(Z))
+    {
+        ++FrameStats.NumInvalid;
+        return;
+    }
+    const float HorizontalSq = X * X + Y * Y;
+    if (!InRange(FMath::Sqrt(HorizontalSq + Z * Z)) || !InKeyRange(X, Y, Z)
+        || (bCropDirection && !InDirection(FMath::Atan2(Y, X), FMath::Atan2(Z, FMath::Sqrt(HorizontalSq)))))
+    {
+        ++FrameStats.NumCropped;
+        return;
+    }
+    Accumulate(X, Y, Z);
+}
+
+void FVoxelGridFilter::AddPoints(TConstArrayView<float> X, TConstArrayView<float> Y, TConstArrayView<float> Z)
+{
+    MATHTOOLKIT_SCOPE(Filter);
+    check(Y.Num() == X.Num() && Z.Num() == X.Num());
+    FrameStats.NumInput += X.Num();
+    for (int32 i = 0; i < X.Num(); ++i)
+    {
+        AddPoint(X[i], Y[i], Z[i]);
+    }
+}
+
+void FVoxelGridFilter::AddPoints(TConstArrayView<FVector> Points)
+{
+    MATHTOOLKIT_SCOPE(Filter);
+    FrameStats.NumInput += Points.Num();
+    for (const FVector& Point : Points)
+    {
+        AddPoint(static_cast<float>(Point.X), static_cast<float>(Point.Y), static_cast<float>(Point.Z));
+    }
+}
+
+void FVoxelGridFilter::AddDepthFrame(const FDepthRayLUT& LUT, TConstArrayView<float> Depth)
+{
+    MATHTOOLKIT_SCOPE(Filter);
+    const uint32 Width = LUT.GetWidth();
+    const uint32 Height = LUT.GetHeight();
+    check(Depth.Num() >= static_cast<int32>(Width * Height));
+    FrameStats.NumInput += static_cast<int32>(Width * Height);
+
+    const float* RESTRICT D = Depth.GetData();
+    const float* RESTRICT ColumnSlope = LUT.GetColumnSlopes().GetData();
+    const float* RESTRICT ColumnAzimuth = LUT.GetColumnAzimuths().GetData();
+    const float* RESTRICT RangeScale = LUT.GetRangeScales().GetData();
+    const float* RESTRICT Elevation = LUT.GetElevations().GetData();
+    for (uint32 y = 0; y < Height; ++y)
+    {
+        const float RowSlope = LUT.GetRowSlopes()[y];
+        for (uint32 x = 0; x < Width; ++x)
+        {
+            const int32 i = static_cast<int32>(y * Width + x);
+            const float Value = D[i];
+            // Also rejects NaN, for which every compare is false
+            if (!(Value > 0.0f) || !FMath::IsFinite(Value))
+            {
+                ++FrameStats.NumInvalid;
+                continue;
+            }
+            const float PY = Value * ColumnSlope[x];
+            const float PZ = Value * RowSlope;
+            if (!InRange(Value * RangeScale[i]) || !InKeyRange(Value, PY, PZ)
+                || (bCropDirection && !InDirection(ColumnAzimuth[x], Elevation[i])))
+            {
+                ++FrameStats.NumCropped;
+                continue;
+            }
+            Accumulate(Value, PY, PZ);
+        }
+    }
+}
+
+FVector FVoxelGridFilter::GetCentroid(const FVoxel& Voxel) const
+{
+    const double InvCount = 1.0 / Voxel.Count;
+    return FVector(GetCorner(UnpackVoxelAxis(Voxel.Key, 42)) + Voxel.SumX * InvCount,
+        GetCorner(UnpackVoxelAxis(Voxel.Key, 21)) + Voxel.SumY * InvCount,
+        GetCorner(UnpackVoxelAxis(Voxel.Key, 0)) + Voxel.SumZ * InvCount);
+}
+
+int32 FVoxelGridFilter::GetCentroids(TArrayView<FVector> Out) const
+{
+    check(Out.Num() >= Occupied.Num());
+    int32 NumWritten = 0;
+    for (int32 Index : Occupied)
+    {
+        const FVoxel& Voxel = Slots[Index];
+        if (Voxel.Count >= Settings.MinPointsPerVoxel)
+        {
+            Out[NumWritten++] = GetCentroid(Voxel);
+        }
+    }
+    return NumWritten;
+}
+
+int32 FVoxelGridFilter::WriteCentroids(FPointCloud2Writer& Writer) const
+{
+    int32 NumWritten = 0;
+    for (int32 Index : Occupied)
+    {
+        const FVoxel& Voxel = Slots[Index];
+        if (Voxel.Count >= Settings.MinPointsPerVoxel)
+        {
+            Writer.AddPoint(GetCentroid(Voxel));
+            ++NumWritten;
+        }
+    }
+    return NumWritten;
+}
@@ -0,0 +1,284 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MathToolkitLibrary.h"
+
+/**
+ * constexpr versions of the few transcendental functions the camera models need, so intrinsics
+ * fixed at build time fold into constants. Double precision, accurate to a few ulp over the ranges
+ * camera intrinsics use; not meant for per-pixel work at run time.
+ */
+namespace MathToolkitConstexpr
+{
+    constexpr double Pi = 3.141592653589793238462643383279502884;
+
+    constexpr double DegreesToRadians(double Degrees) { return Degrees * (Pi / 180.0); }
+    constexpr double RadiansToDegrees(double Radians) { return Radians * (180.0 / Pi); }
+    constexpr double Abs(double X) { return X < 0.0 ? -X : X; }
+
+    constexpr double Sqrt(double X)
+    {
+        if (X <= 0.0)
+        {
+            return 0.0;
+        }
+        double Guess = X > 1.0 ? X : 1.0;
+        for (int32 Iteration = 0; Iteration < 128; ++Iteration)
+        {
+            const double Next = 0.5 * (Guess + X / Guess);
+            if (Next >= Guess)
+            {
+                break;
+            }
+            Guess = Next;
+        }
+        return Guess;
+    }
+
+    /** Reduces X to [-Pi, Pi] for the series below. */
+    constexpr double ReduceAngle(double X)
+    {
+        const double Turns = X / (2.0 * Pi);
+        const double Rounded = static_cast<double>(static_cast<int64>(Turns + (Turns < 0.0 ? -0.5 : 0.5)));
+        return X - Rounded * (2.0 * Pi);
+    }
+
+    constexpr double Sin(double X)
+    {
+        X = ReduceAngle(X);
+        double Term = X;
+        double Sum = X;
+        for (int32 n = 1; n < 30; ++n)
+        {
+            Term *= -X * X / ((2.0 * n) * (2.0 * n + 1.0));
+            Sum += Term;
+        }
+        return Sum;
+    }
+
+    constexpr double Cos(double X)
+    {
+        X = ReduceAngle(X);
+        double Term = 1.0;
+        double Sum = 1.0;
+        for (int32 n = 1; n < 30; ++n)
+        {
+            Term *= -X * X / ((2.0 * n - 1.0) * (2.0 * n));
+            Sum += Term;
+        }
+        return Sum;
+    }
+
+    constexpr double Tan(double X) { return Sin(X) / Cos(X); }
+
+    constexpr double Atan(double X)
+    {
+        if (X < 0.0)
+        {
+            return -Atan(-X);
+        }
+        if (X > 1.0)
+        {
+            return 0.5 * Pi - Atan(1.0 / X);
+        }
+        // atan(x) = 2 atan(x / (1 + sqrt(1 + x^2))) twice brings x below tan(PI/16) for a fast series
+        const double Half = X / (1.0 + Sqrt(1.0 + X * X));
+        const double Quarter = Half / (1.0 + Sqrt(1.0 + Half * Half));
+        double Power = Quarter;
+        double Sum = Quarter;
+        for (int32 n = 1; n < 40; ++n)
+        {
+            Power *= -Quarter * Quarter;
+            Sum += Power / (2.0 * n + 1.0);
+        }
+        return 4.0 * Sum;
+    }
+
+    /** constexpr MathToolkitLibrary::calculateHorizontalFOV: degrees from sensor width and focal length. */
+    constexpr double HorizontalFOV(double SensorWidth, double FocalLength)
+    {
+        return RadiansToDegrees(2.0 * Atan(SensorWidth / (2.0 * FocalLength)));
+    }
+}
+
+/**
+ * Camera models specialized at compile time. TIntrinsics is a struct with static constexpr FOVH
+ * (degrees), Width and Height; everything derived from them (tangents, pixel scales, their
+ * reciprocals) is a constexpr of the model, so the kernels in TCameraModelKernels compile down
+ * to multiplies and adds with literal constants:
+ *
+ *     struct FFrontCameraIntrinsics { static constexpr double FOVH = 90.0; static constexpr uint32 Width = 1920; static constexpr uint32 Height = 1080; };
+ *     using FFrontCamera = TPinholeCameraModel<FFrontCameraIntrinsics>;
+ *     TCameraModelKernels<FFrontCamera>::ConvertDepth(Depth, Out);
+ *
+ * A model maps a pixel to the ray whose point at depth value d is d * Ray, and back.
+ */
+
+/** Pinhole camera, same conventions as CalculateSphericalFromDepth (depth is distance along X). */
+template<typename TIntrinsics>
+struct TPinholeCameraModel
+{
+    static_assert(TIntrinsics::FOVH > 0.0 && TIntrinsics::FOVH < 180.0, "Pinhole FOVH must be in (0, 180) degrees");
+    static_assert(TIntrinsics::Width > 0 && TIntrinsics::Height > 0, "Camera resolution must be positive");
+
+    static constexpr uint32 Width = TIntrinsics::Width;
+    static constexpr uint32 Height = TIntrinsics::Height;
+    /** Depth images of this model hold distance along the optical axis, not range. */
+    static constexpr bool bDepthIsRange = false;
+
+    static constexpr double TanHalfFOVH = MathToolkitConstexpr::Tan(MathToolkitConstexpr::DegreesToRadians(TIntrinsics::FOVH) * 0.5);
+    static constexpr double TanHalfFOVV = TanHalfFOVH * Height / Width;
+
+    // Slope = NDC * tan(half FOV) with NDC = 2 * pixel / size - 1, folded into Scale * pixel + Offset
+    static constexpr float SlopeYScale = static_cast<float>(2.0 * TanHalfFOVH / Width);
+    static constexpr float SlopeYOffset = static_cast<float>(-TanHalfFOVH);
+    static constexpr float SlopeZScale = static_cast<float>(-2.0 * TanHalfFOVV / Height);
+    static constexpr float SlopeZOffset = static_cast<float>(TanHalfFOVV);
+    static constexpr float FocalX = static_cast<float>(0.5 * Width / TanHalfFOVH);
+    static constexpr float FocalY = static_cast<float>(0.5 * Height / TanHalfFOVV);
+
+    static FORCEINLINE void PixelToRay(float x, float y, float& RayX, float& RayY, float& RayZ)
+    {
+        RayX = 1.0f;
+        RayY = x * SlopeYScale + SlopeYOffset;
+        RayZ = y * SlopeZScale + SlopeZOffset;
+    }
+
+    /** Pixel coordinates of a camera-space point; false when it lies behind the camera. */
+    static FORCEINLINE bool PointToPixel(float X, float Y, float Z, float& x, float& y)
+    {
+        const float InvX = 1.0f / X;
+        x = 0.5f * Width + Y * InvX * FocalX;
+        y = 0.5f * Height - Z * InvX * FocalY;
+        return X > 0.0f;
+    }
+
+    static FORCEINLINE void DirectionToPixel(float Azimuth, float Elevation, float& x, float& y)
+    {
+        PointToPixel(FMath::Cos(Azimuth), FMath::Sin(Azimuth), FMath::Tan(Elevation), x, y);
+    }
+};
+
+/**
+ * Equirectangular (latitude-longitude) camera: pixel columns are evenly spaced in azimuth over
+ * FOVH and rows evenly spaced in elevation over FOVH * Height / Width. Depth values are ranges.
+ */
+template<typename TIntrinsics>
+struct TEquirectangularCameraModel
+{
+    static_assert(TIntrinsics::FOVH > 0.0 && TIntrinsics::FOVH <= 360.0, "Equirectangular FOVH must be in (0, 360] degrees");
+    static_assert(TIntrinsics::Width > 0 && TIntrinsics::Height > 0, "Camera resolution must be positive");
+    static_assert(TIntrinsics::FOVH * TIntrinsics::Height / TIntrinsics::Width <= 180.0, "Vertical FOV cannot exceed 180 degrees");
+
+    static constexpr uint32 Width = TIntrinsics::Width;
+    static constexpr uint32 Height = TIntrinsics::Height;
+    static constexpr bool bDepthIsRange = true;
+
+    static constexpr double HalfFOVH = MathToolkitConstexpr::DegreesToRadians(TIntrinsics::FOVH) * 0.5;
+    static constexpr double HalfFOVV = HalfFOVH * Height / Width;
+
+    static constexpr float AzimuthScale = static_cast<float>(2.0 * HalfFOVH / Width);
+    static constexpr float AzimuthOffset = static_cast<float>(-HalfFOVH);
+    static constexpr float ElevationScale = static_cast<float>(-2.0 * HalfFOVV / Height);
+    static constexpr float ElevationOffset = static_cast<float>(HalfFOVV);
+    static constexpr float PixelsPerAzimuth = static_cast<float>(Width / (2.0 * HalfFOVH));
+    static constexpr float PixelsPerElevation = static_cast<float>(Height / (2.0 * HalfFOVV));
+
+    static FORCEINLINE void PixelToRay(float x, float y, float& RayX, float& RayY, float& RayZ)
+    {
+        float SinAzimuth, CosAzimuth, SinElevation, CosElevation;
+        FMath::SinCos(&SinAzimuth, &CosAzimuth, x * AzimuthScale + AzimuthOffset);
+        FMath::SinCos(&SinElevation, &CosElevation, y * ElevationScale + ElevationOffset);
+        RayX = CosElevation * CosAzimuth;
+        RayY = CosElevation * SinAzimuth;
+        RayZ = SinElevation;
+    }
+
+    static FORCEINLINE bool PointToPixel(float X, float Y, float Z, float& x, float& y)
+    {
+        DirectionToPixel(FMath::Atan2(Y, X), FMath::Atan2(Z, FMath::Sqrt(X * X + Y * Y)), x, y);
+        return X != 0.0f || Y != 0.0f || Z != 0.0f;
+    }
+
+    static FORCEINLINE void DirectionToPixel(float Azimuth, float Elevation, float& x, float& y)
+    {
+        x = 0.5f * Width + Azimuth * PixelsPerAzimuth;
+        y = 0.5f * Height - Elevation * PixelsPerElevation;
+    }
+};
+
+/** Conversion kernels instantiated per camera model; the compile-time counterparts of MathToolkitLibrary's. */
+template<typename TModel>
+struct TCameraModelKernels
+{
+    /** CalculateSphericalFromDepth for this model: (range, azimuth, elevation) and the point, in cm. */
+    static std::pair<FVector, FVector> SphericalFromDepth(float Depth, float x, float y)
+    {
+        float RayX, RayY, RayZ;
+        TModel::PixelToRay(x, y, RayX, RayY, RayZ);
+        const FVector Point(Depth * RayX, Depth * RayY, Depth * RayZ);
+        const double HorizontalSq = Point.X * Point.X + Point.Y * Point.Y;
+        const FVector Spherical(
+            FMath::Sqrt(HorizontalSq + Point.Z * Point.Z),
+            FMath::Atan2(Point.Y, Point.X),
+            FMath::Atan2(Point.Z, FMath::Sqrt(HorizontalSq)));
+        return std::pair<FVector, FVector>(Spherical, Point);
+    }
+
+    /** CalculateNDCCoordinates for this model: pixel coordinates of a ray given as azimuth and elevation (rad). */
+    static std::pair<float, float> PixelFromAngles(float Azimuth, float Elevation)
+    {
+        float x, y;
+        TModel::DirectionToPixel(Azimuth, Elevation, x, y);
+        return std::pair<float, float>(x, y);
+    }
+
+    /**
+     * Whole-frame conversion into the X, Y, Z and Range channels of Out (empty channels are skipped,
+     * angle channels are not filled; use FDepthRayLUT when they are needed every frame).
+     * The ray of each pixel is computed once inline and every requested channel is written from it.
+     * For the pinhole model that is two multiply-adds with folded constants, cheaper than streaming
+     * a per-pixel table from memory; the equirectangular model pays two SinCos per pixel.
+     */
+    static void ConvertDepth(TConstArrayView<float> Depth, const FDepthPointCloudSoA& Out)
+    {
+        constexpr int32 NumPixels = static_cast<int32>(TModel::Width * TModel::Height);
+        check(Depth.Num() >= NumPixels);
+        check(Out.X.IsEmpty() || Out.X.Num() >= NumPixels);
+        check(Out.Y.IsEmpty() || Out.Y.Num() >= NumPixels);
+        check(Out.Z.IsEmpty() || Out.Z.Num() >= NumPixels);
+        check(Out.Range.IsEmpty() || Out.Range.Num() >= NumPixels);
+
+        const float* RESTRICT In = Depth.GetData();
+        float* RESTRICT OutX = Out.X.IsEmpty() ? nullptr : Out.X.GetData();
+        float* RESTRICT OutY = Out.Y.IsEmpty() ? nullptr : Out.Y.GetData();
+        float* RESTRICT OutZ = Out.Z.IsEmpty() ? nullptr : Out.Z.GetData();
+        float* RESTRICT OutRange = Out.Range.IsEmpty() ? nullptr : Out.Range.GetData();
+        for (uint32 y = 0; y < TModel::Height; ++y)
+        {
+            const uint32 Row = y * TModel::Width;
+            for (uint32 x = 0; x < TModel::Width; ++x)
+            {
+                float RayX, RayY, RayZ;
+                TModel::PixelToRay(static_cast<float>(x), static_cast<float>(y), RayX, RayY, RayZ);
+                const float D = In[Row + x];
+                if (OutX)
+                {
+                    OutX[Row + x] = D * RayX;
+                }
+                if (OutY)
+                {
+                    OutY[Row + x] = D * RayY;
+                }
+                if (OutZ)
+                {
+                    OutZ[Row + x] = D * RayZ;
+                }
+                if (OutRange)
+                {
+                    OutRange[Row + x] = TModel::bDepthIsRange ? D : D * FMath::Sqrt(RayX * RayX + RayY * RayY + RayZ * RayZ);
+                }
+            }
+        }
+    }
+};
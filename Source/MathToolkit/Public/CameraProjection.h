@@ -0,0 +1,60 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Precomputed projection of a FOVH pinhole camera, the inverse of
+ * MathToolkitLibrary::CalculatePointCloudFromDepth: camera-space points (X forward, Y right,
+ * Z up, cm) map to the pixel (U, V) the depth conversion would have read them from, so rounding
+ * U and V gives the pixel index.
+ * An optional camera pose lets world-space points be projected directly.
+ */
+class MATHTOOLKIT_API FCameraProjection
+{
+public:
+    FCameraProjection(float FOVH, uint32 width, uint32 height, float InNearPlane = 1.0f);
+    FCameraProjection(const FTransform& CameraToWorld, float FOVH, uint32 width, uint32 height, float InNearPlane = 1.0f);
+
+    /** Points passed to Project are in world space from now on; scale is ignored. */
+    void SetCameraToWorld(const FTransform& CameraToWorld);
+    /** Points passed to Project are in camera space from now on. */
+    void ClearCameraToWorld();
+
+    /**
+     * Projects SoA points into pixel coordinates. Visible[i] is 1 when the point lies in front of the
+     * near plane and inside the image, 0 otherwise (behind the camera, outside the frustum or NaN);
+     * U and V of invisible points are set to -1. Returns the number of visible points.
+     */
+    int32 Project(
+        TConstArrayView<float> X,
+        TConstArrayView<float> Y,
+        TConstArrayView<float> Z,
+        TArrayView<float> U,
+        TArrayView<float> V,
+        TArrayView<uint8> Visible) const;
+
+    /** Same for FVector points; the camera offset is removed in double precision before projecting. */
+    int32 Project(TConstArrayView<FVector> Points, TArrayView<float> U, TArrayView<float> V, TArrayView<uint8> Visible) const;
+
+    /** Single point convenience wrapper; returns visibility. */
+    bool ProjectPoint(const FVector& Point, float& U, float& V) const;
+
+    float GetFocalX() const { return FocalX; }
+    float GetFocalY() const { return FocalY; }
+    float GetNearPlane() const { return NearPlane; }
+    bool HasCameraToWorld() const { return bHasPose; }
+
+private:
+    float FocalX;
+    float FocalY;
+    float CenterX;
+    float CenterY;
+    float Width;
+    float Height;
+    float NearPlane;
+
+    // World to camera: rows are the camera axes in world space, Origin the camera location
+    bool bHasPose;
+    FVector Axes[3];
+    FVector Origin;
+};
@@ -1,61 +1,201 @@
 #pragma once
 
-#include <array>
+#include "CoreMinimal.h"
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
 
 template<typename T, size_t S>
 class CircularBufferMT {
 public:
-    CircularBufferMT() : head_(0), tail_(0), full_(false) {}
+    static_assert(S > 0, "CircularBufferMT needs at least one slot");
+
+    using value_type = T;
+
+    // head_ and tail_ count evicted and inserted elements; they only map to slots through wrap(),
+    // which is a mask when S is a power of two. Only the slots between them hold constructed elements.
+    CircularBufferMT() : head_(0), tail_(0) {}
+
+    CircularBufferMT(const CircularBufferMT& other) : head_(0), tail_(0) {
+        other.for_each([this](const T& item) { put(item); });
+    }
+
+    CircularBufferMT(CircularBufferMT&& other) : head_(0), tail_(0) {
+        move_from(other);
+    }
+
+    CircularBufferMT& operator=(const CircularBufferMT& other) {
+        if (this != &other) {
+            clear();
+            other.for_each([this](const T& item) { put(item); });
+        }
+        return *this;
+    }
 
-    void put(T item) {
-        buffer_[tail_] = item;
-        
-        if (full_) {
-            head_ = (head_ + 1) % S;
+    CircularBufferMT& operator=(CircularBufferMT&& other) {
+        if (this != &other) {
+            clear();
+            move_from(other);
         }
-        
-        tail_ = (tail_ + 1) % S;
-        full_ = tail_ == head_;
+        return *this;
+    }
+
+    ~CircularBufferMT() {
+        clear();
     }
 
-    const std::array<T, S>& get_buffer() const {
-        return buffer_;
+    void put(const T& item) {
+        emplace(item);
+    }
+
+    void put(T&& item) {
+        emplace(std::move(item));
+    }
+
+    // Constructs the new element in place. When the buffer is full the new element is built before
+    // the oldest one is destroyed, since the arguments may refer to it (put(front())).
+    template<typename... Args>
+    T& emplace(Args&&... args) {
+        T* dest = slot(wrap(tail_));
+        if (full()) {
+            T item(std::forward<Args>(args)...);
+            dest->~T();
+            ++head_;
+            ::new (static_cast<void*>(dest)) T(std::move(item));
+        } else {
+            ::new (static_cast<void*>(dest)) T(std::forward<Args>(args)...);
+        }
+        ++tail_;
+        return *dest;
+    }
+
+    // Appends items in order; when more than S are given only the last S survive
+    void put_n(TConstArrayView<T> items) {
+        size_t count = static_cast<size_t>(items.Num());
+        const T* src = items.GetData();
+        if (count > S) {
+            src += count - S;
+            if constexpr (std::is_trivially_copyable_v<T>) {
+                tail_ += count - S;
+            } else {
+                clear();
+            }
+            count = S;
+        }
+
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            // Dead slots hold no object that would need constructing or destroying, so copy the raw bytes
+            const size_t start = wrap(tail_);
+            const size_t first = std::min(count, S - start);
+            std::memcpy(static_cast<void*>(slot(start)), src, first * sizeof(T));
+            std::memcpy(static_cast<void*>(slot(0)), src + first, (count - first) * sizeof(T));
+
+            tail_ += count;
+            if (tail_ - head_ > S) {
+                head_ = tail_ - S;
+            }
+        } else {
+            for (size_t i = 0; i < count; ++i) {
+                emplace(src[i]);
+            }
+        }
     }
 
-    size_t get_head() const { return head_; }
-    size_t get_tail() const { return tail_; }
+    // Removes the oldest element; the buffer must not be empty
+    void pop_front() {
+        check(!empty());
+        slot(wrap(head_))->~T();
+        ++head_;
+    }
+
+    void clear() {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            while (!empty()) {
+                pop_front();
+            }
+        }
+        head_ = tail_ = 0;
+    }
+
+    // Physical storage of S slots; only those from get_head() up to get_tail() hold live elements
+    const T* get_buffer() const {
+        return slot(0);
+    }
+
+    // Oldest and newest element; the buffer must not be empty
+    const T& front() const { return *slot(wrap(head_)); }
+    const T& back() const { return *slot(wrap(tail_ - 1)); }
+
+    // Physical slot indices of the oldest element and of the next write
+    size_t get_head() const { return wrap(head_); }
+    size_t get_tail() const { return wrap(tail_); }
     
     bool empty() const {
-        return (!full_ && (head_ == tail_));
+        return head_ == tail_;
     }
 
     bool full() const {
-        return full_;
+        return tail_ - head_ == S;
     }
 
     size_t size() const {
-        if (full_) return S;
-        if (tail_ >= head_) return tail_ - head_;
-        return S - (head_ - tail_);
+        return tail_ - head_;
+    }
+
+    static constexpr size_t capacity() { return S; }
+
+    // The live elements oldest to newest as at most two linear spans; the second is empty
+    // unless the contents wrap around the end of the storage
+    std::pair<TConstArrayView<T>, TConstArrayView<T>> contiguous_segments() const {
+        const size_t start = wrap(head_);
+        const size_t count = size();
+        const size_t first = std::min(count, S - start);
+        return std::make_pair(
+            TConstArrayView<T>(slot(start), static_cast<int32>(first)),
+            TConstArrayView<T>(slot(0), static_cast<int32>(count - first)));
     }
 
     // Iterator access for reading in correct order
     template<typename Func>
     void for_each(Func f) const {
-        if (empty()) return;
-        
-        size_t idx = head_;
-        size_t count = size();
-        
-        for (size_t i = 0; i < count; ++i) {
-            f(buffer_[idx]);
-            idx = (idx + 1) % S;
+        const std::pair<TConstArrayView<T>, TConstArrayView<T>> segments = contiguous_segments();
+        for (const T& item : segments.first) {
+            f(item);
+        }
+        for (const T& item : segments.second) {
+            f(item);
         }
     }
 
 private:
-    std::array<T, S> buffer_;
+    static constexpr bool bPowerOfTwo = (S & (S - 1)) == 0;
+
+    static size_t wrap(size_t index) {
+        if constexpr (bPowerOfTwo) {
+            return index & (S - 1);
+        } else {
+            return index % S;
+        }
+    }
+
+    T* slot(size_t index) {
+        return reinterpret_cast<T*>(storage_) + index;
+    }
+    const T* slot(size_t index) const {
+        return reinterpret_cast<const T*>(storage_) + index;
+    }
+
+    void move_from(CircularBufferMT& other) {
+        for (size_t i = other.head_; i != other.tail_; ++i) {
+            emplace(std::move(*other.slot(wrap(i))));
+        }
+        other.clear();
+    }
+
+    alignas(T) unsigned char storage_[sizeof(T) * S];
     size_t head_;
     size_t tail_;
-    bool full_;
 };
@@ -0,0 +1,132 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "DepthRayLUT.h"
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/** Wall-clock seconds each stage of one frame took. */
+struct FDepthFrameTimings
+{
+    /** Copying the depth image into the pipeline (on the submitting thread). */
+    double CaptureSeconds = 0.0;
+    /** From submission until the conversion started. */
+    double QueueSeconds = 0.0;
+    /** Tiled conversion of the whole frame. */
+    double ConvertSeconds = 0.0;
+    int32 NumTiles = 0;
+};
+
+/** One converted frame, organized: every channel is width * height in depth pixel order. */
+struct FDepthFrame
+{
+    uint64 FrameNumber = 0;
+    TArray<float> Depth;
+    TArray<float> X;
+    TArray<float> Y;
+    TArray<float> Z;
+    TArray<float> Range;
+    TArray<float> Azimuth;
+    TArray<float> Elevation;
+    FDepthFrameTimings Timings;
+
+    FDepthPointCloudSoA GetPointCloud() { return FDepthPointCloudSoA{X, Y, Z, Range, Azimuth, Elevation}; }
+};
+
+/**
+ * Converts a stream of depth frames into organized point clouds. Each frame is split into row tiles
+ * sized to stay in cache and the tiles run through ParallelFor; with bAsync a worker thread converts
+ * frame N while the caller captures and submits frame N + 1. Frames are handed back in submission
+ * order and their buffers are recycled, so steady-state operation does not allocate.
+ */
+class MATHTOOLKIT_API FDepthFramePipeline
+{
+public:
+    struct FSettings
+    {
+        float FOVH = 90.0f;
+        uint32 Width = 0;
+        uint32 Height = 0;
+        /** Rows per ParallelFor task; 0 picks about 32 KiB of depth per tile. */
+        int32 RowsPerTile = 0;
+        /** Frames that may be submitted but not yet released. */
+        int32 NumFrames = 2;
+        /** Also fill Range, Azimuth and Elevation. */
+        bool bSpherical = true;
+        bool bParallel = true;
+        /** Convert on a worker thread; otherwise Submit converts before returning. */
+        bool bAsync = true;
+    };
+
+    explicit FDepthFramePipeline(const FSettings& InSettings);
+    ~FDepthFramePipeline();
+
+    FDepthFramePipeline(const FDepthFramePipeline&) = delete;
+    FDepthFramePipeline& operator=(const FDepthFramePipeline&) = delete;
+
+    /**
+     * Copies Depth (width * height, cm) into the next free frame and queues it. Returns false without
+     * copying when every frame is still in flight; the caller decides whether to drop or retry.
+     */
+    bool Submit(TConstArrayView<float> Depth);
+
+    /**
+     * Blocks until the oldest submitted frame is converted and returns it, or nullptr when nothing
+     * is in flight. The frame stays valid until ReleaseFrame.
+     */
+    FDepthFrame* WaitForFrame();
+    void ReleaseFrame();
+
+    /** Number of frames submitted and not yet released. */
+    int32 NumInFlight() const;
+
+    const FSettings& GetSettings() const { return Settings; }
+    int32 GetRowsPerTile() const { return RowsPerTile; }
+
+    /** The tiled conversion on its own, for callers that manage their own frames. Returns the tile count. */
+    static int32 ConvertTiled(const FDepthRayLUT& LUT, TConstArrayView<float> Depth, const FDepthPointCloudSoA& Out, int32 RowsPerTile, bool bParallel);
+
+    /** Rows per tile keeping about 32 KiB of depth per tile. */
+    static int32 GetDefaultRowsPerTile(uint32 width);
+
+private:
+    enum class ESlotState : uint8
+    {
+        Free,
+        Capturing,
+        Queued,
+        Converting,
+        Ready,
+        Consuming,
+    };
+
+    struct FSlot
+    {
+        FDepthFrame Frame;
+        ESlotState State = ESlotState::Free;
+        double SubmitTime = 0.0;
+    };
+
+    void Convert(FSlot& Slot);
+    void WorkerLoop();
+
+    FSettings Settings;
+    int32 RowsPerTile;
+    TSharedPtr<const FDepthRayLUT> LUT;
+
+    // Slots are used round robin: submission, conversion and consumption each walk the ring in order
+    std::vector<FSlot> Slots;
+    int32 NextSubmit = 0;
+    int32 NextConvert = 0;
+    int32 NextConsume = 0;
+    uint64 FrameCounter = 0;
+
+    mutable std::mutex Mutex;
+    std::condition_variable WorkAvailable;
+    std::condition_variable FrameReady;
+    bool bStopping = false;
+    std::thread Worker;
+};
@@ -0,0 +1,141 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "MathToolkitLibrary.h"
+
+#include <vector>
+
+/**
+ * Per-pixel ray lookup table of a depth camera, built once per (FOVH, width, height).
+ * Turns a depth frame into points with one multiply per pixel and channel; the ray angles are
+ * depth independent and are copied straight out of the table.
+ */
+class MATHTOOLKIT_API FDepthRayLUT
+{
+public:
+    FDepthRayLUT(float FOVH, uint32 width, uint32 height);
+
+    float GetFOVH() const { return FOVH; }
+    uint32 GetWidth() const { return Width; }
+    uint32 GetHeight() const { return Height; }
+    float GetTanHalfFOVH() const { return TanHalfFOVH; }
+    float GetTanHalfFOVV() const { return TanHalfFOVV; }
+
+    bool Matches(float InFOVH, uint32 InWidth, uint32 InHeight) const
+    {
+        return FOVH == InFOVH && Width == InWidth && Height == InHeight;
+    }
+
+    /** Y / X of the ray through each column. */
+    const TArray<float>& GetColumnSlopes() const { return ColumnSlope; }
+    /** Z / X of the ray through each row. */
+    const TArray<float>& GetRowSlopes() const { return RowSlope; }
+    /** Azimuth (rad) of each column. */
+    const TArray<float>& GetColumnAzimuths() const { return ColumnAzimuth; }
+    /** Range / depth of every pixel. */
+    const TArray<float>& GetRangeScales() const { return RangeScale; }
+    /** Elevation (rad) of every pixel. */
+    const TArray<float>& GetElevations() const { return Elevation; }
+
+    /** Same output as MathToolkitLibrary::CalculatePointCloudFromDepth for this camera. */
+    void Convert(TConstArrayView<float> Depth, const FDepthPointCloudSoA& Out) const;
+    /** Convert restricted to rows [FirstRow, FirstRow + NumRows); Depth and Out still span the whole frame. */
+    void ConvertRows(TConstArrayView<float> Depth, const FDepthPointCloudSoA& Out, uint32 FirstRow, uint32 NumRows) const;
+
+    /**
+     * Narrow outputs for bandwidth-bound consumers, encoded in the conversion pass itself. Points are
+     * in the UE frame like Convert, divided by Scale (cm per stored unit: 1 stores cm, 0.1 mm, 100 m).
+     *
+     * ConvertHalf writes interleaved IEEE binary16 X, Y, Z (6 bytes per point, 3 * width * height
+     * values): 11 significant bits, so about 0.05% relative error, and infinity past 65504 units.
+     */
+    void ConvertHalf(TConstArrayView<float> Depth, TArrayView<uint16> OutXYZ, float Scale = 1.0f) const;
+    /** Interleaved int16 fixed-point X, Y, Z (6 bytes per point), rounded and saturated to +-32767 units. */
+    void ConvertFixed16(TConstArrayView<float> Depth, TArrayView<int16> OutXYZ, float Scale) const;
+    /**
+     * Organized uint16 range image (2 bytes per pixel), rounded and saturated to 65535 units. Pixels
+     * with depth <= 0 or NaN encode as 0, so 0 reads as "no return". NaN depths also encode as 0 in
+     * ConvertFixed16, while ConvertHalf keeps them NaN.
+     */
+    void ConvertRangeImage(TConstArrayView<float> Depth, TArrayView<uint16> OutRange, float Scale) const;
+
+    /** Heap memory held by the table, in bytes. */
+    SIZE_T GetAllocatedSize() const;
+
+private:
+    float FOVH;
+    uint32 Width;
+    uint32 Height;
+    float TanHalfFOVH;
+    float TanHalfFOVV;
+
+    TArray<float> ColumnSlope;
+    TArray<float> RowSlope;
+    TArray<float> ColumnAzimuth;
+    TArray<float> RangeScale;
+    TArray<float> Elevation;
+};
+
+/**
+ * Process-wide cache sharing ray LUTs between sensors with identical intrinsics.
+ * Tables still referenced by a sensor are never evicted; unreferenced ones are kept until the
+ * cache grows past its byte budget and are then dropped least recently used first.
+ */
+class MATHTOOLKIT_API FDepthRayLUTCache
+{
+public:
+    static FDepthRayLUTCache& Get();
+
+    /** Returns the shared table for these intrinsics, building it on first use. */
+    TSharedPtr<const FDepthRayLUT> FindOrBuild(float FOVH, uint32 width, uint32 height);
+    /** Whether a table for these intrinsics is currently cached. */
+    bool Contains(float FOVH, uint32 width, uint32 height) const;
+
+    /** Bytes held by all cached tables. */
+    SIZE_T GetAllocatedSize() const;
+    int32 Num() const;
+
+    /** Budget above which unreferenced tables get evicted; 0 (the default) disables eviction. */
+    void SetMaxAllocatedSize(SIZE_T Bytes);
+    SIZE_T GetMaxAllocatedSize() const;
+
+    /** Drops every table no sensor references any more. */
+    void Trim();
+
+private:
+    struct FEntry
+    {
+        TSharedPtr<const FDepthRayLUT> LUT;
+        uint64 LastUsed;
+    };
+
+    void EvictToBudget();
+
+    mutable FCriticalSection CriticalSection;
+    std::vector<FEntry> Entries;
+    uint64 UseCounter = 0;
+    SIZE_T MaxAllocatedSize = 0;
+};
+
+/**
+ * Per-sensor reference into FDepthRayLUTCache. Resolve is a field compare while the intrinsics
+ * stay the same and only goes back to the cache when they change.
+ */
+class MATHTOOLKIT_API FDepthRayLUTHandle
+{
+public:
+    const FDepthRayLUT& Resolve(float FOVH, uint32 width, uint32 height)
+    {
+        if (!LUT.IsValid() || !LUT->Matches(FOVH, width, height))
+        {
+            LUT = FDepthRayLUTCache::Get().FindOrBuild(FOVH, width, height);
+        }
+        return *LUT;
+    }
+
+    void Reset() { LUT.Reset(); }
+
+private:
+    TSharedPtr<const FDepthRayLUT> LUT;
+};
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include <utility>
+
+/**
+ * UE <-> ROS frame conversion and depth unprojection written once for float and double, so a caller
+ * holding FVector3d stays in double end to end and a throughput path holding FVector3f never widens.
+ * MathToolkitLibrary's FVector functions are the double instantiation.
+ */
+template<typename T>
+struct TFrameConversion
+{
+    static_assert(std::is_floating_point<T>::value, "TFrameConversion needs float or double");
+
+    typedef UE::Math::TVector<T> FVectorType;
+
+    /** UE cm, left-handed (Y right) -> ROS m, right-handed (Y left). */
+    static FORCEINLINE FVectorType UEToROS(const FVectorType& UEVector)
+    {
+        return FVectorType(UEVector.X / T(100), -UEVector.Y / T(100), UEVector.Z / T(100));
+    }
+
+    static FORCEINLINE FVectorType ROSToUE(const FVectorType& ROSVector)
+    {
+        return FVectorType(ROSVector.X * T(100), -ROSVector.Y * T(100), ROSVector.Z * T(100));
+    }
+
+    /** Batched versions; Out may alias In. */
+    static void UEToROS(TConstArrayView<FVectorType> In, TArrayView<FVectorType> Out)
+    {
+        Scale(In, Out, T(0.01), T(-0.01));
+    }
+
+    static void ROSToUE(TConstArrayView<FVectorType> In, TArrayView<FVectorType> Out)
+    {
+        Scale(In, Out, T(100), T(-100));
+    }
+
+    /** Tangents of the half FOVs of a FOVH (degrees) camera. */
+    static void TanHalfFOV(T FOVH, uint32 width, uint32 height, T& tanHalfFOVH, T& tanHalfFOVV)
+    {
+        tanHalfFOVH = FMath::Tan(FMath::DegreesToRadians(FOVH) / T(2));
+        tanHalfFOVV = tanHalfFOVH * static_cast<T>(height) / static_cast<T>(width);
+    }
+
+    /** MathToolkitLibrary::CalculateSphericalFromDepth in T: (range, azimuth, elevation) and the point in cm. */
+    static std::pair<FVectorType, FVectorType> SphericalFromDepth(T Depth, T x, T y, T tanHalfFOVH, T tanHalfFOVV, uint32 width, uint32 height)
+    {
+        const T NDC_X = T(2) * x / static_cast<T>(width) - T(1);
+        const T NDC_Y = T(1) - T(2) * y / static_cast<T>(height);
+        const FVectorType Point(Depth, NDC_X * Depth * tanHalfFOVH, NDC_Y * Depth * tanHalfFOVV);
+
+        const T HorizontalSq = Point.X * Point.X + Point.Y * Point.Y;
+        const FVectorType Spherical(
+            FMath::Sqrt(HorizontalSq + Point.Z * Point.Z),
+            FMath::Atan2(Point.Y, Point.X),
+            FMath::Atan2(Point.Z, FMath::Sqrt(HorizontalSq)));
+        return std::pair<FVectorType, FVectorType>(Spherical, Point);
+    }
+
+private:
+    static void Scale(TConstArrayView<FVectorType> In, TArrayView<FVectorType> Out, T AxisScale, T FlippedScale)
+    {
+        check(Out.Num() == In.Num());
+        const FVectorType* Src = In.GetData();
+        FVectorType* Dst = Out.GetData();
+        for (int32 i = 0; i < In.Num(); ++i)
+        {
+            const FVectorType P = Src[i];
+            Dst[i] = FVectorType(P.X * AxisScale, P.Y * FlippedScale, P.Z * AxisScale);
+        }
+    }
+};
+
+/**
+ * Float working frame around a double origin for large worlds. A float keeps a rounding error of
+ * at most |x| * 2^-24, i.e. 1.2 mm at 20 km from the origin but 0.06 mm within 1 km, so points are
+ * stored relative to a nearby origin and only the origin stays in double.
+ */
+class MATHTOOLKIT_API FRebasedFrame
+{
+public:
+    explicit FRebasedFrame(const FVector& InOrigin = FVector::ZeroVector) : Origin(InOrigin) {}
+
+    const FVector& GetOrigin() const { return Origin; }
+    void SetOrigin(const FVector& InOrigin) { Origin = InOrigin; }
+    /** The origin in ROS coordinates (m), to add back to ToROSLocal output. */
+    FVector GetROSOrigin() const { return TFrameConversion<double>::UEToROS(Origin); }
+
+    FVector3f ToLocal(const FVector& World) const { return FVector3f(World - Origin); }
+    FVector ToWorld(const FVector3f& Local) const { return Origin + FVector(Local); }
+
+    void ToLocal(TConstArrayView<FVector> World, TArrayView<FVector3f> Local) const;
+    void ToWorld(TConstArrayView<FVector3f> Local, TArrayView<FVector> World) const;
+
+    /**
+     * UE world points to interleaved float ROS coordinates (m) relative to GetROSOrigin(); the origin is
+     * subtracted in double before narrowing. PointStride as in MathToolkitLibrary::ConvertUEToROS.
+     */
+    void ToROSLocal(TConstArrayView<FVector> World, TArrayView<float> OutXYZ, int32 PointStride = 3) const;
+
+    /** Worst-case rounding error (cm) of World once stored as a local float. */
+    double GetLocalError(const FVector& World) const;
+
+    /** Distance from the origin (cm) within which local floats stay within Tolerance (cm). */
+    static double GetSafeRadius(double Tolerance);
+
+    /** Moves the origin onto World when World is too far out for Tolerance; returns whether it moved. */
+    bool RebaseIfNeeded(const FVector& World, double Tolerance);
+
+private:
+    FVector Origin;
+};
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "LidarResampler.h"
+
+/**
+ * Motion compensation for a spinning lidar: every column of a scan is captured at its own time, so
+ * with the sensor moving the points of one scan are expressed in different frames. The de-skew maps
+ * each point into the sensor frame at the end of the scan, p_end = R(dt) * p + v * dt with
+ * dt = column time - scan end (<= 0) and R(dt) the rotation by angular velocity * dt.
+ *
+ * The per-column rotation and translation are computed once per SetMotion, so the per-point work is
+ * a 3x3 multiply-add in one vectorized pass over [channel][column] SoA points. ConvertRanges fuses
+ * this with the range-to-point conversion of FLidarResampler output, so de-skewing does not add a
+ * pass over the cloud.
+ */
+class MATHTOOLKIT_API FLidarDeskew
+{
+public:
+    /**
+     * Columns of Spec fired in order over ScanPeriod, column 0 first and the last one at the scan end.
+     * ScanPeriod is in the time unit of the velocities given to SetMotion.
+     */
+    FLidarDeskew(const FLidarSpec& Spec, float ScanPeriod);
+
+    int32 GetNumChannels() const { return NumChannels; }
+    int32 GetNumColumns() const { return NumColumns; }
+
+    /**
+     * Overrides the uniform column times: one time per column, relative to the scan end (<= 0).
+     * The per-column transforms are rebuilt for the current motion.
+     */
+    void SetColumnTimes(TConstArrayView<float> Times);
+    const TArray<float>& GetColumnTimes() const { return ColumnTimes; }
+
+    /**
+     * Sensor motion during the scan, both in the sensor frame at the scan end: linear velocity in cm
+     * and angular velocity (axis * rate) in rad per time unit. Rebuilds the per-column transforms.
+     */
+    void SetMotion(const FVector& LinearVelocity, const FVector& AngularVelocity = FVector::ZeroVector);
+
+    /**
+     * SetMotion from a world-frame velocity such as the vector_fit_a slope of
+     * MathToolkitLibrary::calculateLinearFit over the sensor's positions; SensorRotation is the
+     * sensor's world rotation at the scan end. The velocity is per fit timestamp unit, so
+     * ScanPeriod and column times must use that unit too.
+     */
+    void SetMotionFromFit(const FVector& vector_fit_a, const FQuat& SensorRotation, const FVector& AngularVelocity = FVector::ZeroVector);
+
+    /** De-skews UE points (cm) in place; each view holds GetNumChannels() * GetNumColumns() floats. */
+    void Apply(TArrayView<float> X, TArrayView<float> Y, TArrayView<float> Z) const;
+
+    /**
+     * Ranges (cm, e.g. from FLidarResampler::Resample) straight to de-skewed points. Beams with a
+     * range <= 0 stay at the origin so they remain recognizable as missing.
+     */
+    void ConvertRanges(TConstArrayView<float> Range, TArrayView<float> X, TArrayView<float> Y, TArrayView<float> Z) const;
+
+private:
+    int32 NumChannels;
+    int32 NumColumns;
+    TArray<float> ColumnTimes;
+
+    // Unit beam directions, [channel][column]
+    TArray<float> DirX;
+    TArray<float> DirY;
+    TArray<float> DirZ;
+
+    // Per-column rotation (row-major, R[Row * 3 + Col]) and translation, each NumColumns long
+    TArray<float> Rotation[9];
+    TArray<float> Translation[3];
+    FVector LinearVelocity;
+    FVector AngularVelocity;
+    bool bHasMotion;
+};
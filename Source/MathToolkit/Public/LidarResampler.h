@@ -0,0 +1,84 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Beam layout of a spinning lidar: one elevation per channel and evenly spaced azimuth columns over
+ * a full turn. Azimuth follows CalculateSphericalFromDepth (positive towards +Y, i.e. to the right).
+ */
+struct MATHTOOLKIT_API FLidarSpec
+{
+    /** Elevation of each channel in degrees, in the order the sensor reports them. */
+    TArray<float> ElevationAngles;
+    /** Degrees between neighbouring azimuth columns. */
+    float HorizontalResolution = 0.2f;
+    /** Azimuth of column 0 in degrees. */
+    float AzimuthStart = -180.0f;
+
+    int32 GetNumChannels() const { return ElevationAngles.Num(); }
+    int32 GetNumColumns() const { return FMath::Max(1, FMath::RoundToInt(360.0f / HorizontalResolution)); }
+    int32 GetNumBeams() const { return GetNumChannels() * GetNumColumns(); }
+
+    /** Channels spread evenly from MaxElevation down to MinElevation. */
+    static FLidarSpec MakeUniform(int32 NumChannels, float MinElevation, float MaxElevation, float HorizontalResolution);
+
+    /** Direction of every beam in radians, [channel][column] row-major. */
+    void CalculateBeamAngles(TArrayView<float> Azimuth, TArrayView<float> Elevation) const;
+};
+
+/**
+ * Resamples a depth camera image onto the beams of a lidar grid. For every beam that falls inside
+ * the camera frustum the sampled pixel, bilinear weights and depth-to-range scale are computed once,
+ * so a frame costs four loads and a few multiplies per beam instead of converting every pixel.
+ * Several cameras with different yaws can fill the same output grid; each beam is owned by exactly
+ * one of them as long as their fields of view tile the turn without gaps.
+ */
+class MATHTOOLKIT_API FLidarResampler
+{
+public:
+    /** CameraYaw: azimuth (degrees) the camera looks along, in the lidar frame. */
+    FLidarResampler(const FLidarSpec& Spec, float FOVH, uint32 width, uint32 height, float CameraYaw = 0.0f);
+
+    /**
+     * Writes the range (cm) of every beam this camera covers into OutRange ([channel][column],
+     * GetNumChannels() * GetNumColumns() floats) and leaves the other beams untouched. Beams
+     * without a valid (positive) depth get 0.
+     */
+    void Resample(TConstArrayView<float> Depth, TArrayView<float> OutRange) const;
+
+    /**
+     * Bilinear interpolation across a depth edge would invent points between foreground and
+     * background, so where the four neighbours differ by more than this fraction of the nearest
+     * one the closest pixel is used instead. Defaults to 0.05.
+     */
+    void SetMaxRelativeDepthSpread(float Spread) { MaxRelativeDepthSpread = Spread; }
+    float GetMaxRelativeDepthSpread() const { return MaxRelativeDepthSpread; }
+
+    int32 GetNumChannels() const { return NumChannels; }
+    int32 GetNumColumns() const { return NumColumns; }
+    /** Beams covered by this camera. */
+    int32 GetNumBeams() const { return Samples.Num(); }
+
+    /** Heap memory held by the sample table, in bytes. */
+    SIZE_T GetAllocatedSize() const { return Samples.GetAllocatedSize(); }
+
+private:
+    struct FBeamSample
+    {
+        /** Output index, channel * NumColumns + column. */
+        int32 Beam;
+        /** Top-left pixel of the 2x2 neighbourhood and the pixel closest to the beam. */
+        int32 Pixel;
+        int32 Nearest;
+        float Weights[4];
+        /** Range / depth along the beam. */
+        float RangeScale;
+    };
+
+    int32 NumChannels;
+    int32 NumColumns;
+    uint32 Width;
+    uint32 Height;
+    float MaxRelativeDepthSpread;
+    TArray<FBeamSample> Samples;
+};
@@ -0,0 +1,206 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include <array>
+#include <atomic>
+#include <limits>
+#include <utility>
+
+/**
+ * Bounded lock-free single-producer / single-consumer ring buffer for handing samples from one
+ * thread to another (e.g. game thread -> ROS publisher) without a mutex.
+ *
+ * Unlike CircularBufferMT a full buffer rejects new items instead of overwriting the oldest one:
+ * the consumer may be reading that slot. Head and tail are monotonic counters on their own cache
+ * lines, published with release stores and read with acquire loads; each side also caches the
+ * other side's index so the shared line is only touched when the cached value runs out.
+ * S must be a power of two.
+ */
+template<typename T, size_t S>
+class SpscRingBufferMT {
+public:
+    static_assert(S >= 2 && (S & (S - 1)) == 0, "SpscRingBufferMT capacity must be a power of two");
+
+    static constexpr size_t capacity() { return S; }
+
+    // Producer side
+    bool try_push(const T& item) { return emplace_impl(item); }
+    bool try_push(T&& item) { return emplace_impl(std::move(item)); }
+
+    // Consumer side: pops the oldest item, false if the buffer is empty
+    bool try_pop(T& out) {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        if (head == cached_tail_) {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            if (head == cached_tail_) {
+                return false;
+            }
+        }
+        out = std::move(buffer_[head & Mask]);
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side: pops up to max_items in order, calling f on each, and publishes the new head once
+    template<typename Func>
+    size_t drain(Func f, size_t max_items = std::numeric_limits<size_t>::max()) {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        cached_tail_ = tail_.load(std::memory_order_acquire);
+        const size_t count = FMath::Min(cached_tail_ - head, max_items);
+        for (size_t i = 0; i < count; ++i) {
+            f(std::move(buffer_[(head + i) & Mask]));
+        }
+        if (count > 0) {
+            head_.store(head + count, std::memory_order_release);
+        }
+        return count;
+    }
+
+    // Consumer side: bulk pop into a caller-owned array, returns the number of items written
+    size_t drain_into(TArrayView<T> out) {
+        T* dest = out.GetData();
+        return drain([&dest](T&& item) { *dest++ = std::move(item); }, static_cast<size_t>(out.Num()));
+    }
+
+    // Exact only when called from one of the two sides with the other one idle
+    size_t size_approx() const {
+        return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+    }
+    bool empty() const { return size_approx() == 0; }
+
+private:
+    static constexpr size_t Mask = S - 1;
+
+    template<typename U>
+    bool emplace_impl(U&& item) {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - cached_head_ == S) {
+            cached_head_ = head_.load(std::memory_order_acquire);
+            if (tail - cached_head_ == S) {
+                return false;
+            }
+        }
+        buffer_[tail & Mask] = std::forward<U>(item);
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer-owned line
+    alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<size_t> head_{0};
+    size_t cached_tail_ = 0;
+
+    // Producer-owned line
+    alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<size_t> tail_{0};
+    size_t cached_head_ = 0;
+
+    alignas(PLATFORM_CACHE_LINE_SIZE) std::array<T, S> buffer_;
+};
+
+/**
+ * Bounded lock-free multi-producer / single-consumer ring buffer (Vyukov's sequence-per-slot
+ * queue). Producers claim a slot with a CAS on the enqueue counter and publish it through the
+ * slot's sequence number, so a slow producer never blocks the others from claiming; the consumer
+ * side is wait-free. Same full-buffer and power-of-two rules as SpscRingBufferMT.
+ */
+template<typename T, size_t S>
+class MpscRingBufferMT {
+public:
+    static_assert(S >= 2 && (S & (S - 1)) == 0, "MpscRingBufferMT capacity must be a power of two");
+
+    MpscRingBufferMT() {
+        for (size_t i = 0; i < S; ++i) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpscRingBufferMT(const MpscRingBufferMT&) = delete;
+    MpscRingBufferMT& operator=(const MpscRingBufferMT&) = delete;
+
+    static constexpr size_t capacity() { return S; }
+
+    // Producer side, any thread
+    bool try_push(const T& item) { return emplace_impl(item); }
+    bool try_push(T&& item) { return emplace_impl(std::move(item)); }
+
+    // Consumer side, one thread only
+    bool try_pop(T& out) {
+        const size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+        Cell& cell = cells_[pos & Mask];
+        if (cell.sequence.load(std::memory_order_acquire) != pos + 1) {
+            return false;
+        }
+        out = std::move(cell.data);
+        // Hand the slot back to producers for the next lap
+        cell.sequence.store(pos + S, std::memory_order_release);
+        dequeue_pos_.store(pos + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    // Consumer side: pops published items in order until the first unpublished slot or max_items
+    template<typename Func>
+    size_t drain(Func f, size_t max_items = std::numeric_limits<size_t>::max()) {
+        size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+        size_t count = 0;
+        while (count < max_items) {
+            Cell& cell = cells_[pos & Mask];
+            if (cell.sequence.load(std::memory_order_acquire) != pos + 1) {
+                break;
+            }
+            f(std::move(cell.data));
+            cell.sequence.store(pos + S, std::memory_order_release);
+            ++pos;
+            ++count;
+        }
+        dequeue_pos_.store(pos, std::memory_order_relaxed);
+        return count;
+    }
+
+    size_t drain_into(TArrayView<T> out) {
+        T* dest = out.GetData();
+        return drain([&dest](T&& item) { *dest++ = std::move(item); }, static_cast<size_t>(out.Num()));
+    }
+
+    size_t size_approx() const {
+        const size_t enqueued = enqueue_pos_.load(std::memory_order_acquire);
+        const size_t dequeued = dequeue_pos_.load(std::memory_order_acquire);
+        return enqueued > dequeued ? enqueued - dequeued : 0;
+    }
+    bool empty() const { return size_approx() == 0; }
+
+private:
+    static constexpr size_t Mask = S - 1;
+
+    struct Cell {
+        std::atomic<size_t> sequence;
+        T data;
+    };
+
+    template<typename U>
+    bool emplace_impl(U&& item) {
+        size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+        Cell* cell;
+        for (;;) {
+            cell = &cells_[pos & Mask];
+            const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            const intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+            if (difference == 0) {
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (difference < 0) {
+                // The consumer has not freed this slot from the previous lap yet
+                return false;
+            } else {
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+        cell->data = std::forward<U>(item);
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<size_t> enqueue_pos_{0};
+    alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<size_t> dequeue_pos_{0};
+    alignas(PLATFORM_CACHE_LINE_SIZE) std::array<Cell, S> cells_;
+};
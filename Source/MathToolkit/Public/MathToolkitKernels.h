@@ -0,0 +1,61 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Vectorized batch kernels for the spherical conversions (AVX2, SSE2 or NEON, chosen at compile
+ * time, with a scalar fallback that evaluates the same polynomials).
+ * All views of one call must have the same length; outputs may alias inputs.
+ * Inputs are expected to be finite.
+ */
+class MATHTOOLKIT_API MathToolkitKernels
+{
+public:
+    /** Max absolute error of Atan / Atan2 in radians (minimax polynomial plus float rounding). */
+    static constexpr float AtanMaxError = 4.0e-7f;
+
+    /** Max absolute error of SinCos for |angle| <= 1000 rad. */
+    static constexpr float SinCosMaxError = 2.5e-7f;
+
+    /** "AVX2", "SSE2", "NEON" or "Scalar". */
+    static const TCHAR* GetSIMDPathName();
+
+    /** Floats processed per vector instruction. */
+    static int32 GetSIMDWidth();
+
+    static void Atan(TConstArrayView<float> In, TArrayView<float> Out);
+
+    static void Atan2(TConstArrayView<float> Y, TConstArrayView<float> X, TArrayView<float> Out);
+
+    static void SinCos(TConstArrayView<float> Angles, TArrayView<float> OutSin, TArrayView<float> OutCos);
+
+    /**
+     * (X, Y, Z) -> (range, azimuth, elevation) with azimuth = atan2(Y, X) and
+     * elevation = atan2(Z, hypot(X, Y)), the convention of CalculateSphericalFromDepth.
+     */
+    static void CartesianToSpherical(
+        TConstArrayView<float> X,
+        TConstArrayView<float> Y,
+        TConstArrayView<float> Z,
+        TArrayView<float> Range,
+        TArrayView<float> Azimuth,
+        TArrayView<float> Elevation
+    );
+
+    /**
+     * Multiplies the XYZ of every point of an interleaved float32 cloud by Scale, componentwise.
+     * PointStride is the number of floats per point (3 for packed XYZ, 4 for the common padded
+     * PointCloud2 layout); only the first three floats of each point are written. Out may be In.
+     */
+    static void ScaleInterleavedXYZ(TConstArrayView<float> In, TArrayView<float> Out, const FVector3f& Scale, int32 PointStride = 3);
+
+    /** Inverse of CartesianToSpherical. */
+    static void SphericalToCartesian(
+        TConstArrayView<float> Range,
+        TConstArrayView<float> Azimuth,
+        TConstArrayView<float> Elevation,
+        TArrayView<float> X,
+        TArrayView<float> Y,
+        TArrayView<float> Z
+    );
+};
@@ -2,7 +2,108 @@
 
 #include "CoreMinimal.h"
 #include "CircularBufferMT.h"
+#include "RingBufferMT.h"
+#include "MathToolkitStats.h"
 
+/**
+ * Caller-owned structure-of-arrays output of a whole-frame depth conversion.
+ * Each channel holds width * height floats in row-major pixel order; leave a channel empty to skip it.
+ * Cartesian channels are in cm (X forward, Y right, Z up), spherical ones are range in cm and
+ * azimuth/elevation in radians, matching the pair returned by CalculateSphericalFromDepth.
+ */
+struct FDepthPointCloudSoA
+{
+    TArrayView<float> X;
+    TArrayView<float> Y;
+    TArrayView<float> Z;
+    TArrayView<float> Range;
+    TArrayView<float> Azimuth;
+    TArrayView<float> Elevation;
+};
+
+/**
+ * Weighted regression moments of (timestamp, value) samples, shared by the linear, quadratic and
+ * robust fits so that one pass over a buffer feeds every model. Timestamps are accumulated relative
+ * to Origin (the newest sample for the buffer fits) to keep the higher powers well conditioned.
+ */
+struct FFitMoments
+{
+    double Origin = 0.0;
+    int32 N = 0;
+    double W = 0.0;
+    double Sx = 0.0;
+    double Sxx = 0.0;
+    double Sxxx = 0.0;
+    double Sxxxx = 0.0;
+    FVector Sy = FVector::ZeroVector;
+    FVector Sxy = FVector::ZeroVector;
+    FVector Sxxy = FVector::ZeroVector;
+
+    void Add(double Timestamp, const FVector& Value, double Weight = 1.0)
+    {
+        const double x = Timestamp - Origin;
+        const double wx = Weight * x;
+        const double wxx = wx * x;
+        ++N;
+        W += Weight;
+        Sx += wx;
+        Sxx += wxx;
+        Sxxx += wxx * x;
+        Sxxxx += wxx * x * x;
+        Sy += Value * Weight;
+        Sxy += Value * wx;
+        Sxxy += Value * wxx;
+    }
+
+    /** value = a * timestamp + b, with b at timestamp 0 like calculateLinearFit. False if degenerate. */
+    bool SolveLinear(FVector& vector_fit_a, FVector& vector_fit_b) const
+    {
+        const double denominator = W * Sxx - Sx * Sx;
+        if (N < 2 || FMath::IsNearlyZero(denominator))
+        {
+            return false;
+        }
+        vector_fit_a = (Sxy * W - Sy * Sx) / denominator;
+        vector_fit_b = (Sy - vector_fit_a * Sx) / W - vector_fit_a * Origin;
+        return true;
+    }
+
+    /**
+     * value = a2 * dt^2 + a1 * dt + a0 with dt = timestamp - Origin, so a0 and a1 are the fitted value
+     * and velocity at Origin and 2 * a2 the acceleration. False with fewer than three distinct timestamps.
+     */
+    bool SolveQuadratic(FVector& fit_a2, FVector& fit_a1, FVector& fit_a0) const
+    {
+        if (N < 3)
+        {
+            return false;
+        }
+        // Normal equations [W Sx Sxx; Sx Sxx Sxxx; Sxx Sxxx Sxxxx] * (a0, a1, a2) = (Sy, Sxy, Sxxy), by cofactors
+        const double C00 = Sxx * Sxxxx - Sxxx * Sxxx;
+        const double C01 = Sxxx * Sxx - Sx * Sxxxx;
+        const double C02 = Sx * Sxxx - Sxx * Sxx;
+        const double C11 = W * Sxxxx - Sxx * Sxx;
+        const double C12 = Sx * Sxx - W * Sxxx;
+        const double C22 = W * Sxx - Sx * Sx;
+        const double Det = W * C00 + Sx * C01 + Sxx * C02;
+        if (FMath::Abs(Det) <= UE_SMALL_NUMBER * FMath::Abs(W * Sxx * Sxxxx))
+        {
+            return false;
+        }
+        const double InvDet = 1.0 / Det;
+        fit_a0 = (Sy * C00 + Sxy * C01 + Sxxy * C02) * InvDet;
+        fit_a1 = (Sy * C01 + Sxy * C11 + Sxxy * C12) * InvDet;
+        fit_a2 = (Sy * C02 + Sxy * C12 + Sxxy * C22) * InvDet;
+        return true;
+    }
+};
+
+/** A pose in the ROS frame: position in m and orientation as a ROS (right-handed) quaternion. */
+struct FROSPose
+{
+    FVector Position;
+    FQuat Orientation;
+};
 
 /**
  * 
@@ -20,9 +121,75 @@ public:
 
     static FVector ConvertROSToUE(const FVector& ROSVector);
 
-    template <typename T, size_t S>
-    static void calculateLinearFit(const CircularBufferMT<T, S>& circBuffer, FVector& vector_fit_a, FVector& vector_fit_b, bool print = false);
+    /**
+     * Whole-cloud ConvertUEToROS / ConvertROSToUE with the axis flip and unit scale fused into one pass.
+     * Out must have the same length as In and may be In itself for in-place conversion.
+     */
+    static void ConvertUEToROS(TConstArrayView<FVector> In, TArrayView<FVector> Out);
+    static void ConvertROSToUE(TConstArrayView<FVector> In, TArrayView<FVector> Out);
+
+    /**
+     * Same conversions on interleaved float32 XYZ (the PointCloud2 layout), PointStride floats per point.
+     * Only XYZ is written, other fields of each point are left alone; Out may be In.
+     */
+    static void ConvertUEToROS(TConstArrayView<float> InXYZ, TArrayView<float> OutXYZ, int32 PointStride = 3);
+    static void ConvertROSToUE(TConstArrayView<float> InXYZ, TArrayView<float> OutXYZ, int32 PointStride = 3);
+
+    /** UE points straight into a caller-owned interleaved float32 ROS buffer of In.Num() * PointStride floats. */
+    static void ConvertUEToROS(TConstArrayView<FVector> In, TArrayView<float> OutXYZ, int32 PointStride = 3);
+
+    /**
+     * UE rotation to the same physical rotation in the ROS frame: mirroring Y turns (x, y, z, w) into (-x, y, -z, w).
+     * Unlike the Euler helpers this is a pure handedness change, without their 180 degree yaw offset.
+     */
+    static FQuat ConvertUEToROS(const FQuat& UERotation);
+    static FQuat ConvertROSToUE(const FQuat& ROSRotation);
+
+    /** Batch pose conversion straight between quaternions, with no Euler round trip; scale is dropped. */
+    static void ConvertUEToROS(TConstArrayView<FTransform> In, TArrayView<FROSPose> Out);
+    static void ConvertROSToUE(TConstArrayView<FROSPose> In, TArrayView<FTransform> Out);
+
+    /** Position + quaternion arrays; outputs may be the inputs for in-place conversion. */
+    static void ConvertUEToROS(TConstArrayView<FVector> Positions, TConstArrayView<FQuat> Rotations, TArrayView<FVector> OutPositions, TArrayView<FQuat> OutRotations);
+    static void ConvertROSToUE(TConstArrayView<FVector> Positions, TConstArrayView<FQuat> Rotations, TArrayView<FVector> OutPositions, TArrayView<FQuat> OutRotations);
+
+    /**
+     * The buffer fits take a CircularBufferMT or a RingBufferMT of TPair<FVector, timestamp>.
+     * print logs the fit through FMathToolkitStats::ReportFit, i.e. at most once per report interval.
+     */
+    template <typename TBuffer>
+    static void calculateLinearFit(const TBuffer& circBuffer, FVector& vector_fit_a, FVector& vector_fit_b, bool print = false);
 
+    /**
+     * One pass over the buffer into weighted moments about the newest timestamp.
+     * Weight(elem) returns the sample weight; the fits below are thin wrappers around this.
+     */
+    template <typename TBuffer, typename WeightFunc>
+    static FFitMoments calculateFitMoments(const TBuffer& circBuffer, WeightFunc Weight);
+
+    /** calculateLinearFit with a per-sample weight taken from Weight(elem). */
+    template <typename TBuffer, typename WeightFunc>
+    static void calculateWeightedLinearFit(const TBuffer& circBuffer, WeightFunc Weight, FVector& vector_fit_a, FVector& vector_fit_b);
+
+    /** Linear fit where a sample's weight halves every halfLife timestamp units back from the newest sample. */
+    template <typename TBuffer>
+    static void calculateDecayedLinearFit(const TBuffer& circBuffer, double halfLife, FVector& vector_fit_a, FVector& vector_fit_b);
+
+    /**
+     * Second-order fit about the newest timestamp: fit_a0 is the fitted value there, fit_a1 the velocity
+     * and 2 * fit_a2 the acceleration. Zero vectors with fewer than three samples.
+     */
+    template <typename TBuffer>
+    static void calculateQuadraticFit(const TBuffer& circBuffer, FVector& fit_a2, FVector& fit_a1, FVector& fit_a0);
+
+    /**
+     * Linear fit with Huber weights from iteratively reweighted least squares: samples whose residual
+     * distance exceeds huberDelta get weight huberDelta / residual, so single outliers cannot drag the fit.
+     */
+    template <typename TBuffer>
+    static void calculateRobustLinearFit(const TBuffer& circBuffer, double huberDelta, FVector& vector_fit_a, FVector& vector_fit_b, int32 iterations = 4);
+
+    /** Float precision throughout; TFrameConversion<double>::SphericalFromDepth keeps double inputs in double. */
     static std::pair<FVector,FVector> CalculateSphericalFromDepth(
         float distance, 
         float x, 
@@ -41,9 +208,36 @@ public:
         uint32 height
     );
     
+    /** Tangents of the half horizontal and half vertical FOV for a FOVH (degrees) camera of the given resolution. */
+    static void CalculateTanHalfFOV(float FOVH, uint32 width, uint32 height, float& tanHalfFOVHRad, float& tanHalfFOVVRad);
+
+    /**
+     * Batched CalculateSphericalFromDepth over a whole row-major depth frame (cm).
+     * Ray slopes are computed once per row and column, so the per-pixel work is a handful of multiplies.
+     */
+    static void CalculatePointCloudFromDepth(
+        TConstArrayView<float> Depth,
+        float FOVH,
+        uint32 width,
+        uint32 height,
+        const FDepthPointCloudSoA& Out
+    );
+    static void CalculatePointCloudFromDepth(
+        TConstArrayView<float> Depth,
+        float tanHalfFOVHRad,
+        float tanHalfFOVVRad,
+        uint32 width,
+        uint32 height,
+        const FDepthPointCloudSoA& Out
+    );
+
+    /**
+     * Pixel coordinates of the ray with the given azimuth and elevation (rad, as produced by
+     * CalculateSphericalFromDepth). For whole point sets use FCameraProjection.
+     */
     static std::pair<float, float> CalculateNDCCoordinates(
-    float alpha,
-    float beta,
+    float azimuth,
+    float elevation,
     float FOVH,
     uint32 width,
     uint32 height);
@@ -51,59 +245,122 @@ public:
     static float calculateHorizontalFOV(float senzorWidth, float focalLength);
 };
 
-template <typename T, size_t S>
-void MathToolkitLibrary::calculateLinearFit(const CircularBufferMT<T, S>& circBuffer, FVector& vector_fit_a, FVector& vector_fit_b, bool print)
+template <typename TBuffer>
+void MathToolkitLibrary::calculateLinearFit(const TBuffer& circBuffer, FVector& vector_fit_a, FVector& vector_fit_b, bool print)
 {
-    double sum_x = 0.0;
-    double sum_y[3] = {0.0, 0.0, 0.0};
-    double sum_xy[3] = {0.0, 0.0, 0.0};
-    double sum_xx = 0.0;
-    int n = 0;
-
-    // Calculate sums for regression using the iterator
-    circBuffer.for_each([&](const T& elem) {
-        double x = elem.Value;
-        sum_x += x;
-        sum_xx += x * x;
-
-        sum_y[0] += elem.Key.X;
-        sum_y[1] += elem.Key.Y;
-        sum_y[2] += elem.Key.Z;
-
-        sum_xy[0] += x * elem.Key.X;
-        sum_xy[1] += x * elem.Key.Y;
-        sum_xy[2] += x * elem.Key.Z;
-
-        n++;
-    });
-
-    if (n < 2)
+    MATHTOOLKIT_SCOPE(Fit);
+    MATHTOOLKIT_COUNT(FitsComputed, 1);
+    using T = typename TBuffer::value_type;
+    // Moments about the newest timestamp, so large timestamps do not cancel in n * sum_xx - sum_x^2
+    const FFitMoments moments = calculateFitMoments(circBuffer, [](const T&) { return 1.0; });
+    if (!moments.SolveLinear(vector_fit_a, vector_fit_b))
     {
         vector_fit_a = FVector::ZeroVector;
         vector_fit_b = FVector::ZeroVector;
         return;
     }
 
-    double denominator = n * sum_xx - sum_x * sum_x;
-    if (FMath::IsNearlyZero(denominator))
+    if (print)
+    {
+        FMathToolkitStats::Get().ReportFit(vector_fit_a, vector_fit_b);
+    }
+}
+
+template <typename TBuffer, typename WeightFunc>
+FFitMoments MathToolkitLibrary::calculateFitMoments(const TBuffer& circBuffer, WeightFunc Weight)
+{
+    using T = typename TBuffer::value_type;
+    FFitMoments moments;
+    if (circBuffer.empty())
+    {
+        return moments;
+    }
+
+    moments.Origin = circBuffer.back().Value;
+    const auto segments = circBuffer.contiguous_segments();
+    for (const TConstArrayView<T>& segment : { segments.first, segments.second })
+    {
+        const T* RESTRICT samples = segment.GetData();
+        for (int32 i = 0; i < segment.Num(); ++i)
+        {
+            moments.Add(samples[i].Value, samples[i].Key, Weight(samples[i]));
+        }
+    }
+    return moments;
+}
+
+template <typename TBuffer, typename WeightFunc>
+void MathToolkitLibrary::calculateWeightedLinearFit(const TBuffer& circBuffer, WeightFunc Weight, FVector& vector_fit_a, FVector& vector_fit_b)
+{
+    MATHTOOLKIT_SCOPE(Fit);
+    MATHTOOLKIT_COUNT(FitsComputed, 1);
+    if (!calculateFitMoments(circBuffer, Weight).SolveLinear(vector_fit_a, vector_fit_b))
+    {
+        vector_fit_a = FVector::ZeroVector;
+        vector_fit_b = FVector::ZeroVector;
+    }
+}
+
+template <typename TBuffer>
+void MathToolkitLibrary::calculateDecayedLinearFit(const TBuffer& circBuffer, double halfLife, FVector& vector_fit_a, FVector& vector_fit_b)
+{
+    using T = typename TBuffer::value_type;
+    check(halfLife > 0.0);
+    if (circBuffer.empty())
     {
         vector_fit_a = FVector::ZeroVector;
         vector_fit_b = FVector::ZeroVector;
         return;
     }
 
-    vector_fit_a.X = (n * sum_xy[0] - sum_x * sum_y[0]) / denominator;
-    vector_fit_a.Y = (n * sum_xy[1] - sum_x * sum_y[1]) / denominator;
-    vector_fit_a.Z = (n * sum_xy[2] - sum_x * sum_y[2]) / denominator;
+    const double newest = circBuffer.back().Value;
+    const double invHalfLife = 1.0 / halfLife;
+    calculateWeightedLinearFit(circBuffer, [newest, invHalfLife](const T& elem) {
+        return FMath::Exp2((static_cast<double>(elem.Value) - newest) * invHalfLife);
+    }, vector_fit_a, vector_fit_b);
+}
 
-    vector_fit_b.X = (sum_y[0] - vector_fit_a.X * sum_x) / n;
-    vector_fit_b.Y = (sum_y[1] - vector_fit_a.Y * sum_x) / n;
-    vector_fit_b.Z = (sum_y[2] - vector_fit_a.Z * sum_x) / n;
+template <typename TBuffer>
+void MathToolkitLibrary::calculateQuadraticFit(const TBuffer& circBuffer, FVector& fit_a2, FVector& fit_a1, FVector& fit_a0)
+{
+    MATHTOOLKIT_SCOPE(Fit);
+    MATHTOOLKIT_COUNT(FitsComputed, 1);
+    using T = typename TBuffer::value_type;
+    const FFitMoments moments = calculateFitMoments(circBuffer, [](const T&) { return 1.0; });
+    if (!moments.SolveQuadratic(fit_a2, fit_a1, fit_a0))
+    {
+        fit_a2 = FVector::ZeroVector;
+        fit_a1 = FVector::ZeroVector;
+        fit_a0 = FVector::ZeroVector;
+    }
+}
 
-    if (print)
+template <typename TBuffer>
+void MathToolkitLibrary::calculateRobustLinearFit(const TBuffer& circBuffer, double huberDelta, FVector& vector_fit_a, FVector& vector_fit_b, int32 iterations)
+{
+    using T = typename TBuffer::value_type;
+    check(huberDelta > 0.0);
+    calculateLinearFit(circBuffer, vector_fit_a, vector_fit_b);
+
+    for (int32 iteration = 0; iteration < iterations; ++iteration)
     {
-        UE_LOG(LogTemp, Warning, TEXT("Linear fit parameters:"));
-        UE_LOG(LogTemp, Warning, TEXT("a: %f, %f, %f"), vector_fit_a.X, vector_fit_a.Y, vector_fit_a.Z);
-        UE_LOG(LogTemp, Warning, TEXT("b: %f, %f, %f"), vector_fit_b.X, vector_fit_b.Y, vector_fit_b.Z);
+        const FVector a = vector_fit_a;
+        const FVector b = vector_fit_b;
+        FVector next_a, next_b;
+        const bool bSolved = calculateFitMoments(circBuffer, [&a, &b, huberDelta](const T& elem) {
+            const double residual = (elem.Key - (a * static_cast<double>(elem.Value) + b)).Size();
+            return residual <= huberDelta ? 1.0 : huberDelta / residual;
+        }).SolveLinear(next_a, next_b);
+
+        if (!bSolved)
+        {
+            return;
+        }
+        vector_fit_a = next_a;
+        vector_fit_b = next_b;
+        if (next_a.Equals(a, UE_SMALL_NUMBER) && next_b.Equals(b, UE_SMALL_NUMBER))
+        {
+            return;
+        }
     }
 }
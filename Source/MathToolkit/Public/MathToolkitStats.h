@@ -0,0 +1,192 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+#include <atomic>
+
+/**
+ * Opt-in instrumentation for the hot paths. With MATHTOOLKIT_ENABLE_INSTRUMENTATION set to 1 the
+ * MATHTOOLKIT_SCOPE / MATHTOOLKIT_COUNT macros emit Unreal Insights CPU events and STATGROUP_MathToolkit
+ * stats, and feed FMathToolkitStats, which logs an aggregated summary to LogMathToolkit at most once per
+ * report interval. With it at 0 (the default) the macros compile to nothing.
+ */
+#ifndef MATHTOOLKIT_ENABLE_INSTRUMENTATION
+#define MATHTOOLKIT_ENABLE_INSTRUMENTATION 0
+#endif
+
+MATHTOOLKIT_API DECLARE_LOG_CATEGORY_EXTERN(LogMathToolkit, Log, All);
+
+/** Timed sections; each keeps its own latency histogram. */
+enum class EMathToolkitTimer : uint8
+{
+    Fit,
+    DepthConversion,
+    FrameConversion,
+    Projection,
+    LidarResample,
+    Serialize,
+    Filter,
+    Deskew,
+    Count
+};
+
+/** Work counters, reported as totals per report window. */
+enum class EMathToolkitCounter : uint8
+{
+    FitsComputed,
+    PointsConverted,
+    PointsProjected,
+    Count
+};
+
+/**
+ * Lock-free latency histogram with power-of-two nanosecond buckets: bucket i holds samples in
+ * [2^i, 2^(i+1)) ns, so percentiles are exact to within a factor of two at a fixed 32 counters.
+ */
+class MATHTOOLKIT_API FMathToolkitLatencyHistogram
+{
+public:
+    static constexpr int32 NumBuckets = 32;
+
+    void Add(uint64 Nanoseconds);
+    void Reset();
+
+    uint64 GetCount() const;
+    uint64 GetMaxNanoseconds() const { return MaxNanoseconds.load(std::memory_order_relaxed); }
+    double GetMeanNanoseconds() const;
+    /** Upper bound (ns) of the bucket holding the given percentile in [0, 1]; 0 when empty. */
+    uint64 GetPercentileNanoseconds(double Percentile) const;
+
+    static int32 GetBucket(uint64 Nanoseconds);
+
+private:
+    std::atomic<uint64> Buckets[NumBuckets] = {};
+    std::atomic<uint64> TotalNanoseconds{0};
+    std::atomic<uint64> MaxNanoseconds{0};
+};
+
+/**
+ * Process-wide aggregation behind the instrumentation macros. Counters and histograms cover the
+ * current report window; MaybeReport logs and restarts the window once ReportInterval has passed.
+ */
+class MATHTOOLKIT_API FMathToolkitStats
+{
+public:
+    static FMathToolkitStats& Get();
+
+    void AddCount(EMathToolkitCounter Counter, uint64 Amount)
+    {
+        Counters[static_cast<int32>(Counter)].fetch_add(Amount, std::memory_order_relaxed);
+    }
+    void AddLatency(EMathToolkitTimer Timer, uint64 Nanoseconds)
+    {
+        Histograms[static_cast<int32>(Timer)].Add(Nanoseconds);
+    }
+
+    uint64 GetCount(EMathToolkitCounter Counter) const
+    {
+        return Counters[static_cast<int32>(Counter)].load(std::memory_order_relaxed);
+    }
+    const FMathToolkitLatencyHistogram& GetHistogram(EMathToolkitTimer Timer) const
+    {
+        return Histograms[static_cast<int32>(Timer)];
+    }
+
+    /** Seconds between summaries; 0 disables reporting. Defaults to 5. */
+    void SetReportInterval(double Seconds);
+    double GetReportInterval() const;
+
+    /** Logs and resets the window when the interval has elapsed; every timed scope calls this on exit. */
+    bool MaybeReport();
+    /** Builds the summary of the current window and resets it. */
+    FString Flush();
+    void Reset();
+
+    /**
+     * Rate-limited replacement for per-call fit logging: counts the fit and logs the latest
+     * parameters with the number of fits since the last line, at most once per report interval
+     * (and never when reporting is disabled). Returns true when it logged.
+     */
+    bool ReportFit(const FVector& FitA, const FVector& FitB);
+
+    static const TCHAR* GetTimerName(EMathToolkitTimer Timer);
+    static const TCHAR* GetCounterName(EMathToolkitCounter Counter);
+
+private:
+    FMathToolkitStats();
+
+    static uint64 NowNanoseconds();
+    /** Claims the report slot for this interval; only one thread wins. */
+    static bool TryClaim(std::atomic<uint64>& LastReport, uint64 Now, uint64 Interval);
+
+    std::atomic<uint64> Counters[static_cast<int32>(EMathToolkitCounter::Count)] = {};
+    FMathToolkitLatencyHistogram Histograms[static_cast<int32>(EMathToolkitTimer::Count)];
+    std::atomic<uint64> ReportIntervalNanoseconds;
+    std::atomic<uint64> LastReport;
+    std::atomic<uint64> WindowStart;
+    std::atomic<uint64> LastFitReport;
+    std::atomic<uint64> FitsSinceReport{0};
+};
+
+/** Times its scope into FMathToolkitStats; used through MATHTOOLKIT_SCOPE. */
+class FMathToolkitScopeTimer
+{
+public:
+    explicit FMathToolkitScopeTimer(EMathToolkitTimer InTimer)
+        : Timer(InTimer)
+        , StartCycles(FPlatformTime::Cycles64())
+    {
+    }
+
+    ~FMathToolkitScopeTimer()
+    {
+        const double Seconds = (FPlatformTime::Cycles64() - StartCycles) * FPlatformTime::GetSecondsPerCycle64();
+        FMathToolkitStats& Stats = FMathToolkitStats::Get();
+        Stats.AddLatency(Timer, static_cast<uint64>(Seconds * 1e9));
+        Stats.MaybeReport();
+    }
+
+private:
+    EMathToolkitTimer Timer;
+    uint64 StartCycles;
+};
+
+#if MATHTOOLKIT_ENABLE_INSTRUMENTATION
+
+DECLARE_STATS_GROUP(TEXT("MathToolkit"), STATGROUP_MathToolkit, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Fit"), STAT_MathToolkit_Fit, STATGROUP_MathToolkit, MATHTOOLKIT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Depth conversion"), STAT_MathToolkit_DepthConversion, STATGROUP_MathToolkit, MATHTOOLKIT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Frame conversion"), STAT_MathToolkit_FrameConversion, STATGROUP_MathToolkit, MATHTOOLKIT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Projection"), STAT_MathToolkit_Projection, STATGROUP_MathToolkit, MATHTOOLKIT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Lidar resample"), STAT_MathToolkit_LidarResample, STATGROUP_MathToolkit, MATHTOOLKIT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Serialize"), STAT_MathToolkit_Serialize, STATGROUP_MathToolkit, MATHTOOLKIT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Filter"), STAT_MathToolkit_Filter, STATGROUP_MathToolkit, MATHTOOLKIT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Deskew"), STAT_MathToolkit_Deskew, STATGROUP_MathToolkit, MATHTOOLKIT_API);
+
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Fits computed"), STAT_MathToolkit_FitsComputed, STATGROUP_MathToolkit, MATHTOOLKIT_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Points converted"), STAT_MathToolkit_PointsConverted, STATGROUP_MathToolkit, MATHTOOLKIT_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Points projected"), STAT_MathToolkit_PointsProjected, STATGROUP_MathToolkit, MATHTOOLKIT_API);
+
+/** Insights CPU event, stat cycle counter and latency histogram sample for the enclosing scope. */
+#define MATHTOOLKIT_SCOPE(Timer) \
+    TRACE_CPUPROFILER_EVENT_SCOPE(MathToolkit_##Timer); \
+    SCOPE_CYCLE_COUNTER(STAT_MathToolkit_##Timer); \
+    FMathToolkitScopeTimer PREPROCESSOR_JOIN(MathToolkitScopeTimer, __LINE__)(EMathToolkitTimer::Timer)
+
+/** Adds Amount to a per-frame stat counter and to the current report window. */
+#define MATHTOOLKIT_COUNT(Counter, Amount) \
+    do \
+    { \
+        INC_DWORD_STAT_BY(STAT_MathToolkit_##Counter, Amount); \
+        FMathToolkitStats::Get().AddCount(EMathToolkitCounter::Counter, static_cast<uint64>(Amount)); \
+    } while (0)
+
+#else
+
+#define MATHTOOLKIT_SCOPE(Timer)
+#define MATHTOOLKIT_COUNT(Counter, Amount) do { } while (0)
+
+#endif
@@ -0,0 +1,140 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/ParallelFor.h"
+
+#include <vector>
+
+/** Window storage of many tracks as the fit kernel reads it: sample s of track t is at [s * Stride + t]. */
+struct FMultiTrackWindows
+{
+    const double* X;
+    const double* Y;
+    const double* Z;
+    const uint32* Timestamps;
+    /** Per track: samples in the window, and the newest timestamp. */
+    const uint32* Counts;
+    const uint32* Newest;
+    int32 Stride;
+    int32 NumSlots;
+};
+
+/**
+ * Linear fits of tracks [Begin, End) into OutA / OutB (indexed by track), with the sums of each
+ * block of tracks accumulated in explicit double-precision SIMD lanes.
+ */
+MATHTOOLKIT_API void FitMultiTrackWindows(const FMultiTrackWindows& Windows, int32 Begin, int32 End, FVector* OutA, FVector* OutB);
+
+/**
+ * Sliding windows of S (value, timestamp) samples for many tracks at once, stored structure-of-arrays
+ * with the track index innermost: slot s of track t lives at [s * capacity + t]. fit_all reads each
+ * slot row of a block of tracks contiguously and accumulates the regression sums of neighbouring
+ * tracks side by side in vector lanes, and can split the blocks across worker threads.
+ *
+ * Fits follow calculateLinearFit: value = a * timestamp + b, zero vectors for tracks with fewer than
+ * two samples or a degenerate window. Timestamps are taken relative to each track's newest sample
+ * (wrap-safe uint32 difference), so the sums only see the window span.
+ */
+template<size_t S>
+class MultiTrackLinearFitMT {
+public:
+    static_assert(S >= 2, "A linear fit needs a window of at least two samples");
+
+    // Tracks handled per accumulation block; sized so the block's sums stay in L1
+    static constexpr int32 TracksPerBlock = 128;
+
+    explicit MultiTrackLinearFitMT(int32 InitialCapacity = 64) {
+        reserve(InitialCapacity);
+    }
+
+    int32 add_track() {
+        if (num_tracks_ == capacity_) {
+            reserve(FMath::Max(capacity_ * 2, 64));
+        }
+        const int32 track = num_tracks_++;
+        reset_track(track);
+        return track;
+    }
+
+    void reset_track(int32 track) {
+        check(track >= 0 && track < num_tracks_);
+        count_[track] = 0;
+        next_slot_[track] = 0;
+        newest_[track] = 0;
+        for (size_t slot = 0; slot < S; ++slot) {
+            const size_t i = slot * capacity_ + track;
+            x_[i] = y_[i] = z_[i] = 0.0;
+            t_[i] = 0;
+        }
+    }
+
+    int32 num_tracks() const { return num_tracks_; }
+    size_t size(int32 track) const { return count_[track]; }
+
+    void put(int32 track, const FVector& value, uint32 timestamp) {
+        check(track >= 0 && track < num_tracks_);
+        const size_t i = next_slot_[track] * capacity_ + track;
+        x_[i] = value.X;
+        y_[i] = value.Y;
+        z_[i] = value.Z;
+        t_[i] = timestamp;
+        newest_[track] = timestamp;
+        next_slot_[track] = next_slot_[track] + 1 == S ? 0 : next_slot_[track] + 1;
+        count_[track] = count_[track] < S ? count_[track] + 1 : static_cast<uint32>(S);
+    }
+
+    // One sample for every track, all stamped with the same timestamp
+    void put_all(TConstArrayView<FVector> values, uint32 timestamp) {
+        check(values.Num() == num_tracks_);
+        for (int32 track = 0; track < num_tracks_; ++track) {
+            put(track, values[track], timestamp);
+        }
+    }
+
+    void fit_all(TArrayView<FVector> vector_fit_a, TArrayView<FVector> vector_fit_b, bool bParallel = false) const {
+        check(vector_fit_a.Num() == num_tracks_ && vector_fit_b.Num() == num_tracks_);
+        const FMultiTrackWindows windows = {
+            x_.data(), y_.data(), z_.data(), t_.data(), count_.data(), newest_.data(), capacity_, static_cast<int32>(S) };
+        const int32 num_blocks = FMath::DivideAndRoundUp(num_tracks_, TracksPerBlock);
+        ParallelFor(num_blocks, [&](int32 block) {
+            const int32 begin = block * TracksPerBlock;
+            FitMultiTrackWindows(windows, begin, FMath::Min(begin + TracksPerBlock, num_tracks_), vector_fit_a.GetData(), vector_fit_b.GetData());
+        }, bParallel ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread);
+    }
+
+private:
+    void reserve(int32 capacity) {
+        if (capacity <= capacity_) {
+            return;
+        }
+        // The track index is innermost, so growing the capacity re-lays out every slot row
+        std::vector<double> x(S * capacity, 0.0), y(S * capacity, 0.0), z(S * capacity, 0.0);
+        std::vector<uint32> t(S * capacity, 0);
+        for (size_t slot = 0; slot < S; ++slot) {
+            for (int32 track = 0; track < num_tracks_; ++track) {
+                x[slot * capacity + track] = x_[slot * capacity_ + track];
+                y[slot * capacity + track] = y_[slot * capacity_ + track];
+                z[slot * capacity + track] = z_[slot * capacity_ + track];
+                t[slot * capacity + track] = t_[slot * capacity_ + track];
+            }
+        }
+        x_.swap(x);
+        y_.swap(y);
+        z_.swap(z);
+        t_.swap(t);
+        count_.resize(capacity, 0);
+        next_slot_.resize(capacity, 0);
+        newest_.resize(capacity, 0);
+        capacity_ = capacity;
+    }
+
+    int32 num_tracks_ = 0;
+    int32 capacity_ = 0;
+    std::vector<double> x_;
+    std::vector<double> y_;
+    std::vector<double> z_;
+    std::vector<uint32> t_;
+    std::vector<uint32> count_;
+    std::vector<uint32> next_slot_;
+    std::vector<uint32> newest_;
+};
@@ -0,0 +1,143 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "DepthRayLUT.h"
+
+#include <mutex>
+#include <utility>
+
+/** One sensor_msgs/PointField entry. */
+struct FPointCloud2Field
+{
+    /** PointField::FLOAT32 */
+    static constexpr uint8 Float32 = 7;
+
+    const TCHAR* Name;
+    uint32 Offset;
+    uint8 Datatype;
+    uint32 Count;
+};
+
+/**
+ * Byte layout of one PointCloud2 point: float32 x, y, z (ROS frame, m) followed by whichever of
+ * range (m), azimuth and elevation (rad, ROS frame) and intensity are enabled, tightly packed and
+ * little endian.
+ */
+struct MATHTOOLKIT_API FPointCloud2Layout
+{
+    bool bRange = false;
+    bool bAzimuth = false;
+    bool bElevation = false;
+    bool bIntensity = false;
+
+    FPointCloud2Layout() = default;
+    FPointCloud2Layout(bool bInRange, bool bInAzimuth, bool bInElevation, bool bInIntensity)
+        : bRange(bInRange), bAzimuth(bInAzimuth), bElevation(bInElevation), bIntensity(bInIntensity)
+    {
+    }
+
+    bool HasSpherical() const { return bRange || bAzimuth || bElevation; }
+
+    uint32 GetPointStep() const { return static_cast<uint32>(GetNumFloats() * sizeof(float)); }
+    int32 GetNumFloats() const { return 3 + bRange + bAzimuth + bElevation + bIntensity; }
+
+    /** Fields in wire order, for the PointCloud2 header. */
+    TArray<FPointCloud2Field> GetFields() const;
+};
+
+/**
+ * One serialized cloud. Unorganized clouds have Height 1 and Width == NumPoints; organized depth
+ * frames keep the image size and mark missing returns with NaN coordinates (bIsDense false).
+ * Data keeps its allocation between clouds; only the first NumPoints * PointStep bytes are valid.
+ */
+struct FPointCloud2Buffer
+{
+    uint64 Sequence = 0;
+    uint32 Width = 0;
+    uint32 Height = 0;
+    uint32 PointStep = 0;
+    int32 NumPoints = 0;
+    bool bIsDense = true;
+    TArray<uint8> Data;
+
+    uint32 GetRowStep() const { return Width * PointStep; }
+    TConstArrayView<uint8> GetBytes() const { return TConstArrayView<uint8>(Data.GetData(), NumPoints * static_cast<int32>(PointStep)); }
+};
+
+/**
+ * Streams points straight into PointCloud2 bytes: each point is flipped into the ROS frame and
+ * written as it is produced, with no intermediate FVector array and no separate conversion pass.
+ *
+ * Two preallocated buffers are handed between one producer and one publisher. The producer fills
+ * one with BeginCloud / Add* / Commit while the publisher holds the other between Acquire and
+ * Release; neither side allocates or waits on the other. If a committed cloud has not been
+ * acquired by the time the producer begins the next one, it is overwritten and counted as dropped.
+ */
+class MATHTOOLKIT_API FPointCloud2Writer
+{
+public:
+    /** Both buffers are sized for MaxPoints up front; larger clouds still work but grow the buffer. */
+    FPointCloud2Writer(const FPointCloud2Layout& InLayout, int32 MaxPoints);
+
+    FPointCloud2Writer(const FPointCloud2Writer&) = delete;
+    FPointCloud2Writer& operator=(const FPointCloud2Writer&) = delete;
+
+    const FPointCloud2Layout& GetLayout() const { return Layout; }
+    const TArray<FPointCloud2Field>& GetFields() const { return Fields; }
+
+    // Producer side
+
+    /** Starts an unorganized cloud in the free buffer. */
+    void BeginCloud();
+
+    /** UE point (cm); the spherical fields, when enabled, are derived from it. */
+    void AddPoint(const FVector& UEPoint, float Intensity = 0.0f);
+    /**
+     * UE point (cm) with its (range cm, azimuth rad, elevation rad) in the UE frame, i.e. the pair
+     * returned by MathToolkitLibrary::CalculateSphericalFromDepth, so nothing is recomputed.
+     */
+    void AddPoint(const FVector& UEPoint, const FVector& Spherical, float Intensity = 0.0f);
+    /** The (spherical, point) pair as CalculateSphericalFromDepth returns it. */
+    void AddPoint(const std::pair<FVector, FVector>& SphericalAndPoint, float Intensity = 0.0f)
+    {
+        AddPoint(SphericalAndPoint.second, SphericalAndPoint.first, Intensity);
+    }
+
+    /**
+     * Whole depth frame (width * height, cm) through the camera's ray LUT. Organized output keeps
+     * every pixel and writes NaN for depth <= 0; otherwise those pixels are skipped. Intensity is
+     * either empty (written as 0) or one value per pixel. Replaces the cloud begun by BeginCloud.
+     */
+    void AddDepthFrame(const FDepthRayLUT& LUT, TConstArrayView<float> Depth, TConstArrayView<float> Intensity = TConstArrayView<float>(), bool bOrganized = true);
+
+    int32 GetNumPoints() const;
+
+    /** Publishes the cloud being written; it replaces any committed cloud not yet acquired. */
+    void Commit();
+
+    // Publisher side
+
+    /** Takes the latest committed cloud, or nullptr when there is none. Valid until Release. */
+    const FPointCloud2Buffer* Acquire();
+    void Release();
+
+    /** Committed clouds overwritten before the publisher acquired them. */
+    uint64 GetNumDropped() const;
+
+private:
+    uint8* Reserve(FPointCloud2Buffer& Buffer, int32 NumPoints);
+    void WritePoint(uint8* Dst, const FVector& ROSPoint, float Range, float Azimuth, float Elevation, float Intensity) const;
+
+    FPointCloud2Layout Layout;
+    TArray<FPointCloud2Field> Fields;
+    uint32 PointStep;
+
+    FPointCloud2Buffer Buffers[2];
+    // Index of the buffer in each role, -1 when no buffer has it
+    int32 WriteIndex = -1;
+    int32 ReadyIndex = -1;
+    int32 HeldIndex = -1;
+    uint64 Sequence = 0;
+    uint64 NumDropped = 0;
+    mutable std::mutex Mutex;
+};
@@ -0,0 +1,99 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include <shared_mutex>
+
+/** How GetPose produced a pose. */
+enum class EPoseQueryResult : uint8
+{
+    /** Between two stored poses: lerp for the position, slerp for the rotation. */
+    Interpolated,
+    /** After the newest pose, within the extrapolation horizon: cached linear fit and angular rate. */
+    Extrapolated,
+    /** Before the oldest pose, past the horizon, or no poses: clamped to the nearest pose it could produce. */
+    OutOfRange,
+};
+
+/**
+ * Timestamped pose history per frame ID, so sensors can look up where a frame was at their capture
+ * time. Each frame keeps its last Capacity poses in contiguous arrays; lookups are a binary search
+ * plus an interpolation, and batched queries with non-decreasing timestamps (e.g. one per lidar
+ * column) reuse the previous segment so they skip the search altogether, and the queries that land
+ * in one segment share its slerp setup. Non-finite query times are reported as OutOfRange.
+ *
+ * Extrapolation past the newest pose uses coefficients cached when the pose is added: the velocity
+ * of the linear fit over the last FitWindow positions (FFitMoments, as calculateLinearFit) and the
+ * angular velocity between the last two rotations, both applied from the newest pose, so a query
+ * never refits.
+ *
+ * Timestamps are doubles in any unit as long as it is consistent. Poses may be added from one thread
+ * while others query; queries take a shared lock once per call, not per timestamp.
+ */
+class MATHTOOLKIT_API FPoseHistory
+{
+public:
+    struct FSettings
+    {
+        /** Poses kept per frame. */
+        int32 Capacity = 256;
+        /** Newest positions fed to the extrapolation fit. */
+        int32 FitWindow = 8;
+        /** How far past the newest pose extrapolation is trusted; later queries are clamped to it. */
+        double MaxExtrapolation = 0.1;
+    };
+
+    explicit FPoseHistory(const FSettings& InSettings);
+
+    const FSettings& GetSettings() const { return Settings; }
+
+    /** Handle of the frame with this ID, creating it on first use. Handles stay valid for the history's lifetime. */
+    int32 RegisterFrame(uint32 FrameId);
+    /** Handle of an already registered frame, or INDEX_NONE. */
+    int32 FindFrame(uint32 FrameId) const;
+
+    /**
+     * Appends a pose; the oldest one is dropped once Capacity are stored. Timestamps must increase,
+     * out-of-order poses are rejected and false is returned.
+     */
+    bool AddPose(int32 Frame, double Timestamp, const FVector& Position, const FQuat& Rotation);
+
+    EPoseQueryResult GetPose(int32 Frame, double Timestamp, FVector& OutPosition, FQuat& OutRotation) const;
+
+    /**
+     * GetPose for every timestamp. OutResults may be empty; otherwise it receives each query's result.
+     * Returns the number of queries that were not OutOfRange.
+     */
+    int32 GetPoses(int32 Frame, TConstArrayView<double> Timestamps, TArrayView<FVector> OutPositions, TArrayView<FQuat> OutRotations,
+        TArrayView<EPoseQueryResult> OutResults = TArrayView<EPoseQueryResult>()) const;
+
+    int32 GetNumPoses(int32 Frame) const;
+    /** Oldest and newest stored timestamps; false when the frame has no poses. */
+    bool GetTimeRange(int32 Frame, double& OutOldest, double& OutNewest) const;
+
+private:
+    struct FTrack
+    {
+        uint32 FrameId = 0;
+        // Poses live in [Begin, Begin + Num) of arrays twice the capacity and are moved back to the
+        // front when they reach the end, so the window is always contiguous for the binary search
+        TArray<double> Timestamps;
+        TArray<FVector> Positions;
+        TArray<FQuat> Rotations;
+        int32 Begin = 0;
+        int32 Num = 0;
+
+        // Extrapolation from the newest pose: slope of the position fit and last angular velocity
+        FVector Velocity = FVector::ZeroVector;
+        FVector AngularAxis = FVector(0.0, 0.0, 1.0);
+        double AngularRate = 0.0;
+    };
+
+    /** Query with the segment cursor of a batch; Segment is the offset from Begin of the last pose at or before the previous timestamp. */
+    EPoseQueryResult Sample(const FTrack& Track, double Timestamp, int32& Segment, FVector& OutPosition, FQuat& OutRotation) const;
+    void UpdateExtrapolation(FTrack& Track) const;
+
+    FSettings Settings;
+    TArray<FTrack> Tracks;
+    mutable std::shared_mutex Mutex;
+};
@@ -0,0 +1,234 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/** Default RingBufferMT storage: one aligned heap block per buffer. */
+struct FRingBufferHeapAllocator
+{
+    void* Allocate(size_t Bytes, size_t Alignment) { return FMemory::Malloc(Bytes, static_cast<uint32>(Alignment)); }
+    void Free(void* Ptr, size_t /*Bytes*/) { FMemory::Free(Ptr); }
+};
+
+/**
+ * Bump allocator over one contiguous slab, so the buffers of hundreds of actors sit next to each
+ * other instead of being scattered over the heap. Freeing is a no-op apart from bookkeeping; the
+ * whole slab is recycled with Reset() once every buffer carved from it has been destroyed.
+ */
+class MATHTOOLKIT_API FRingBufferArena
+{
+public:
+    explicit FRingBufferArena(size_t SlabBytes);
+    ~FRingBufferArena();
+
+    FRingBufferArena(const FRingBufferArena&) = delete;
+    FRingBufferArena& operator=(const FRingBufferArena&) = delete;
+
+    /** Aligned block from the slab; the slab must have room for it. */
+    void* Allocate(size_t Bytes, size_t Alignment);
+    void Free(void* Ptr, size_t Bytes);
+
+    /** Makes the whole slab available again; no allocation may still be live. */
+    void Reset();
+
+    size_t GetUsedBytes() const { return Used; }
+    size_t GetCapacityBytes() const { return Capacity; }
+    int32 GetLiveAllocations() const { return LiveAllocations; }
+
+private:
+    uint8* Slab;
+    size_t Capacity;
+    size_t Used;
+    int32 LiveAllocations;
+};
+
+/** RingBufferMT allocator handle that carves storage out of a shared FRingBufferArena. */
+struct FRingBufferArenaAllocator
+{
+    FRingBufferArenaAllocator(FRingBufferArena& InArena) : Arena(&InArena) {}
+
+    void* Allocate(size_t Bytes, size_t Alignment) { return Arena->Allocate(Bytes, Alignment); }
+    void Free(void* Ptr, size_t Bytes) { Arena->Free(Ptr, Bytes); }
+
+    FRingBufferArena* Arena;
+};
+
+/**
+ * CircularBufferMT with the capacity chosen at run time and the storage taken from an allocator, so
+ * the owning object only holds a pointer and window lengths can be tuned without a rebuild.
+ * Same element semantics and read API (for_each, contiguous_segments, size, full, ...) as
+ * CircularBufferMT, so the MathToolkitLibrary fits accept either buffer.
+ */
+template<typename T, typename AllocatorType = FRingBufferHeapAllocator>
+class RingBufferMT {
+public:
+    using value_type = T;
+
+    explicit RingBufferMT(size_t capacity, AllocatorType allocator = AllocatorType())
+        : allocator_(allocator), capacity_(capacity), head_(0), size_(0) {
+        check(capacity > 0);
+        storage_ = static_cast<T*>(allocator_.Allocate(sizeof(T) * capacity_, alignof(T)));
+    }
+
+    // The moved-from buffer stays usable: it is left empty with the same capacity and takes a new
+    // block from its allocator on the next write, so moving never allocates.
+    RingBufferMT(RingBufferMT&& other)
+        : allocator_(other.allocator_), storage_(other.storage_), capacity_(other.capacity_), head_(other.head_), size_(other.size_) {
+        other.storage_ = nullptr;
+        other.head_ = other.size_ = 0;
+    }
+
+    RingBufferMT& operator=(RingBufferMT&& other) {
+        if (this != &other) {
+            release();
+            allocator_ = other.allocator_;
+            storage_ = other.storage_;
+            capacity_ = other.capacity_;
+            head_ = other.head_;
+            size_ = other.size_;
+            other.storage_ = nullptr;
+            other.head_ = other.size_ = 0;
+        }
+        return *this;
+    }
+
+    RingBufferMT(const RingBufferMT&) = delete;
+    RingBufferMT& operator=(const RingBufferMT&) = delete;
+
+    ~RingBufferMT() {
+        release();
+    }
+
+    void put(const T& item) {
+        emplace(item);
+    }
+
+    void put(T&& item) {
+        emplace(std::move(item));
+    }
+
+    // Constructs the new element in place. When the buffer is full the new element is built before
+    // the oldest one is destroyed, since the arguments may refer to it (put(front())).
+    template<typename... Args>
+    T& emplace(Args&&... args) {
+        allocate_if_moved_from();
+        T* dest = storage_ + wrap(head_ + size_);
+        if (full()) {
+            T item(std::forward<Args>(args)...);
+            dest->~T();
+            head_ = wrap(head_ + 1);
+            ::new (static_cast<void*>(dest)) T(std::move(item));
+        } else {
+            ::new (static_cast<void*>(dest)) T(std::forward<Args>(args)...);
+            ++size_;
+        }
+        return *dest;
+    }
+
+    // Appends items in order; when more than capacity() are given only the newest survive
+    void put_n(TConstArrayView<T> items) {
+        size_t count = static_cast<size_t>(items.Num());
+        const T* src = items.GetData();
+        allocate_if_moved_from();
+        if (count >= capacity_) {
+            clear();
+            src += count - capacity_;
+            count = capacity_;
+        }
+
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            const size_t start = wrap(head_ + size_);
+            const size_t first = std::min(count, capacity_ - start);
+            std::memcpy(static_cast<void*>(storage_ + start), src, first * sizeof(T));
+            std::memcpy(static_cast<void*>(storage_), src + first, (count - first) * sizeof(T));
+
+            const size_t overflow = size_ + count > capacity_ ? size_ + count - capacity_ : 0;
+            head_ = wrap(head_ + overflow);
+            size_ += count - overflow;
+        } else {
+            for (size_t i = 0; i < count; ++i) {
+                emplace(src[i]);
+            }
+        }
+    }
+
+    // Removes the oldest element; the buffer must not be empty
+    void pop_front() {
+        check(!empty());
+        storage_[head_].~T();
+        head_ = wrap(head_ + 1);
+        --size_;
+    }
+
+    void clear() {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            while (!empty()) {
+                pop_front();
+            }
+        }
+        head_ = size_ = 0;
+    }
+
+    // Oldest and newest element; the buffer must not be empty
+    const T& front() const { return storage_[head_]; }
+    const T& back() const { return storage_[wrap(head_ + size_ - 1)]; }
+
+    // Physical slot indices of the oldest element and of the next write
+    size_t get_head() const { return head_; }
+    size_t get_tail() const { return wrap(head_ + size_); }
+
+    bool empty() const { return size_ == 0; }
+    bool full() const { return size_ == capacity_; }
+    size_t size() const { return size_; }
+    size_t capacity() const { return capacity_; }
+
+    // The live elements oldest to newest as at most two linear spans
+    std::pair<TConstArrayView<T>, TConstArrayView<T>> contiguous_segments() const {
+        const size_t first = std::min(size_, capacity_ - head_);
+        return std::make_pair(
+            TConstArrayView<T>(storage_ + head_, static_cast<int32>(first)),
+            TConstArrayView<T>(storage_, static_cast<int32>(size_ - first)));
+    }
+
+    template<typename Func>
+    void for_each(Func f) const {
+        const std::pair<TConstArrayView<T>, TConstArrayView<T>> segments = contiguous_segments();
+        for (const T& item : segments.first) {
+            f(item);
+        }
+        for (const T& item : segments.second) {
+            f(item);
+        }
+    }
+
+private:
+    void allocate_if_moved_from() {
+        if (!storage_) {
+            storage_ = static_cast<T*>(allocator_.Allocate(sizeof(T) * capacity_, alignof(T)));
+        }
+    }
+
+    void release() {
+        if (storage_) {
+            clear();
+            allocator_.Free(storage_, sizeof(T) * capacity_);
+            storage_ = nullptr;
+        }
+    }
+
+    // Indices never exceed 2 * capacity_, so a compare replaces the modulo
+    size_t wrap(size_t index) const {
+        return index >= capacity_ ? index - capacity_ : index;
+    }
+
+    AllocatorType allocator_;
+    T* storage_;
+    size_t capacity_;
+    size_t head_;
+    size_t size_;
+};
@@ -0,0 +1,151 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CircularBufferMT.h"
+
+/**
+ * Sliding-window linear fit y = a * t + b that pairs a CircularBufferMT with running moments.
+ * Each put adds the new sample and removes the evicted one, so get_fit is O(1) for any window size
+ * and returns what MathToolkitLibrary::calculateLinearFit would for the same buffer.
+ *
+ * The moments are kept centered (Welford form) around a timestamp origin that follows the window,
+ * so large uint32 timestamps do not cancel the way n * sum_xx - sum_x^2 does. Every
+ * ResumInterval puts they are recomputed from the buffer to stop rounding drift from accumulating.
+ */
+template<size_t S>
+class StreamingLinearFitMT {
+public:
+    typedef TPair<FVector, uint32> SampleType;
+
+    explicit StreamingLinearFitMT(size_t ResumInterval = 4 * S)
+        : resum_interval_(ResumInterval > 0 ? ResumInterval : 1) {
+        reset_moments();
+    }
+
+    void put(const FVector& value, uint32 timestamp) {
+        put(SampleType(value, timestamp));
+    }
+
+    void put(const SampleType& sample) {
+        if (buffer_.empty()) {
+            origin_ = sample.Value;
+        }
+        if (buffer_.full()) {
+            remove(buffer_.front());
+        }
+        buffer_.put(sample);
+        add(sample);
+
+        if (++puts_since_resum_ >= resum_interval_) {
+            resum();
+        }
+    }
+
+    // Same outputs as calculateLinearFit: zero vectors with fewer than two samples or a degenerate window
+    void get_fit(FVector& vector_fit_a, FVector& vector_fit_b) const {
+        if (n_ < 2 || FMath::IsNearlyZero(n_ * m2_x_)) {
+            vector_fit_a = FVector::ZeroVector;
+            vector_fit_b = FVector::ZeroVector;
+            return;
+        }
+
+        const double inv_m2 = 1.0 / m2_x_;
+        const double mean_t = mean_x_ + origin_;
+        for (int32 axis = 0; axis < 3; ++axis) {
+            vector_fit_a[axis] = c_xy_[axis] * inv_m2;
+            vector_fit_b[axis] = mean_y_[axis] - vector_fit_a[axis] * mean_t;
+        }
+    }
+
+    // Recomputes the moments from the buffer with a two-pass centered sum and re-anchors the origin
+    void resum() {
+        reset_moments();
+        puts_since_resum_ = 0;
+        if (buffer_.empty()) {
+            return;
+        }
+
+        origin_ = buffer_.back().Value;
+        buffer_.for_each([this](const SampleType& sample) {
+            ++n_;
+            mean_x_ += relative(sample.Value);
+            for (int32 axis = 0; axis < 3; ++axis) {
+                mean_y_[axis] += sample.Key[axis];
+            }
+        });
+        mean_x_ /= n_;
+        for (int32 axis = 0; axis < 3; ++axis) {
+            mean_y_[axis] /= n_;
+        }
+
+        buffer_.for_each([this](const SampleType& sample) {
+            const double dx = relative(sample.Value) - mean_x_;
+            m2_x_ += dx * dx;
+            for (int32 axis = 0; axis < 3; ++axis) {
+                c_xy_[axis] += dx * (sample.Key[axis] - mean_y_[axis]);
+            }
+        });
+    }
+
+    const CircularBufferMT<SampleType, S>& get_buffer() const { return buffer_; }
+
+    size_t size() const { return buffer_.size(); }
+    bool empty() const { return buffer_.empty(); }
+    bool full() const { return buffer_.full(); }
+
+private:
+    double relative(uint32 timestamp) const {
+        return static_cast<double>(timestamp) - static_cast<double>(origin_);
+    }
+
+    void reset_moments() {
+        n_ = 0;
+        mean_x_ = 0.0;
+        m2_x_ = 0.0;
+        for (int32 axis = 0; axis < 3; ++axis) {
+            mean_y_[axis] = 0.0;
+            c_xy_[axis] = 0.0;
+        }
+    }
+
+    void add(const SampleType& sample) {
+        ++n_;
+        const double dx = relative(sample.Value) - mean_x_;
+        mean_x_ += dx / n_;
+        const double dx_new = relative(sample.Value) - mean_x_;
+        m2_x_ += dx * dx_new;
+        for (int32 axis = 0; axis < 3; ++axis) {
+            mean_y_[axis] += (sample.Key[axis] - mean_y_[axis]) / n_;
+            c_xy_[axis] += dx * (sample.Key[axis] - mean_y_[axis]);
+        }
+    }
+
+    void remove(const SampleType& sample) {
+        if (n_ <= 1) {
+            reset_moments();
+            return;
+        }
+        // Inverse of add: moments of the window without the sample, then take its contribution out
+        const double x = relative(sample.Value);
+        const double mean_x_without = (n_ * mean_x_ - x) / (n_ - 1);
+        m2_x_ -= (x - mean_x_without) * (x - mean_x_);
+        for (int32 axis = 0; axis < 3; ++axis) {
+            const double y = sample.Key[axis];
+            const double mean_y_without = (n_ * mean_y_[axis] - y) / (n_ - 1);
+            c_xy_[axis] -= (x - mean_x_without) * (y - mean_y_[axis]);
+            mean_y_[axis] = mean_y_without;
+        }
+        mean_x_ = mean_x_without;
+        --n_;
+    }
+
+    CircularBufferMT<SampleType, S> buffer_;
+    uint32 origin_ = 0;
+    size_t n_;
+    double mean_x_;
+    double mean_y_[3];
+    double m2_x_;
+    double c_xy_[3];
+    size_t puts_since_resum_ = 0;
+    size_t resum_interval_;
+};
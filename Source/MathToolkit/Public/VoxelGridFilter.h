@@ -0,0 +1,134 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "DepthRayLUT.h"
+
+class FPointCloud2Writer;
+
+/**
+ * Voxel-grid downsampling stage run right after depth conversion, so clouds leave the simulator at
+ * the density the navigation stack actually uses. Points are cropped by range and direction,
+ * invalid ones (depth <= 0, NaN, infinite) are rejected, and the rest are averaged into one
+ * centroid per occupied voxel. Voxels holding fewer than MinPointsPerVoxel points are treated as
+ * isolated returns and dropped.
+ *
+ * The voxel hash table is sized once from MaxVoxels and reused across frames: BeginFrame
+ * invalidates it by bumping a generation stamp instead of clearing it, so steady-state operation
+ * does not allocate. Points falling into new voxels once MaxVoxels are occupied are counted and
+ * discarded.
+ */
+class MATHTOOLKIT_API FVoxelGridFilter
+{
+public:
+    struct FSettings
+    {
+        /** Voxel edge length, cm. */
+        float VoxelSize = 10.0f;
+        /**
+         * Range crop in cm; MaxRange 0 disables the upper bound. Points 2^20 voxels or more from the
+         * origin along any axis are always cropped.
+         */
+        float MinRange = 0.0f;
+        float MaxRange = 0.0f;
+        /** Direction crop in radians, same convention as CalculateSphericalFromDepth. */
+        float MinAzimuth = -UE_PI;
+        float MaxAzimuth = UE_PI;
+        float MinElevation = -UE_PI / 2;
+        float MaxElevation = UE_PI / 2;
+        /** Voxels with fewer points are dropped as outliers. */
+        int32 MinPointsPerVoxel = 1;
+        /** Occupied voxels per frame the table is sized for. */
+        int32 MaxVoxels = 65536;
+    };
+
+    /** Per-frame counters, reset by BeginFrame. */
+    struct FFrameStats
+    {
+        int32 NumInput = 0;
+        int32 NumInvalid = 0;
+        int32 NumCropped = 0;
+        /** Points lost because MaxVoxels voxels were already occupied. */
+        int32 NumOverflowed = 0;
+    };
+
+    explicit FVoxelGridFilter(const FSettings& InSettings);
+
+    const FSettings& GetSettings() const { return Settings; }
+
+    /** Forgets the previous frame's voxels; O(1). */
+    void BeginFrame();
+
+    /** Adds UE points (cm) given as SoA channels of equal length. */
+    void AddPoints(TConstArrayView<float> X, TConstArrayView<float> Y, TConstArrayView<float> Z);
+    void AddPoints(TConstArrayView<FVector> Points);
+
+    /**
+     * Adds a whole depth frame (width * height, cm) through the camera's ray LUT without building the
+     * full-resolution cloud; range and direction for the crop come straight out of the table.
+     */
+    void AddDepthFrame(const FDepthRayLUT& LUT, TConstArrayView<float> Depth);
+
+    /** Occupied voxels, including those below MinPointsPerVoxel. */
+    int32 GetNumVoxels() const { return Occupied.Num(); }
+    const FFrameStats& GetFrameStats() const { return FrameStats; }
+
+    /**
+     * Writes the centroid (UE cm) of every voxel with at least MinPointsPerVoxel points, in first-hit
+     * order, and returns how many were written. Out needs room for GetNumVoxels() points.
+     */
+    int32 GetCentroids(TArrayView<FVector> Out) const;
+
+    /** Streams the centroids into the cloud currently begun on Writer. Returns the number written. */
+    int32 WriteCentroids(FPointCloud2Writer& Writer) const;
+
+    /** Heap memory held by the hash table, in bytes. */
+    SIZE_T GetAllocatedSize() const { return Slots.GetAllocatedSize() + Occupied.GetAllocatedSize(); }
+
+private:
+    struct FVoxel
+    {
+        uint64 Key;
+        uint32 Generation;
+        int32 Count;
+        /** Sums of offsets from the voxel's minimum corner, which stay small wherever the voxel is. */
+        float SumX;
+        float SumY;
+        float SumZ;
+    };
+
+    float GetCorner(int32 VoxelIndex) const { return static_cast<float>(VoxelIndex) * Settings.VoxelSize; }
+    FVector GetCentroid(const FVoxel& Voxel) const;
+
+    bool InRange(float Range) const { return Range >= Settings.MinRange && (Settings.MaxRange <= 0.0f || Range <= Settings.MaxRange); }
+    bool InDirection(float Azimuth, float Elevation) const
+    {
+        return Azimuth >= Settings.MinAzimuth && Azimuth <= Settings.MaxAzimuth
+            && Elevation >= Settings.MinElevation && Elevation <= Settings.MaxElevation;
+    }
+    /** Voxel indices must fit the 21-bit key fields; points farther out would alias or overflow int32. */
+    bool InKeyRange(float X, float Y, float Z) const
+    {
+        return FMath::Abs(X * InvVoxelSize) < VoxelKeyLimit && FMath::Abs(Y * InvVoxelSize) < VoxelKeyLimit
+            && FMath::Abs(Z * InvVoxelSize) < VoxelKeyLimit;
+    }
+
+    /** 2^20 voxels each way from the origin. */
+    static constexpr float VoxelKeyLimit = 1048576.0f;
+
+    /** Point that already passed validation and cropping. */
+    void Accumulate(float X, float Y, float Z);
+    /** Validation and crop of a point with unknown range and direction, then Accumulate. */
+    void AddPoint(float X, float Y, float Z);
+
+    FSettings Settings;
+    float InvVoxelSize;
+    bool bCropDirection;
+    uint32 HashShift;
+    /** Slots stamped with another generation are free; starts past the zeroed slots. */
+    uint32 Generation = 1;
+
+    TArray<FVoxel> Slots;
+    /** Slot indices of this frame's voxels, in first-hit order. */
+    TArray<int32> Occupied;
+    FFrameStats FrameStats;
+};
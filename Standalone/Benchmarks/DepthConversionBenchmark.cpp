@@ -0,0 +1,319 @@
+// Depth frame to point cloud and point cloud to pixel throughput across image resolutions.
+#include <benchmark/benchmark.h>
+
+#include "MathToolkitLibrary.h"
+#include "CameraProjection.h"
+#include "DepthFramePipeline.h"
+#include "DepthRayLUT.h"
+#include "LidarDeskew.h"
+#include "PointCloud2Writer.h"
+
+namespace
+{
+    const float FOVH = 90.0f;
+
+    void ResolutionArgs(benchmark::internal::Benchmark* Benchmark)
+    {
+        Benchmark->ArgNames({"width", "height"});
+        Benchmark->Args({320, 240});
+        Benchmark->Args({640, 480});
+        Benchmark->Args({1280, 720});
+        Benchmark->Args({1920, 1080});
+    }
+
+    struct FDepthFixture
+    {
+        uint32 Width;
+        uint32 Height;
+        TArray<float> Depth;
+        TArray<float> X, Y, Z, Range, Azimuth, Elevation;
+
+        explicit FDepthFixture(const benchmark::State& State)
+            : Width(static_cast<uint32>(State.range(0)))
+            , Height(static_cast<uint32>(State.range(1)))
+        {
+            const int32 NumPixels = static_cast<int32>(Width * Height);
+            FRandomStream Random(3);
+            Depth.SetNumUninitialized(NumPixels);
+            for (float& Value : Depth)
+            {
+                Value = Random.FRandRange(50.0f, 5000.0f);
+            }
+            for (TArray<float>* Channel : {&X, &Y, &Z, &Range, &Azimuth, &Elevation})
+            {
+                Channel->SetNumUninitialized(NumPixels);
+            }
+        }
+
+        FDepthPointCloudSoA GetOutput() { return FDepthPointCloudSoA{X, Y, Z, Range, Azimuth, Elevation}; }
+        int64 NumPixels() const { return static_cast<int64>(Width) * Height; }
+    };
+}
+
+static void BM_DepthToPoints_PerPixel(benchmark::State& State)
+{
+    FDepthFixture Fixture(State);
+    float TanH, TanV;
+    MathToolkitLibrary::CalculateTanHalfFOV(FOVH, Fixture.Width, Fixture.Height, TanH, TanV);
+    for (auto _ : State)
+    {
+        int32 Index = 0;
+        for (uint32 y = 0; y < Fixture.Height; ++y)
+        {
+            for (uint32 x = 0; x < Fixture.Width; ++x, ++Index)
+            {
+                const std::pair<FVector, FVector> Result = MathToolkitLibrary::CalculateSphericalFromDepth(
+                    Fixture.Depth[Index], static_cast<float>(x), static_cast<float>(y), TanH, TanV, Fixture.Width, Fixture.Height);
+                Fixture.X[Index] = static_cast<float>(Result.second.X);
+                Fixture.Range[Index] = static_cast<float>(Result.first.X);
+            }
+        }
+        benchmark::DoNotOptimize(Fixture.X.GetData());
+        benchmark::ClobberMemory();
+    }
+    State.SetItemsProcessed(State.iterations() * Fixture.NumPixels());
+}
+BENCHMARK(BM_DepthToPoints_PerPixel)->Apply(ResolutionArgs)->Unit(benchmark::kMillisecond);
+
+static void BM_DepthToPoints_Batched(benchmark::State& State)
+{
+    FDepthFixture Fixture(State);
+    const FDepthPointCloudSoA Out = Fixture.GetOutput();
+    for (auto _ : State)
+    {
+        MathToolkitLibrary::CalculatePointCloudFromDepth(Fixture.Depth, FOVH, Fixture.Width, Fixture.Height, Out);
+        benchmark::ClobberMemory();
+    }
+    State.SetItemsProcessed(State.iterations() * Fixture.NumPixels());
+}
+BENCHMARK(BM_DepthToPoints_Batched)->Apply(ResolutionArgs)->Unit(benchmark::kMillisecond);
+
+static void BM_DepthToPoints_RayLUT(benchmark::State& State)
+{
+    FDepthFixture Fixture(State);
+    const FDepthPointCloudSoA Out = Fixture.GetOutput();
+    const FDepthRayLUT LUT(FOVH, Fixture.Width, Fixture.Height);
+    for (auto _ : State)
+    {
+        LUT.Convert(Fixture.Depth, Out);
+        benchmark::ClobberMemory();
+    }
+    State.SetItemsProcessed(State.iterations() * Fixture.NumPixels());
+}
+BENCHMARK(BM_DepthToPoints_RayLUT)->Apply(ResolutionArgs)->Unit(benchmark::kMillisecond);
+
+// Narrow outputs: compare bytes_per_second against the float32 XYZ of BM_DepthToPoints_RayLUT
+static void BM_DepthToPoints_Half(benchmark::State& State)
+{
+    FDepthFixture Fixture(State);
+    const FDepthRayLUT LUT(FOVH, Fixture.Width, Fixture.Height);
+    TArray<uint16> Out;
+    Out.SetNumUninitialized(3 * Fixture.NumPixels());
+    for (auto _ : State)
+    {
+        LUT.ConvertHalf(Fixture.Depth, Out, 100.0f);
+        benchmark::ClobberMemory();
+    }
+    State.SetItemsProcessed(State.iterations() * Fixture.NumPixels());
+    State.SetBytesProcessed(State.iterations() * Out.Num() * sizeof(uint16));
+}
+BENCHMARK(BM_DepthToPoints_Half)->Apply(ResolutionArgs)->Unit(benchmark::kMillisecond);
+
+static void BM_DepthToPoints_Fixed16(benchmark::State& State)
+{
+    FDepthFixture Fixture(State);
+    const FDepthRayLUT LUT(FOVH, Fixture.Width, Fixture.Height);
+    TArray<int16> Out;
+    Out.SetNumUninitialized(3 * Fixture.NumPixels());
+    for (auto _ : State)
+    {
+        LUT.ConvertFixed16(Fixture.Depth, Out, 1.0f);
+        benchmark::ClobberMemory();
+    }
+    State.SetItemsProcessed(State.iterations() * Fixture.NumPixels());
+    State.SetBytesProcessed(State.iterations() * Out.Num() * sizeof(int16));
+}
+BENCHMARK(BM_DepthToPoints_Fixed16)->Apply(ResolutionArgs)->Unit(benchmark::kMillisecond);
+
+static void BM_DepthToRangeImage(benchmark::State& State)
+{
+    FDepthFixture Fixture(State);
+    const FDepthRayLUT LUT(FOVH, Fixture.Width, Fixture.Height);
+    TArray<uint16> Out;
+    Out.SetNumUninitialized(Fixture.NumPixels());
+    for (auto _ : State)
+    {
+        LUT.ConvertRangeImage(Fixture.Depth, Out, 1.0f);
+        benchmark::ClobberMemory();
+    }
+    State.SetItemsProcessed(State.iterations() * Fixture.NumPixels());
+    State.SetBytesProcessed(State.iterations() * Out.Num() * sizeof(uint16));
+}
+BENCHMARK(BM_DepthToRangeImage)->Apply(ResolutionArgs)->Unit(benchmark::kMillisecond);
+
+static void BM_DepthToPoints_Tiled(benchmark::State& State)
+{
+    FDepthFixture Fixture(State);
+    const FDepthPointCloudSoA Out = Fixture.GetOutput();
+    const FDepthRayLUT LUT(FOVH, Fixture.Width, Fixture.Height);
+    const int32 RowsPerTile = FDepthFramePipeline::GetDefaultRowsPerTile(Fixture.Width);
+    for (auto _ : State)
+    {
+        FDepthFramePipeline::ConvertTiled(LUT, Fixture.Depth, Out, RowsPerTile, true);
+        benchmark::ClobberMemory();
+    }
+    State.SetItemsProcessed(State.iterations() * Fixture.NumPixels());
+}
+BENCHMARK(BM_DepthToPoints_Tiled)->Apply(ResolutionArgs)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+static void BM_DepthToPointCloud2_ThreePass(benchmark::State& State)
+{
+    // Per-pixel unprojection into FVectors, whole-cloud frame conversion, then packing the bytes
+    FDepthFixture Fixture(State);
+    float TanH, TanV;
+    MathToolkitLibrary::CalculateTanHalfFOV(FOVH, Fixture.Width, Fixture.Height, TanH, TanV);
+    TArray<FVector> Points;
+    Points.SetNumUninitialized(static_cast<int32>(Fixture.NumPixels()));
+    TArray<float> Bytes;
+    Bytes.SetNumUninitialized(Points.Num() * 3);
+    for (auto _ : State)
+    {
+        int32 Index = 0;
+        for (uint32 y = 0; y < Fixture.Height; ++y)
+        {
+            for (uint32 x = 0; x < Fixture.Width; ++x, ++Index)
+            {
+                Points[Index] = MathToolkitLibrary::CalculateSphericalFromDepth(
+                    Fixture.Depth[Index], static_cast<float>(x), static_cast<float>(y), TanH, TanV, Fixture.Width, Fixture.Height).second;
+            }
+        }
+        MathToolkitLibrary::ConvertUEToROS(Points, Points);
+        for (int32 i = 0; i < Points.Num(); ++i)
+        {
+            Bytes[i * 3 + 0] = static_cast<float>(Points[i].X);
+            Bytes[i * 3 + 1] = static_cast<float>(Points[i].Y);
+            Bytes[i * 3 + 2] = static_cast<float>(Points[i].Z);
+        }
+        benchmark::DoNotOptimize(Bytes.GetData());
+        benchmark::ClobberMemory();
+    }
+    State.SetItemsProcessed(State.iterations() * Fixture.NumPixels());
+}
+BENCHMARK(BM_DepthToPointCloud2_ThreePass)->Apply(ResolutionArgs)->Unit(benchmark::kMillisecond);
+
+static void BM_DepthToPointCloud2_Streaming(benchmark::State& State)
+{
+    FDepthFixture Fixture(State);
+    const FDepthRayLUT LUT(FOVH, Fixture.Width, Fixture.Height);
+    FPointCloud2Writer Writer(FPointCloud2Layout(), static_cast<int32>(Fixture.NumPixels()));
+    for (auto _ : State)
+    {
+        Writer.BeginCloud();
+        Writer.AddDepthFrame(LUT, Fixture.Depth);
+        Writer.Commit();
+        benchmark::DoNotOptimize(Writer.Acquire());
+        Writer.Release();
+    }
+    State.SetItemsProcessed(State.iterations() * Fixture.NumPixels());
+}
+BENCHMARK(BM_DepthToPointCloud2_Streaming)->Apply(ResolutionArgs)->Unit(benchmark::kMillisecond);
+
+static void BM_ProjectPoints_PerCall(benchmark::State& State)
+{
+    FDepthFixture Fixture(State);
+    MathToolkitLibrary::CalculatePointCloudFromDepth(Fixture.Depth, FOVH, Fixture.Width, Fixture.Height, Fixture.GetOutput());
+    const FCameraProjection Projection(FOVH, Fixture.Width, Fixture.Height);
+    TArray<float> U, V;
+    U.SetNumUninitialized(Fixture.X.Num());
+    V.SetNumUninitialized(Fixture.X.Num());
+    for (auto _ : State)
+    {
+        for (int32 i = 0; i < Fixture.X.Num(); ++i)
+        {
+            Projection.ProjectPoint(FVector(Fixture.X[i], Fixture.Y[i], Fixture.Z[i]), U[i], V[i]);
+        }
+        benchmark::DoNotOptimize(U.GetData());
+        benchmark::ClobberMemory();
+    }
+    State.SetItemsProcessed(State.iterations() * Fixture.NumPixels());
+}
+BENCHMARK(BM_ProjectPoints_PerCall)->Apply(ResolutionArgs)->Unit(benchmark::kMillisecond);
+
+static void BM_ProjectPoints_Batched(benchmark::State& State)
+{
+    FDepthFixture Fixture(State);
+    MathToolkitLibrary::CalculatePointCloudFromDepth(Fixture.Depth, FOVH, Fixture.Width, Fixture.Height, Fixture.GetOutput());
+    const FCameraProjection Projection(FOVH, Fixture.Width, Fixture.Height);
+    TArray<float> U, V;
+    TArray<uint8> Visible;
+    U.SetNumUninitialized(Fixture.X.Num());
+    V.SetNumUninitialized(Fixture.X.Num());
+    Visible.SetNumUninitialized(Fixture.X.Num());
+    for (auto _ : State)
+    {
+        benchmark::DoNotOptimize(Projection.Project(Fixture.X, Fixture.Y, Fixture.Z, U, V, Visible));
+        benchmark::ClobberMemory();
+    }
+    State.SetItemsProcessed(State.iterations() * Fixture.NumPixels());
+}
+BENCHMARK(BM_ProjectPoints_Batched)->Apply(ResolutionArgs)->Unit(benchmark::kMillisecond);
+
+// 64 x 1800 beams at 10 Hz while driving and turning: range -> point conversion then a separate
+// de-skew pass, against the fused FLidarDeskew::ConvertRanges
+struct FDeskewFixture
+{
+    FDeskewFixture()
+        : Spec(FLidarSpec::MakeUniform(64, -25.0f, 15.0f, 0.2f))
+        , Deskew(Spec, 0.1f)
+    {
+        const int32 NumBeams = Spec.GetNumBeams();
+        FRandomStream Random(11);
+        for (int32 Beam = 0; Beam < NumBeams; ++Beam)
+        {
+            Range.Add(Random.FRandRange(100.0f, 10000.0f));
+        }
+        for (TArray<float>* Channel : {&Azimuth, &Elevation, &X, &Y, &Z})
+        {
+            Channel->SetNumUninitialized(NumBeams);
+        }
+        Spec.CalculateBeamAngles(Azimuth, Elevation);
+        Deskew.SetMotion(FVector(2000.0, 0.0, 0.0), FVector(0.0, 0.0, 0.5));
+    }
+
+    FLidarSpec Spec;
+    FLidarDeskew Deskew;
+    TArray<float> Range, Azimuth, Elevation, X, Y, Z;
+};
+
+static void BM_LidarDeskew_TwoPass(benchmark::State& State)
+{
+    FDeskewFixture Fixture;
+    for (auto _ : State)
+    {
+        for (int32 Beam = 0; Beam < Fixture.Range.Num(); ++Beam)
+        {
+            const float Planar = Fixture.Range[Beam] * FMath::Cos(Fixture.Elevation[Beam]);
+            Fixture.X[Beam] = Planar * FMath::Cos(Fixture.Azimuth[Beam]);
+            Fixture.Y[Beam] = Planar * FMath::Sin(Fixture.Azimuth[Beam]);
+            Fixture.Z[Beam] = Fixture.Range[Beam] * FMath::Sin(Fixture.Elevation[Beam]);
+        }
+        Fixture.Deskew.Apply(Fixture.X, Fixture.Y, Fixture.Z);
+        benchmark::DoNotOptimize(Fixture.X.GetData());
+        benchmark::ClobberMemory();
+    }
+    State.SetItemsProcessed(State.iterations() * Fixture.Range.Num());
+}
+BENCHMARK(BM_LidarDeskew_TwoPass)->Unit(benchmark::kMicrosecond);
+
+static void BM_LidarDeskew_Fused(benchmark::State& State)
+{
+    FDeskewFixture Fixture;
+    for (auto _ : State)
+    {
+        Fixture.Deskew.ConvertRanges(Fixture.Range, Fixture.X, Fixture.Y, Fixture.Z);
+        benchmark::DoNotOptimize(Fixture.X.GetData());
+        benchmark::ClobberMemory();
+    }
+    State.SetItemsProcessed(State.iterations() * Fixture.Range.Num());
+}
+BENCHMARK(BM_LidarDeskew_Fused)->Unit(benchmark::kMicrosecond);
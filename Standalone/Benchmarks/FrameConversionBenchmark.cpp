@@ -0,0 +1,158 @@
+// UE <-> ROS conversion throughput: per-call versus batched, double versus float, for point clouds and poses.
+#include <benchmark/benchmark.h>
+
+#include "MathToolkitLibrary.h"
+#include "FrameConversion.h"
+
+namespace
+{
+    TArray<FVector> MakeCloud(int32 NumPoints)
+    {
+        FRandomStream Random(1);
+        TArray<FVector> Cloud;
+        Cloud.Reserve(NumPoints);
+        for (int32 i = 0; i < NumPoints; ++i)
+        {
+            Cloud.Add(FVector(Random.FRandRange(-1e4f, 1e4f), Random.FRandRange(-1e4f, 1e4f), Random.FRandRange(-1e3f, 1e3f)));
+        }
+        return Cloud;
+    }
+
+    TArray<FTransform> MakeTransforms(int32 NumPoses)
+    {
+        FRandomStream Random(2);
+        TArray<FTransform> Transforms;
+        Transforms.Reserve(NumPoses);
+        for (int32 i = 0; i < NumPoses; ++i)
+        {
+            const FRotator Rotation(Random.FRandRange(-89.0f, 89.0f), Random.FRandRange(-180.0f, 180.0f), Random.FRandRange(-180.0f, 180.0f));
+            Transforms.Add(FTransform(Rotation, FVector(Random.FRandRange(-1e4f, 1e4f), Random.FRandRange(-1e4f, 1e4f), 0.0)));
+        }
+        return Transforms;
+    }
+}
+
+static void BM_UEToROS_PerCall(benchmark::State& State)
+{
+    const TArray<FVector> Cloud = MakeCloud(static_cast<int32>(State.range(0)));
+    TArray<FVector> Out;
+    Out.SetNumUninitialized(Cloud.Num());
+    for (auto _ : State)
+    {
+        for (int32 i = 0; i < Cloud.Num(); ++i)
+        {
+            Out[i] = MathToolkitLibrary::ConvertUEToROS(Cloud[i]);
+        }
+        benchmark::DoNotOptimize(Out.GetData());
+        benchmark::ClobberMemory();
+    }
+    State.SetItemsProcessed(State.iterations() * Cloud.Num());
+}
+BENCHMARK(BM_UEToROS_PerCall)->Range(1 << 10, 1 << 20);
+
+static void BM_UEToROS_Batched(benchmark::State& State)
+{
+    const TArray<FVector> Cloud = MakeCloud(static_cast<int32>(State.range(0)));
+    TArray<FVector> Out;
+    Out.SetNumUninitialized(Cloud.Num());
+    for (auto _ : State)
+    {
+        MathToolkitLibrary::ConvertUEToROS(Cloud, Out);
+        benchmark::DoNotOptimize(Out.GetData());
+        benchmark::ClobberMemory();
+    }
+    State.SetItemsProcessed(State.iterations() * Cloud.Num());
+}
+BENCHMARK(BM_UEToROS_Batched)->Range(1 << 10, 1 << 20);
+
+static void BM_UEToROS_BatchedFloat(benchmark::State& State)
+{
+    const TArray<FVector> Cloud = MakeCloud(static_cast<int32>(State.range(0)));
+    TArray<FVector3f> CloudFloat;
+    for (const FVector& Point : Cloud)
+    {
+        CloudFloat.Add(FVector3f(Point));
+    }
+    TArray<FVector3f> Out;
+    Out.SetNumUninitialized(Cloud.Num());
+    for (auto _ : State)
+    {
+        TFrameConversion<float>::UEToROS(CloudFloat, Out);
+        benchmark::DoNotOptimize(Out.GetData());
+        benchmark::ClobberMemory();
+    }
+    State.SetItemsProcessed(State.iterations() * Cloud.Num());
+}
+BENCHMARK(BM_UEToROS_BatchedFloat)->Range(1 << 10, 1 << 20);
+
+static void BM_UEToROS_Interleaved(benchmark::State& State)
+{
+    const TArray<FVector> Cloud = MakeCloud(static_cast<int32>(State.range(0)));
+    TArray<float> In;
+    for (const FVector& Point : Cloud)
+    {
+        In.Add(static_cast<float>(Point.X));
+        In.Add(static_cast<float>(Point.Y));
+        In.Add(static_cast<float>(Point.Z));
+    }
+    TArray<float> Out;
+    Out.SetNumUninitialized(In.Num());
+    for (auto _ : State)
+    {
+        MathToolkitLibrary::ConvertUEToROS(TConstArrayView<float>(In), TArrayView<float>(Out));
+        benchmark::DoNotOptimize(Out.GetData());
+        benchmark::ClobberMemory();
+    }
+    State.SetItemsProcessed(State.iterations() * Cloud.Num());
+}
+BENCHMARK(BM_UEToROS_Interleaved)->Range(1 << 10, 1 << 20);
+
+static void BM_UEToROS_Rebased(benchmark::State& State)
+{
+    const TArray<FVector> Cloud = MakeCloud(static_cast<int32>(State.range(0)));
+    const FRebasedFrame Frame(Cloud[0]);
+    TArray<float> Out;
+    Out.SetNumUninitialized(Cloud.Num() * 3);
+    for (auto _ : State)
+    {
+        Frame.ToROSLocal(Cloud, Out);
+        benchmark::DoNotOptimize(Out.GetData());
+        benchmark::ClobberMemory();
+    }
+    State.SetItemsProcessed(State.iterations() * Cloud.Num());
+}
+BENCHMARK(BM_UEToROS_Rebased)->Range(1 << 10, 1 << 20);
+
+static void BM_PoseUEToROS_PerCall(benchmark::State& State)
+{
+    const TArray<FTransform> Transforms = MakeTransforms(static_cast<int32>(State.range(0)));
+    TArray<FROSPose> Poses;
+    Poses.SetNum(Transforms.Num());
+    for (auto _ : State)
+    {
+        for (int32 i = 0; i < Transforms.Num(); ++i)
+        {
+            Poses[i].Position = MathToolkitLibrary::ConvertUEToROS(Transforms[i].GetTranslation());
+            Poses[i].Orientation = MathToolkitLibrary::ConvertUEToROSAngleDegree(Transforms[i].Rotator()).Quaternion();
+        }
+        benchmark::DoNotOptimize(Poses.GetData());
+        benchmark::ClobberMemory();
+    }
+    State.SetItemsProcessed(State.iterations() * Transforms.Num());
+}
+BENCHMARK(BM_PoseUEToROS_PerCall)->Range(1 << 8, 1 << 16);
+
+static void BM_PoseUEToROS_Batched(benchmark::State& State)
+{
+    const TArray<FTransform> Transforms = MakeTransforms(static_cast<int32>(State.range(0)));
+    TArray<FROSPose> Poses;
+    Poses.SetNum(Transforms.Num());
+    for (auto _ : State)
+    {
+        MathToolkitLibrary::ConvertUEToROS(Transforms, Poses);
+        benchmark::DoNotOptimize(Poses.GetData());
+        benchmark::ClobberMemory();
+    }
+    State.SetItemsProcessed(State.iterations() * Transforms.Num());
+}
+BENCHMARK(BM_PoseUEToROS_Batched)->Range(1 << 8, 1 << 16);
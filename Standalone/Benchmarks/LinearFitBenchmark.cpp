@@ -0,0 +1,159 @@
+// Sliding-window fit cost per new sample across window sizes: refit from the buffer versus streaming moments,
+// and pose-at-time lookups through FPoseHistory.
+#include <benchmark/benchmark.h>
+
+#include "MathToolkitLibrary.h"
+#include "StreamingLinearFitMT.h"
+#include "PoseHistory.h"
+
+namespace
+{
+    typedef TPair<FVector, uint32> FSample;
+
+    FSample MakeSample(uint32 Timestamp)
+    {
+        const double T = static_cast<double>(Timestamp);
+        return FSample(FVector(3.0 * T + 1.0, -2.0 * T, 0.5 * T + FMath::Sin(T)), Timestamp);
+    }
+}
+
+template<size_t S>
+static void BM_LinearFit_Refit(benchmark::State& State)
+{
+    CircularBufferMT<FSample, S> Buffer;
+    uint32 Timestamp = 0;
+    for (size_t i = 0; i < S; ++i)
+    {
+        Buffer.put(MakeSample(Timestamp++));
+    }
+    FVector A, B;
+    for (auto _ : State)
+    {
+        Buffer.put(MakeSample(Timestamp++));
+        MathToolkitLibrary::calculateLinearFit(Buffer, A, B);
+        benchmark::DoNotOptimize(A);
+        benchmark::DoNotOptimize(B);
+    }
+    State.SetItemsProcessed(State.iterations());
+}
+BENCHMARK_TEMPLATE(BM_LinearFit_Refit, 8);
+BENCHMARK_TEMPLATE(BM_LinearFit_Refit, 32);
+BENCHMARK_TEMPLATE(BM_LinearFit_Refit, 128);
+BENCHMARK_TEMPLATE(BM_LinearFit_Refit, 512);
+BENCHMARK_TEMPLATE(BM_LinearFit_Refit, 2048);
+
+template<size_t S>
+static void BM_LinearFit_Streaming(benchmark::State& State)
+{
+    StreamingLinearFitMT<S> Fit;
+    uint32 Timestamp = 0;
+    for (size_t i = 0; i < S; ++i)
+    {
+        Fit.put(MakeSample(Timestamp++));
+    }
+    FVector A, B;
+    for (auto _ : State)
+    {
+        Fit.put(MakeSample(Timestamp++));
+        Fit.get_fit(A, B);
+        benchmark::DoNotOptimize(A);
+        benchmark::DoNotOptimize(B);
+    }
+    State.SetItemsProcessed(State.iterations());
+}
+BENCHMARK_TEMPLATE(BM_LinearFit_Streaming, 8);
+BENCHMARK_TEMPLATE(BM_LinearFit_Streaming, 32);
+BENCHMARK_TEMPLATE(BM_LinearFit_Streaming, 128);
+BENCHMARK_TEMPLATE(BM_LinearFit_Streaming, 512);
+BENCHMARK_TEMPLATE(BM_LinearFit_Streaming, 2048);
+
+static void BM_LinearFit_RingBuffer(benchmark::State& State)
+{
+    const size_t Capacity = static_cast<size_t>(State.range(0));
+    RingBufferMT<FSample> Buffer(Capacity);
+    uint32 Timestamp = 0;
+    for (size_t i = 0; i < Capacity; ++i)
+    {
+        Buffer.put(MakeSample(Timestamp++));
+    }
+    FVector A, B;
+    for (auto _ : State)
+    {
+        Buffer.put(MakeSample(Timestamp++));
+        MathToolkitLibrary::calculateLinearFit(Buffer, A, B);
+        benchmark::DoNotOptimize(A);
+        benchmark::DoNotOptimize(B);
+    }
+    State.SetItemsProcessed(State.iterations());
+}
+BENCHMARK(BM_LinearFit_RingBuffer)->RangeMultiplier(4)->Range(8, 2048);
+
+template<size_t S>
+static void BM_QuadraticFit_Refit(benchmark::State& State)
+{
+    CircularBufferMT<FSample, S> Buffer;
+    uint32 Timestamp = 0;
+    for (size_t i = 0; i < S; ++i)
+    {
+        Buffer.put(MakeSample(Timestamp++));
+    }
+    FVector A2, A1, A0;
+    for (auto _ : State)
+    {
+        Buffer.put(MakeSample(Timestamp++));
+        MathToolkitLibrary::calculateQuadraticFit(Buffer, A2, A1, A0);
+        benchmark::DoNotOptimize(A0);
+    }
+    State.SetItemsProcessed(State.iterations());
+}
+BENCHMARK_TEMPLATE(BM_QuadraticFit_Refit, 8);
+BENCHMARK_TEMPLATE(BM_QuadraticFit_Refit, 128);
+BENCHMARK_TEMPLATE(BM_QuadraticFit_Refit, 2048);
+
+// Pose lookups per lidar column: refitting the position buffer per query versus the pose history
+static void BM_PoseAtTime_Refit(benchmark::State& State)
+{
+    CircularBufferMT<FSample, 32> Buffer;
+    for (uint32 Timestamp = 0; Timestamp < 32; ++Timestamp)
+    {
+        Buffer.put(MakeSample(Timestamp));
+    }
+    FVector A, B;
+    double Query = 20.0;
+    for (auto _ : State)
+    {
+        MathToolkitLibrary::calculateLinearFit(Buffer, A, B);
+        benchmark::DoNotOptimize(A * Query + B);
+        Query += 1e-3;
+    }
+    State.SetItemsProcessed(State.iterations());
+}
+BENCHMARK(BM_PoseAtTime_Refit);
+
+static void BM_PoseAtTime_HistoryBatch(benchmark::State& State)
+{
+    const FPoseHistory::FSettings Settings;
+    FPoseHistory History(Settings);
+    const int32 Frame = History.RegisterFrame(0);
+    for (uint32 Timestamp = 0; Timestamp < 32; ++Timestamp)
+    {
+        History.AddPose(Frame, Timestamp, MakeSample(Timestamp).Key, FQuat(FVector(0.0, 0.0, 1.0), 0.01 * Timestamp));
+    }
+    // One query per column of a 1800-column sweep spanning the last ten poses
+    TArray<double> Timestamps;
+    for (int32 Column = 0; Column < 1800; ++Column)
+    {
+        Timestamps.Add(21.0 + Column * (10.0 / 1800));
+    }
+    TArray<FVector> Positions;
+    TArray<FQuat> Rotations;
+    Positions.SetNumUninitialized(Timestamps.Num());
+    Rotations.SetNumUninitialized(Timestamps.Num());
+    for (auto _ : State)
+    {
+        benchmark::DoNotOptimize(History.GetPoses(Frame, Timestamps, Positions, Rotations));
+        benchmark::ClobberMemory();
+    }
+    State.SetItemsProcessed(State.iterations() * Timestamps.Num());
+}
+BENCHMARK(BM_PoseAtTime_HistoryBatch);
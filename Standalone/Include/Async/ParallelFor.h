@@ -0,0 +1,153 @@
+#pragma once
+// Standalone ParallelFor: splits [0, Num) across a persistent worker pool (UE runs it on the task graph).
+#include "CoreMinimal.h"
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+enum class EParallelForFlags
+{
+    None = 0,
+    ForceSingleThread = 1,
+    Unbalanced = 2,
+    PumpRenderingThread = 4,
+    BackgroundPriority = 8,
+};
+
+/**
+ * hardware_concurrency() - 1 workers started on first use and parked between calls, so per-frame
+ * ParallelFor calls do not create and join threads. One loop runs at a time; the calling thread
+ * works alongside the pool, and ParallelFor calls made from inside a loop body run inline.
+ */
+class FParallelForPool
+{
+public:
+    static FParallelForPool& Get()
+    {
+        static FParallelForPool Pool;
+        return Pool;
+    }
+
+    int32 GetNumThreads() const { return static_cast<int32>(Workers.size()) + 1; }
+
+    static bool IsInsideLoop() { return bInsideLoop; }
+
+    void Run(int32 Num, const std::function<void(int32)>& Body)
+    {
+        std::lock_guard<std::mutex> RunLock(RunMutex);
+        FJob Job(Num, Body);
+        {
+            std::lock_guard<std::mutex> Lock(Mutex);
+            CurrentJob = &Job;
+            ++Generation;
+        }
+        WakeCondition.notify_all();
+
+        Work(Job);
+
+        // Workers that have not picked the job up yet never will; wait for the ones that did
+        std::unique_lock<std::mutex> Lock(Mutex);
+        CurrentJob = nullptr;
+        DoneCondition.wait(Lock, [&Job]() { return Job.NumActive == 0; });
+    }
+
+private:
+    struct FJob
+    {
+        FJob(int32 InNum, const std::function<void(int32)>& InBody) : Num(InNum), Body(InBody) {}
+
+        const int32 Num;
+        const std::function<void(int32)>& Body;
+        std::atomic<int32> Next{0};
+        int32 NumActive = 0;   // guarded by Mutex
+    };
+
+    FParallelForPool()
+    {
+        const int32 NumWorkers = static_cast<int32>(FMath::Max(1u, std::thread::hardware_concurrency())) - 1;
+        for (int32 i = 0; i < NumWorkers; ++i)
+        {
+            Workers.emplace_back([this]() { WorkerLoop(); });
+        }
+    }
+
+    ~FParallelForPool()
+    {
+        {
+            std::lock_guard<std::mutex> Lock(Mutex);
+            bStop = true;
+        }
+        WakeCondition.notify_all();
+        for (std::thread& Worker : Workers)
+        {
+            Worker.join();
+        }
+    }
+
+    static void Work(FJob& Job)
+    {
+        bInsideLoop = true;
+        for (int32 i = Job.Next.fetch_add(1); i < Job.Num; i = Job.Next.fetch_add(1))
+        {
+            Job.Body(i);
+        }
+        bInsideLoop = false;
+    }
+
+    void WorkerLoop()
+    {
+        uint64 SeenGeneration = 0;
+        std::unique_lock<std::mutex> Lock(Mutex);
+        for (;;)
+        {
+            WakeCondition.wait(Lock, [&]() { return bStop || (CurrentJob && Generation != SeenGeneration); });
+            if (bStop)
+            {
+                return;
+            }
+            SeenGeneration = Generation;
+            FJob& Job = *CurrentJob;
+            ++Job.NumActive;
+            Lock.unlock();
+            Work(Job);
+            Lock.lock();
+            if (--Job.NumActive == 0)
+            {
+                DoneCondition.notify_all();
+            }
+        }
+    }
+
+    std::vector<std::thread> Workers;
+    std::mutex RunMutex;
+    std::mutex Mutex;
+    std::condition_variable WakeCondition;
+    std::condition_variable DoneCondition;
+    FJob* CurrentJob = nullptr;
+    uint64 Generation = 0;
+    bool bStop = false;
+
+    static inline thread_local bool bInsideLoop = false;
+};
+
+inline void ParallelFor(int32 Num, const std::function<void(int32)>& Body, EParallelForFlags Flags = EParallelForFlags::None)
+{
+    if (Num <= 1 || Flags == EParallelForFlags::ForceSingleThread || FParallelForPool::IsInsideLoop()
+        || FParallelForPool::Get().GetNumThreads() <= 1)
+    {
+        for (int32 i = 0; i < Num; ++i)
+        {
+            Body(i);
+        }
+        return;
+    }
+    FParallelForPool::Get().Run(Num, Body);
+}
+
+inline void ParallelFor(int32 Num, const std::function<void(int32)>& Body, bool bForceSingleThread)
+{
+    ParallelFor(Num, Body, bForceSingleThread ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+}
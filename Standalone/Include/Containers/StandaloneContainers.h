@@ -0,0 +1,115 @@
+#pragma once
+// Minimal TPair / TArray / TArrayView / FString stand-ins backed by the standard library.
+
+template<typename K, typename V>
+struct TPair
+{
+    K Key;
+    V Value;
+    TPair() = default;
+    TPair(const K& InKey, const V& InValue) : Key(InKey), Value(InValue) {}
+};
+
+template<typename T>
+class TArray
+{
+public:
+    typedef int32 SizeType;
+    TArray() = default;
+    TArray(std::initializer_list<T> Init) : Data(Init) {}
+    TArray(const T* Ptr, int32 Count) : Data(Ptr, Ptr + Count) {}
+
+    int32 Num() const { return (int32)Data.size(); }
+    bool IsEmpty() const { return Data.empty(); }
+    T* GetData() { return Data.data(); }
+    const T* GetData() const { return Data.data(); }
+    T& operator[](int32 I) { check(I >= 0 && I < Num()); return Data[I]; }
+    const T& operator[](int32 I) const { check(I >= 0 && I < Num()); return Data[I]; }
+    int32 Add(const T& V) { Data.push_back(V); return Num() - 1; }
+    int32 Add(T&& V) { Data.push_back(std::move(V)); return Num() - 1; }
+    template<typename... A> int32 Emplace(A&&... Args) { Data.emplace_back(std::forward<A>(Args)...); return Num() - 1; }
+    void Append(const T* Ptr, int32 Count) { Data.insert(Data.end(), Ptr, Ptr + Count); }
+    void Reset(int32 Slack = 0) { Data.clear(); Data.reserve(Slack); }
+    void Empty(int32 Slack = 0) { Data.clear(); Data.shrink_to_fit(); Data.reserve(Slack); }
+    void Reserve(int32 N) { Data.reserve(N); }
+    void SetNum(int32 N) { Data.resize(N); }
+    void SetNumUninitialized(int32 N) { Data.resize(N); }
+    void SetNumZeroed(int32 N) { Data.assign(N, T()); }
+    void Init(const T& V, int32 N) { Data.assign(N, V); }
+    void RemoveAt(int32 I) { Data.erase(Data.begin() + I); }
+    void Pop() { Data.pop_back(); }
+    void Sort() { std::sort(Data.begin(), Data.end()); }
+    T& AddDefaulted_GetRef() { Data.emplace_back(); return Data.back(); }
+    T& Last() { return Data.back(); }
+    const T& Last() const { return Data.back(); }
+    int32 Max() const { return (int32)Data.capacity(); }
+    size_t GetAllocatedSize() const { return Data.capacity() * sizeof(T); }
+    T* begin() { return Data.data(); }
+    T* end() { return Data.data() + Data.size(); }
+    const T* begin() const { return Data.data(); }
+    const T* end() const { return Data.data() + Data.size(); }
+private:
+    std::vector<T> Data;
+};
+
+template<typename T>
+class TArrayView
+{
+public:
+    typedef int32 SizeType;
+    TArrayView() : DataPtr(nullptr), ArrayNum(0) {}
+    TArrayView(T* InData, int32 InNum) : DataPtr(InData), ArrayNum(InNum) {}
+    template<typename U, typename = typename std::enable_if<std::is_convertible<U(*)[], T(*)[]>::value>::type>
+    TArrayView(TArray<U>& Other) : DataPtr(Other.GetData()), ArrayNum(Other.Num()) {}
+    template<typename U, typename = typename std::enable_if<std::is_convertible<const U(*)[], T(*)[]>::value>::type>
+    TArrayView(const TArray<U>& Other) : DataPtr(Other.GetData()), ArrayNum(Other.Num()) {}
+    template<typename U, typename = typename std::enable_if<std::is_convertible<U(*)[], T(*)[]>::value>::type>
+    TArrayView(const TArrayView<U>& Other) : DataPtr(Other.GetData()), ArrayNum(Other.Num()) {}
+    TArrayView(std::initializer_list<typename std::remove_const<T>::type> List) : DataPtr(List.begin()), ArrayNum((int32)List.size()) {}
+
+    int32 Num() const { return ArrayNum; }
+    bool IsEmpty() const { return ArrayNum == 0; }
+    T* GetData() const { return DataPtr; }
+    T& operator[](int32 I) const { check(I >= 0 && I < ArrayNum); return DataPtr[I]; }
+    TArrayView Slice(int32 Index, int32 Count) const { check(Index >= 0 && Count >= 0 && Index + Count <= ArrayNum); return TArrayView(DataPtr + Index, Count); }
+    T* begin() const { return DataPtr; }
+    T* end() const { return DataPtr + ArrayNum; }
+private:
+    T* DataPtr;
+    int32 ArrayNum;
+};
+
+template<typename T>
+using TConstArrayView = TArrayView<const T>;
+
+template<typename T>
+TArrayView<T> MakeArrayView(T* Ptr, int32 Num) { return TArrayView<T>(Ptr, Num); }
+template<typename T>
+TArrayView<T> MakeArrayView(TArray<T>& A) { return TArrayView<T>(A.GetData(), A.Num()); }
+template<typename T>
+TArrayView<const T> MakeArrayView(const TArray<T>& A) { return TArrayView<const T>(A.GetData(), A.Num()); }
+
+class FString
+{
+public:
+    FString() = default;
+    FString(const char* S) : Str(S) {}
+    FString(std::string S) : Str(std::move(S)) {}
+    static FString Printf(const char* Fmt, ...)
+    {
+        char Buf[2048];
+        va_list Args;
+        va_start(Args, Fmt);
+        std::vsnprintf(Buf, sizeof(Buf), Fmt, Args);
+        va_end(Args);
+        return FString(Buf);
+    }
+    const char* operator*() const { return Str.c_str(); }
+    FString& operator+=(const FString& O) { Str += O.Str; return *this; }
+    FString operator+(const FString& O) const { return FString(Str + O.Str); }
+    bool IsEmpty() const { return Str.empty(); }
+    int32 Len() const { return (int32)Str.size(); }
+    bool Contains(const char* Sub) const { return Str.find(Sub) != std::string::npos; }
+private:
+    std::string Str;
+};
@@ -0,0 +1,134 @@
+#pragma once
+// Minimal stand-in for Unreal's CoreMinimal.h used to build the math core headless.
+#include <cstdint>
+#include <cstddef>
+#include <cmath>
+#include <cstring>
+#include <cstdio>
+#include <cstdarg>
+#include <cstdlib>
+#include <cassert>
+#include <string>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <initializer_list>
+#include <type_traits>
+#include <chrono>
+
+typedef int8_t int8; typedef uint8_t uint8; typedef int16_t int16; typedef uint16_t uint16;
+typedef int32_t int32; typedef uint32_t uint32; typedef int64_t int64; typedef uint64_t uint64;
+typedef char TCHAR;
+typedef size_t SIZE_T;
+#define TEXT(x) x
+#ifndef FORCEINLINE
+#define FORCEINLINE inline __attribute__((always_inline))
+#endif
+#ifndef MATHTOOLKIT_API
+#define MATHTOOLKIT_API
+#endif
+#define PLATFORM_CACHE_LINE_SIZE 64
+#define RESTRICT __restrict
+#define UE_ARRAY_COUNT(A) (sizeof(A) / sizeof((A)[0]))
+enum { INDEX_NONE = -1 };
+#define PREPROCESSOR_JOIN_INNER(A, B) A##B
+#define PREPROCESSOR_JOIN(A, B) PREPROCESSOR_JOIN_INNER(A, B)
+
+template<typename T> constexpr std::remove_reference_t<T>&& MoveTemp(T&& Obj) { return static_cast<std::remove_reference_t<T>&&>(Obj); }
+template<typename T> constexpr T&& Forward(std::remove_reference_t<T>& Obj) { return static_cast<T&&>(Obj); }
+
+struct FMemory
+{
+    static void* Memcpy(void* Dest, const void* Src, size_t Count) { return std::memcpy(Dest, Src, Count); }
+    static void* Memmove(void* Dest, const void* Src, size_t Count) { return std::memmove(Dest, Src, Count); }
+    static void* Memset(void* Dest, uint8 Char, size_t Count) { return std::memset(Dest, Char, Count); }
+    static void* Memzero(void* Dest, size_t Count) { return std::memset(Dest, 0, Count); }
+    static int32 Memcmp(const void* A, const void* B, size_t Count) { return std::memcmp(A, B, Count); }
+    static void* Malloc(size_t Count, uint32 Alignment = 16) { const size_t A = Alignment < 16 ? 16 : Alignment; return std::aligned_alloc(A, (Count + A - 1) / A * A); }
+    static void Free(void* Ptr) { std::free(Ptr); }
+};
+#ifdef NDEBUG
+// Like UE's shipping checks: not evaluated, but still referenced so check-only locals do not warn
+#define check(x) ((void)sizeof(!(x)))
+#define checkf(x, ...) ((void)sizeof(!(x)))
+#else
+#define check(x) assert(x)
+#define checkf(x, ...) assert(x)
+#endif
+#define ensure(x) (x)
+#define UE_LOG(Cat, Verb, Fmt, ...) do { std::fprintf(stderr, Fmt, ##__VA_ARGS__); std::fprintf(stderr, "\n"); } while (0)
+#define DECLARE_LOG_CATEGORY_EXTERN(...)
+#define DEFINE_LOG_CATEGORY(...)
+#undef PI
+#define PI (3.1415926535897932f)
+#define UE_PI (3.1415926535897932)
+#define UE_DOUBLE_PI (3.141592653589793238462643383279502884197169399)
+#define UE_SMALL_NUMBER (1.e-8f)
+#define UE_KINDA_SMALL_NUMBER (1.e-4f)
+#define SMALL_NUMBER UE_SMALL_NUMBER
+#define KINDA_SMALL_NUMBER UE_KINDA_SMALL_NUMBER
+
+struct FMath
+{
+    template<typename T> static constexpr T Square(T A) { return A * A; }
+    template<typename T> static T Sqrt(T A) { return std::sqrt(A); }
+    static float InvSqrt(float A) { return 1.0f / std::sqrt(A); }
+    static double InvSqrt(double A) { return 1.0 / std::sqrt(A); }
+    template<typename T> static T Acos(T A) { return std::acos(A); }
+    template<typename T> static T Asin(T A) { return std::asin(A); }
+    template<typename T> static T Atan(T A) { return std::atan(A); }
+    template<typename A, typename B> static auto Atan2(A Y, B X) -> typename std::common_type<A, B>::type { return std::atan2((typename std::common_type<A, B>::type)Y, (typename std::common_type<A, B>::type)X); }
+    template<typename T> static T Tan(T A) { return std::tan(A); }
+    template<typename T> static T Sin(T A) { return std::sin(A); }
+    template<typename T> static T Cos(T A) { return std::cos(A); }
+    template<typename T> static T Exp(T A) { return std::exp(A); }
+    template<typename T> static T Exp2(T A) { return std::exp2(A); }
+    template<typename T> static T Loge(T A) { return std::log(A); }
+    template<typename A, typename B> static auto Fmod(A X, B Y) -> typename std::common_type<A, B>::type { return std::fmod((typename std::common_type<A, B>::type)X, (typename std::common_type<A, B>::type)Y); }
+    template<typename T> static constexpr T Abs(T A) { return A < T(0) ? -A : A; }
+    template<typename T> static constexpr T Min(T A, T B) { return A < B ? A : B; }
+    template<typename A, typename B, typename = typename std::enable_if<!std::is_same<A, B>::value>::type> static constexpr auto Min(A X, B Y) -> typename std::common_type<A, B>::type { return X < Y ? X : Y; }
+    template<typename T> static constexpr T Max(T A, T B) { return A > B ? A : B; }
+    template<typename A, typename B, typename = typename std::enable_if<!std::is_same<A, B>::value>::type> static constexpr auto Max(A X, B Y) -> typename std::common_type<A, B>::type { return X > Y ? X : Y; }
+    template<typename T> static constexpr T Max3(T A, T B, T C) { return Max(Max(A, B), C); }
+    template<typename T> static constexpr T Clamp(T X, T Lo, T Hi) { return X < Lo ? Lo : X < Hi ? X : Hi; }
+    template<typename T> static constexpr T Sign(T A) { return A > T(0) ? T(1) : (A < T(0) ? T(-1) : T(0)); }
+    template<typename T> static constexpr T DegreesToRadians(T D) { return D * (T(UE_DOUBLE_PI) / T(180)); }
+    template<typename T> static constexpr T RadiansToDegrees(T R) { return R * (T(180) / T(UE_DOUBLE_PI)); }
+    template<typename T, typename U> static T Lerp(const T& A, const T& B, const U& Alpha) { return (T)(A + Alpha * (B - A)); }
+    static bool IsNearlyZero(double V, double Tol = UE_SMALL_NUMBER) { return std::fabs(V) <= Tol; }
+    static bool IsNearlyEqual(double A, double B, double Tol = UE_SMALL_NUMBER) { return std::fabs(A - B) <= Tol; }
+    static bool IsFinite(double V) { return std::isfinite(V); }
+    static bool IsNaN(double V) { return std::isnan(V); }
+    static int32 FloorToInt(float V) { return (int32)std::floor(V); }
+    static int32 FloorToInt(double V) { return (int32)std::floor(V); }
+    static float Pow(float A, float B) { return std::pow(A, B); }
+    static double Pow(double A, double B) { return std::pow(A, B); }
+    static int32 RoundToInt(float V) { return (int32)std::floor(V + 0.5f); }
+    static int32 RoundToInt(double V) { return (int32)std::floor(V + 0.5); }
+    static void SinCos(float* S, float* C, float V) { *S = std::sin(V); *C = std::cos(V); }
+    static void SinCos(double* S, double* C, double V) { *S = std::sin(V); *C = std::cos(V); }
+    template<typename T> static T UnwindDegrees(T A) { while (A > (T)180) { A -= (T)360; } while (A < (T)-180) { A += (T)360; } return A; }
+    static float FloorToFloat(float V) { return std::floor(V); }
+    static double FloorToDouble(double V) { return std::floor(V); }
+    static float Frac(float V) { return V - std::floor(V); }
+    static int64 FloorToInt64(double V) { return (int64)std::floor(V); }
+    template<typename T> static constexpr bool IsPowerOfTwo(T V) { return V > 0 && (V & (V - 1)) == 0; }
+    static uint32 RoundUpToPowerOfTwo(uint32 V) { uint32 R = 1; while (R < V) R <<= 1; return R; }
+    static uint64 RoundUpToPowerOfTwo64(uint64 V) { uint64 R = 1; while (R < V) R <<= 1; return R; }
+    static uint32 FloorLog2(uint32 V) { uint32 R = 0; while (V >>= 1) ++R; return R; }
+    static uint64 FloorLog2_64(uint64 V) { uint64 R = 0; while (V >>= 1) ++R; return R; }
+    template<typename T> static constexpr T DivideAndRoundUp(T A, T B) { return (A + B - 1) / B; }
+};
+
+struct FPlatformTime
+{
+    static double Seconds() { return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count(); }
+    static uint64 Cycles64() { return (uint64)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count(); }
+    static double GetSecondsPerCycle64() { return 1e-9; }
+    static double ToMilliseconds64(uint64 Cycles) { return (double)Cycles * 1e-6; }
+};
+
+#include "Containers/StandaloneContainers.h"
+#include "Math/StandaloneVector.h"
+#include "Templates/SharedPointer.h"
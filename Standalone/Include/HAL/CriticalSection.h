@@ -0,0 +1,19 @@
+#pragma once
+// Standalone FCriticalSection: recursive like UE's on every platform.
+#include "CoreMinimal.h"
+#include <mutex>
+
+class FCriticalSection
+{
+public:
+    FCriticalSection() = default;
+    FCriticalSection(const FCriticalSection&) = delete;
+    FCriticalSection& operator=(const FCriticalSection&) = delete;
+
+    void Lock() { Mutex.lock(); }
+    bool TryLock() { return Mutex.try_lock(); }
+    void Unlock() { Mutex.unlock(); }
+
+private:
+    std::recursive_mutex Mutex;
+};
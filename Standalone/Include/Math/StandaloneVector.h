@@ -0,0 +1,259 @@
+#pragma once
+// Lightweight UE::Math vector, quaternion, rotator and transform types (double by default, like UE5).
+
+namespace UE
+{
+namespace Math
+{
+
+template<typename T>
+struct TVector
+{
+    T X, Y, Z;
+
+    static const TVector ZeroVector;
+    static const TVector OneVector;
+
+    TVector() = default;
+    constexpr explicit TVector(T V) : X(V), Y(V), Z(V) {}
+    constexpr TVector(T InX, T InY, T InZ) : X(InX), Y(InY), Z(InZ) {}
+    template<typename U, typename = typename std::enable_if<!std::is_same<T, U>::value>::type>
+    explicit TVector(const TVector<U>& V) : X((T)V.X), Y((T)V.Y), Z((T)V.Z) {}
+
+    TVector operator+(const TVector& V) const { return TVector(X + V.X, Y + V.Y, Z + V.Z); }
+    TVector operator-(const TVector& V) const { return TVector(X - V.X, Y - V.Y, Z - V.Z); }
+    TVector operator*(const TVector& V) const { return TVector(X * V.X, Y * V.Y, Z * V.Z); }
+    TVector operator/(const TVector& V) const { return TVector(X / V.X, Y / V.Y, Z / V.Z); }
+    template<typename S, typename = typename std::enable_if<std::is_arithmetic<S>::value>::type>
+    TVector operator*(S Scale) const { return TVector(X * (T)Scale, Y * (T)Scale, Z * (T)Scale); }
+    template<typename S, typename = typename std::enable_if<std::is_arithmetic<S>::value>::type>
+    TVector operator/(S Scale) const { const T R = T(1) / (T)Scale; return TVector(X * R, Y * R, Z * R); }
+    TVector operator-() const { return TVector(-X, -Y, -Z); }
+    TVector& operator+=(const TVector& V) { X += V.X; Y += V.Y; Z += V.Z; return *this; }
+    TVector& operator-=(const TVector& V) { X -= V.X; Y -= V.Y; Z -= V.Z; return *this; }
+    template<typename S, typename = typename std::enable_if<std::is_arithmetic<S>::value>::type>
+    TVector& operator*=(S Scale) { X *= (T)Scale; Y *= (T)Scale; Z *= (T)Scale; return *this; }
+    bool operator==(const TVector& V) const { return X == V.X && Y == V.Y && Z == V.Z; }
+    bool operator!=(const TVector& V) const { return !(*this == V); }
+    T& operator[](int32 I) { return (&X)[I]; }
+    T operator[](int32 I) const { return (&X)[I]; }
+    T operator|(const TVector& V) const { return X * V.X + Y * V.Y + Z * V.Z; }
+    TVector operator^(const TVector& V) const { return TVector(Y * V.Z - Z * V.Y, Z * V.X - X * V.Z, X * V.Y - Y * V.X); }
+
+    static T DotProduct(const TVector& A, const TVector& B) { return A | B; }
+    static TVector CrossProduct(const TVector& A, const TVector& B) { return A ^ B; }
+    static T Dist(const TVector& A, const TVector& B) { return (A - B).Size(); }
+    T Size() const { return std::sqrt(X * X + Y * Y + Z * Z); }
+    T GetMax() const { return std::max(std::max(X, Y), Z); }
+    T GetAbsMax() const { return std::max(std::max(std::abs(X), std::abs(Y)), std::abs(Z)); }
+    T SizeSquared() const { return X * X + Y * Y + Z * Z; }
+    bool IsNearlyZero(T Tol = (T)UE_KINDA_SMALL_NUMBER) const { return std::fabs(X) <= Tol && std::fabs(Y) <= Tol && std::fabs(Z) <= Tol; }
+    bool Equals(const TVector& V, T Tol = (T)UE_KINDA_SMALL_NUMBER) const { return std::fabs(X - V.X) <= Tol && std::fabs(Y - V.Y) <= Tol && std::fabs(Z - V.Z) <= Tol; }
+    TVector GetSafeNormal(T Tol = (T)UE_SMALL_NUMBER) const { const T S = SizeSquared(); return S <= Tol ? ZeroVector : *this * (T(1) / std::sqrt(S)); }
+};
+template<typename T> const TVector<T> TVector<T>::ZeroVector(0, 0, 0);
+template<typename T> const TVector<T> TVector<T>::OneVector(1, 1, 1);
+template<typename S, typename T, typename = typename std::enable_if<std::is_arithmetic<S>::value>::type>
+TVector<T> operator*(S Scale, const TVector<T>& V) { return V * Scale; }
+
+template<typename T>
+struct TVector2
+{
+    T X, Y;
+    static const TVector2 ZeroVector;
+    TVector2() = default;
+    constexpr TVector2(T InX, T InY) : X(InX), Y(InY) {}
+    bool operator==(const TVector2& V) const { return X == V.X && Y == V.Y; }
+};
+template<typename T> const TVector2<T> TVector2<T>::ZeroVector(0, 0);
+
+template<typename T> struct TRotator;
+
+template<typename T>
+struct TQuat
+{
+    T X, Y, Z, W;
+    static const TQuat Identity;
+
+    TQuat() = default;
+    constexpr TQuat(T InX, T InY, T InZ, T InW) : X(InX), Y(InY), Z(InZ), W(InW) {}
+    template<typename U, typename = typename std::enable_if<!std::is_same<T, U>::value>::type>
+    explicit TQuat(const TQuat<U>& Q) : X((T)Q.X), Y((T)Q.Y), Z((T)Q.Z), W((T)Q.W) {}
+    TQuat(const TVector<T>& Axis, T AngleRad)
+    {
+        const T S = std::sin(AngleRad * T(0.5)), C = std::cos(AngleRad * T(0.5));
+        X = S * Axis.X; Y = S * Axis.Y; Z = S * Axis.Z; W = C;
+    }
+
+    TQuat operator*(const TQuat& Q) const
+    {
+        return TQuat(
+            W * Q.X + X * Q.W + Y * Q.Z - Z * Q.Y,
+            W * Q.Y - X * Q.Z + Y * Q.W + Z * Q.X,
+            W * Q.Z + X * Q.Y - Y * Q.X + Z * Q.W,
+            W * Q.W - X * Q.X - Y * Q.Y - Z * Q.Z);
+    }
+    TVector<T> RotateVector(const TVector<T>& V) const
+    {
+        const TVector<T> Q(X, Y, Z);
+        const TVector<T> TT = TVector<T>::CrossProduct(Q, V) * T(2);
+        return V + (TT * W) + TVector<T>::CrossProduct(Q, TT);
+    }
+    TVector<T> UnrotateVector(const TVector<T>& V) const { return Inverse().RotateVector(V); }
+    TQuat Inverse() const { return TQuat(-X, -Y, -Z, W); }
+    TRotator<T> Rotator() const;
+    T SizeSquared() const { return X * X + Y * Y + Z * Z + W * W; }
+    void Normalize() { const T S = std::sqrt(SizeSquared()); if (S > T(0)) { X /= S; Y /= S; Z /= S; W /= S; } else { *this = Identity; } }
+    TQuat GetNormalized() const { TQuat R(*this); R.Normalize(); return R; }
+    bool Equals(const TQuat& Q, T Tol = (T)UE_KINDA_SMALL_NUMBER) const
+    {
+        return (std::fabs(X - Q.X) <= Tol && std::fabs(Y - Q.Y) <= Tol && std::fabs(Z - Q.Z) <= Tol && std::fabs(W - Q.W) <= Tol)
+            || (std::fabs(X + Q.X) <= Tol && std::fabs(Y + Q.Y) <= Tol && std::fabs(Z + Q.Z) <= Tol && std::fabs(W + Q.W) <= Tol);
+    }
+    static TQuat Slerp(const TQuat& A, const TQuat& B, T Alpha)
+    {
+        T Cos = A.X * B.X + A.Y * B.Y + A.Z * B.Z + A.W * B.W;
+        const T Sign = Cos < T(0) ? T(-1) : T(1);
+        Cos *= Sign;
+        T S0 = T(1) - Alpha, S1 = Alpha * Sign;
+        if (Cos < T(0.9999))
+        {
+            const T Omega = std::acos(Cos), InvSin = T(1) / std::sin(Omega);
+            S0 = std::sin((T(1) - Alpha) * Omega) * InvSin;
+            S1 = std::sin(Alpha * Omega) * InvSin * Sign;
+        }
+        return TQuat(S0 * A.X + S1 * B.X, S0 * A.Y + S1 * B.Y, S0 * A.Z + S1 * B.Z, S0 * A.W + S1 * B.W).GetNormalized();
+    }
+};
+template<typename T> const TQuat<T> TQuat<T>::Identity(0, 0, 0, 1);
+
+template<typename T>
+struct TRotator
+{
+    T Pitch, Yaw, Roll;
+    static const TRotator ZeroRotator;
+    TRotator() = default;
+    constexpr TRotator(T InPitch, T InYaw, T InRoll) : Pitch(InPitch), Yaw(InYaw), Roll(InRoll) {}
+    bool Equals(const TRotator& R, T Tol = (T)UE_KINDA_SMALL_NUMBER) const
+    {
+        auto Wrap = [](T A) { A = std::fmod(A, T(360)); if (A > T(180)) A -= T(360); if (A < T(-180)) A += T(360); return A; };
+        return std::fabs(Wrap(Pitch - R.Pitch)) <= Tol && std::fabs(Wrap(Yaw - R.Yaw)) <= Tol && std::fabs(Wrap(Roll - R.Roll)) <= Tol;
+    }
+    TQuat<T> Quaternion() const
+    {
+        const T DegToRadHalf = T(UE_DOUBLE_PI) / T(360);
+        const T SP = std::sin(Pitch * DegToRadHalf), CP = std::cos(Pitch * DegToRadHalf);
+        const T SY = std::sin(Yaw * DegToRadHalf), CY = std::cos(Yaw * DegToRadHalf);
+        const T SR = std::sin(Roll * DegToRadHalf), CR = std::cos(Roll * DegToRadHalf);
+        return TQuat<T>(
+            CR * SP * SY - SR * CP * CY,
+            -CR * SP * CY - SR * CP * SY,
+            CR * CP * SY - SR * SP * CY,
+            CR * CP * CY + SR * SP * SY);
+    }
+};
+template<typename T> const TRotator<T> TRotator<T>::ZeroRotator(0, 0, 0);
+
+template<typename T>
+TRotator<T> TQuat<T>::Rotator() const
+{
+    const T SingularityTest = Z * X - W * Y;
+    const T YawY = T(2) * (W * Z + X * Y);
+    const T YawX = T(1) - T(2) * (Y * Y + Z * Z);
+    const T Threshold = T(0.4999995);
+    const T RadToDeg = T(180) / T(UE_DOUBLE_PI);
+    auto NormalizeAxis = [](T A) { A = std::fmod(A, T(360)); if (A < T(0)) A += T(360); if (A > T(180)) A -= T(360); return A; };
+    TRotator<T> R;
+    if (SingularityTest < -Threshold)
+    {
+        R.Pitch = T(-90);
+        R.Yaw = std::atan2(YawY, YawX) * RadToDeg;
+        R.Roll = NormalizeAxis(-R.Yaw - (T(2) * std::atan2(X, W) * RadToDeg));
+    }
+    else if (SingularityTest > Threshold)
+    {
+        R.Pitch = T(90);
+        R.Yaw = std::atan2(YawY, YawX) * RadToDeg;
+        R.Roll = NormalizeAxis(R.Yaw - (T(2) * std::atan2(X, W) * RadToDeg));
+    }
+    else
+    {
+        R.Pitch = std::asin(T(2) * SingularityTest) * RadToDeg;
+        R.Yaw = std::atan2(YawY, YawX) * RadToDeg;
+        R.Roll = std::atan2(T(-2) * (W * X + Y * Z), (T(1) - T(2) * (X * X + Y * Y))) * RadToDeg;
+    }
+    return R;
+}
+
+template<typename T>
+struct TTransform
+{
+    TQuat<T> Rotation;
+    TVector<T> Translation;
+    TVector<T> Scale3D;
+
+    static const TTransform Identity;
+
+    TTransform() : Rotation(TQuat<T>::Identity), Translation(TVector<T>::ZeroVector), Scale3D(TVector<T>::OneVector) {}
+    TTransform(const TQuat<T>& R, const TVector<T>& Tr, const TVector<T>& S = TVector<T>::OneVector) : Rotation(R), Translation(Tr), Scale3D(S) {}
+    TTransform(const TRotator<T>& R, const TVector<T>& Tr, const TVector<T>& S = TVector<T>::OneVector) : Rotation(R.Quaternion()), Translation(Tr), Scale3D(S) {}
+    TRotator<T> Rotator() const { return Rotation.Rotator(); }
+
+    const TQuat<T>& GetRotation() const { return Rotation; }
+    const TVector<T>& GetTranslation() const { return Translation; }
+    TVector<T> GetLocation() const { return Translation; }
+    const TVector<T>& GetScale3D() const { return Scale3D; }
+    void SetRotation(const TQuat<T>& R) { Rotation = R; }
+    void SetTranslation(const TVector<T>& V) { Translation = V; }
+    TVector<T> TransformPosition(const TVector<T>& V) const { return Rotation.RotateVector(V * Scale3D) + Translation; }
+    TVector<T> InverseTransformPosition(const TVector<T>& V) const { return Rotation.UnrotateVector(V - Translation) / Scale3D; }
+};
+template<typename T> const TTransform<T> TTransform<T>::Identity;
+
+} // namespace Math
+} // namespace UE
+
+using FVector = UE::Math::TVector<double>;
+using FVector3f = UE::Math::TVector<float>;
+using FVector3d = UE::Math::TVector<double>;
+using FVector2D = UE::Math::TVector2<double>;
+using FVector2f = UE::Math::TVector2<float>;
+using FQuat = UE::Math::TQuat<double>;
+using FQuat4f = UE::Math::TQuat<float>;
+using FRotator = UE::Math::TRotator<double>;
+using FTransform = UE::Math::TTransform<double>;
+
+/** Deterministic LCG random stream with the FRandomStream interface. */
+struct FRandomStream
+{
+    FRandomStream() : Seed(0) {}
+    FRandomStream(int32 InSeed) : Seed(InSeed) {}
+    void Initialize(int32 InSeed) { Seed = InSeed; }
+    float GetFraction() const
+    {
+        MutateSeed();
+        uint32 Bits = 0x3F800000U | (uint32(Seed) >> 9);
+        float Result;
+        std::memcpy(&Result, &Bits, sizeof(Result));
+        return Result - 1.0f;
+    }
+    float FRand() const { return GetFraction(); }
+    float FRandRange(float Min, float Max) const { return Min + (Max - Min) * FRand(); }
+    int32 RandRange(int32 Min, int32 Max) const { const int32 Range = (Max - Min) + 1; return Min + (Range > 0 ? (int32)(FRand() * Range) % Range : 0); }
+    FVector GetUnitVector() const
+    {
+        FVector Result;
+        double L;
+        do
+        {
+            Result.X = FRand() * 2.0 - 1.0;
+            Result.Y = FRand() * 2.0 - 1.0;
+            Result.Z = FRand() * 2.0 - 1.0;
+            L = Result.SizeSquared();
+        } while (L > 1.0 || L < UE_KINDA_SMALL_NUMBER);
+        return Result * (1.0 / std::sqrt(L));
+    }
+private:
+    void MutateSeed() const { Seed = (Seed * 196314165U) + 907633515U; }
+    mutable int32 Seed;
+};
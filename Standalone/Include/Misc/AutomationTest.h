@@ -0,0 +1,129 @@
+#pragma once
+// Headless stand-in for Unreal's automation test framework: simple tests and specs register
+// themselves with FAutomationTestRegistry and are run by Standalone/TestMain.cpp.
+#include "CoreMinimal.h"
+#include <functional>
+#include <memory>
+#include <type_traits>
+
+namespace EAutomationTestFlags
+{
+    enum Type : uint32
+    {
+        EditorContext = 0x1,
+        ClientContext = 0x2,
+        ServerContext = 0x4,
+        CommandletContext = 0x8,
+        ApplicationContextMask = EditorContext | ClientContext | ServerContext | CommandletContext,
+        SmokeFilter = 0x1000000,
+        EngineFilter = 0x2000000,
+        ProductFilter = 0x4000000,
+        PerfFilter = 0x8000000,
+        StressFilter = 0x10000000,
+    };
+}
+
+class FAutomationTestBase
+{
+public:
+    FAutomationTestBase(const char* InName, uint32 InFlags) : TestName(InName), TestFlags(InFlags) {}
+    virtual ~FAutomationTestBase() = default;
+    virtual bool RunTest(const FString& Parameters) = 0;
+
+    const char* GetTestName() const { return TestName; }
+    uint32 GetTestFlags() const { return TestFlags; }
+    int32 GetErrorCount() const { return ErrorCount; }
+    void ResetErrors() { ErrorCount = 0; }
+
+    void AddError(const FString& Message) { ++ErrorCount; std::fprintf(stderr, "  [error] %s: %s\n", TestName, *Message); }
+    void AddWarning(const FString& Message) { std::fprintf(stderr, "  [warning] %s: %s\n", TestName, *Message); }
+    void AddInfo(const FString& Message) { std::fprintf(stdout, "  [info] %s: %s\n", TestName, *Message); }
+
+    bool TestTrue(const FString& What, bool Value) { if (!Value) AddError(FString::Printf("Expected '%s' to be true.", *What)); return Value; }
+    bool TestFalse(const FString& What, bool Value) { if (Value) AddError(FString::Printf("Expected '%s' to be false.", *What)); return !Value; }
+    template<typename P> bool TestNotNull(const FString& What, const P* Pointer) { return TestTrue(What, Pointer != nullptr); }
+    template<typename P> bool TestNull(const FString& What, const P* Pointer) { return TestTrue(What, Pointer == nullptr); }
+    template<typename A, typename B>
+    bool TestEqual(const FString& What, const A& Actual, const B& Expected)
+    {
+        if (!AreEqual(Actual, Expected)) { AddError(FString::Printf("Expected '%s' to be equal.", *What)); return false; }
+        return true;
+    }
+    template<typename A, typename B>
+    bool TestNotEqual(const FString& What, const A& Actual, const B& Expected)
+    {
+        if (AreEqual(Actual, Expected)) { AddError(FString::Printf("Expected '%s' to differ.", *What)); return false; }
+        return true;
+    }
+
+private:
+    // UE overloads TestEqual for int32/int64/uint64, so mixed integer types compare as int64 there
+    template<typename A, typename B>
+    static bool AreEqual(const A& Actual, const B& Expected)
+    {
+        if constexpr (std::is_integral_v<A> && std::is_integral_v<B>)
+        {
+            return static_cast<int64>(Actual) == static_cast<int64>(Expected);
+        }
+        else
+        {
+            return Actual == Expected;
+        }
+    }
+
+    const char* TestName;
+    uint32 TestFlags;
+    int32 ErrorCount = 0;
+};
+
+class FAutomationTestRegistry
+{
+public:
+    static std::vector<FAutomationTestBase*>& Get() { static std::vector<FAutomationTestBase*> Tests; return Tests; }
+};
+
+#define IMPLEMENT_SIMPLE_AUTOMATION_TEST(TClass, PrettyName, TFlags) \
+    class TClass : public FAutomationTestBase \
+    { \
+    public: \
+        TClass() : FAutomationTestBase(PrettyName, uint32(TFlags)) { FAutomationTestRegistry::Get().push_back(this); } \
+        virtual bool RunTest(const FString& Parameters) override; \
+    }; \
+    namespace { TClass TClass##AutomationTestInstance; }
+
+class FAutomationSpecBase : public FAutomationTestBase
+{
+public:
+    using FAutomationTestBase::FAutomationTestBase;
+
+    virtual bool RunTest(const FString& /*Parameters*/) override
+    {
+        Define();
+        for (auto& Case : Cases)
+        {
+            Case();
+        }
+        Cases.clear();
+        return true;
+    }
+
+protected:
+    virtual void Define() = 0;
+    void Describe(const FString&, std::function<void()> Body) { Body(); }
+    void It(const FString&, std::function<void()> Body) { Cases.push_back(std::move(Body)); }
+
+private:
+    std::vector<std::function<void()>> Cases;
+};
+
+#define BEGIN_DEFINE_SPEC(TClass, PrettyName, TFlags) \
+    class TClass : public FAutomationSpecBase \
+    { \
+    public: \
+        TClass() : FAutomationSpecBase(PrettyName, uint32(TFlags)) { FAutomationTestRegistry::Get().push_back(this); } \
+    protected: \
+        virtual void Define() override;
+
+#define END_DEFINE_SPEC(TClass) \
+    }; \
+    namespace { TClass TClass##AutomationSpecInstance; }
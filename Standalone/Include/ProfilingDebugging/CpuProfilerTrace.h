@@ -0,0 +1,5 @@
+#pragma once
+// Insights trace stand-in: CPU events are dropped in the standalone build.
+#include "CoreMinimal.h"
+
+#define TRACE_CPUPROFILER_EVENT_SCOPE(Name)
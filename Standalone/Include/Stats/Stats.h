@@ -0,0 +1,10 @@
+#pragma once
+// Stat system stand-in: the standalone build has no stat viewer, so declarations and counters vanish.
+#include "CoreMinimal.h"
+
+#define DECLARE_STATS_GROUP(GroupDesc, GroupId, GroupCat)
+#define DECLARE_CYCLE_STAT_EXTERN(CounterName, StatId, GroupId, API)
+#define DECLARE_DWORD_COUNTER_STAT_EXTERN(CounterName, StatId, GroupId, API)
+#define DEFINE_STAT(Stat)
+#define SCOPE_CYCLE_COUNTER(Stat)
+#define INC_DWORD_STAT_BY(Stat, Amount)
@@ -0,0 +1,42 @@
+#pragma once
+// Standalone TSharedPtr / TSharedRef / MakeShared over std::shared_ptr (always thread safe).
+#include "CoreMinimal.h"
+#include <memory>
+#include <utility>
+
+enum class ESPMode : uint8 { NotThreadSafe = 0, ThreadSafe = 1 };
+
+template<typename T, ESPMode Mode = ESPMode::ThreadSafe>
+class TSharedPtr
+{
+public:
+    TSharedPtr() = default;
+    TSharedPtr(std::nullptr_t) {}
+    explicit TSharedPtr(std::shared_ptr<T> InPtr) : Ptr(std::move(InPtr)) {}
+    template<typename U, typename = std::enable_if_t<std::is_convertible_v<U*, T*>>>
+    TSharedPtr(const TSharedPtr<U, Mode>& Other) : Ptr(Other.Ptr) {}
+    template<typename U, typename = std::enable_if_t<std::is_convertible_v<U*, T*>>>
+    TSharedPtr(TSharedPtr<U, Mode>&& Other) : Ptr(std::move(Other.Ptr)) {}
+
+    bool IsValid() const { return Ptr != nullptr; }
+    explicit operator bool() const { return IsValid(); }
+    T* Get() const { return Ptr.get(); }
+    T* operator->() const { return Ptr.get(); }
+    T& operator*() const { return *Ptr; }
+    void Reset() { Ptr.reset(); }
+    int32 GetSharedReferenceCount() const { return static_cast<int32>(Ptr.use_count()); }
+    bool IsUnique() const { return Ptr.use_count() == 1; }
+
+    friend bool operator==(const TSharedPtr& A, const TSharedPtr& B) { return A.Ptr == B.Ptr; }
+    friend bool operator!=(const TSharedPtr& A, const TSharedPtr& B) { return A.Ptr != B.Ptr; }
+
+private:
+    template<typename U, ESPMode OtherMode> friend class TSharedPtr;
+    std::shared_ptr<T> Ptr;
+};
+
+template<typename T, ESPMode Mode = ESPMode::ThreadSafe, typename... Args>
+TSharedPtr<T, Mode> MakeShared(Args&&... InArgs)
+{
+    return TSharedPtr<T, Mode>(std::make_shared<T>(std::forward<Args>(InArgs)...));
+}
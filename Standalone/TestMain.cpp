@@ -0,0 +1,90 @@
+// Headless driver for the MathToolkit automation tests.
+//
+//   MathToolkitTests                     run every test except PerfFilter benchmarks
+//   MathToolkitTests --perf              include the PerfFilter benchmarks
+//   MathToolkitTests --filter <prefix>   run tests named <prefix> or <prefix>.*
+//   MathToolkitTests --test <name>       run exactly one test (used by ctest)
+//   MathToolkitTests --list              print the registered test names
+#include "Misc/AutomationTest.h"
+
+#include <cstring>
+
+namespace
+{
+    bool MatchesPrefix(const char* Name, const char* Prefix)
+    {
+        const size_t PrefixLen = std::strlen(Prefix);
+        return std::strncmp(Name, Prefix, PrefixLen) == 0 && (Name[PrefixLen] == '\0' || Name[PrefixLen] == '.');
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const char* Filter = nullptr;
+    const char* Exact = nullptr;
+    bool bPerf = false;
+    bool bList = false;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--perf") == 0)
+        {
+            bPerf = true;
+        }
+        else if (std::strcmp(argv[i], "--list") == 0)
+        {
+            bList = true;
+        }
+        else if (std::strcmp(argv[i], "--filter") == 0 && i + 1 < argc)
+        {
+            Filter = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--test") == 0 && i + 1 < argc)
+        {
+            Exact = argv[++i];
+        }
+        else
+        {
+            std::fprintf(stderr, "usage: %s [--perf] [--list] [--filter <prefix>] [--test <name>]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    int32 NumRun = 0;
+    int32 NumFailed = 0;
+    for (FAutomationTestBase* Test : FAutomationTestRegistry::Get())
+    {
+        const char* Name = Test->GetTestName();
+        if (Exact ? std::strcmp(Name, Exact) != 0 : (Filter && !MatchesPrefix(Name, Filter)))
+        {
+            continue;
+        }
+        if (!Exact && !bPerf && (Test->GetTestFlags() & EAutomationTestFlags::PerfFilter))
+        {
+            continue;
+        }
+        if (bList)
+        {
+            std::printf("%s\n", Name);
+            continue;
+        }
+
+        Test->ResetErrors();
+        const bool bPassed = Test->RunTest(FString()) && Test->GetErrorCount() == 0;
+        std::printf("%s %s\n", bPassed ? "PASS" : "FAIL", Name);
+        std::fflush(stdout);
+        ++NumRun;
+        NumFailed += bPassed ? 0 : 1;
+    }
+
+    if (bList)
+    {
+        return 0;
+    }
+    if (NumRun == 0)
+    {
+        std::fprintf(stderr, "No tests matched\n");
+        return 1;
+    }
+    std::printf("%d tests, %d failed\n", NumRun, NumFailed);
+    return NumFailed == 0 ? 0 : 1;
+}